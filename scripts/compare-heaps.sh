@@ -0,0 +1,110 @@
+#!/bin/sh
+
+# Compare the default binary score heap with the 4-ary heap enabled by
+# './configure --quaternary-heap' on the given CNF files.  For each file a
+# trace of score heap operations is recorded with 'bench-heap' of the
+# default build, which is then replayed by both builds.
+
+binary="`basename $0`"
+
+usage () {
+cat <<EOF
+usage: $binary [ <option> ... ] <dimacs> ...
+
+where '<option>' is one of the following
+
+  -h                print this command line option summary
+  -w <conflicts>    warm-up conflicts before recording (default '$warmup')
+  -c <conflicts>    recorded conflicts (default '$conflicts')
+  -r <rounds>       replay rounds (default '$rounds')
+EOF
+exit 0
+}
+
+if [ -t 1 ]
+then
+  BOLD="\033[1m"
+  NORMAL="\033[0m"
+  RED="\033[1;31m"
+else
+  BOLD=""
+  NORMAL=""
+  RED=""
+fi
+
+die () {
+  echo "${BOLD}$binary: ${RED}error:${NORMAL} $*"
+  exit 1
+}
+
+warmup=20000
+conflicts=10000
+rounds=20
+files=""
+
+argument () {
+  [ $# -lt 2 ] && die "argument to '$1' missing"
+}
+
+while [ $# -gt 0 ]
+do
+  case "$1" in
+    -h) usage;;
+    -w) argument "$@"; shift; warmup="$1";;
+    -c) argument "$@"; shift; conflicts="$1";;
+    -r) argument "$@"; shift; rounds="$1";;
+    -*) die "invalid option '$1' (try '-h')";;
+    /*) files="$files $1";;
+    *) files="$files `pwd`/$1";;
+  esac
+  shift
+done
+
+[ x"$files" = x ] && die "no DIMACS file specified (try '-h')"
+for file in $files
+do
+  [ -f "$file" ] || die "can not find '$file'"
+done
+
+cd "`dirname $0`/.."
+
+tmp=/tmp/compare-heaps-$$
+trap "rm -rf $tmp" 0
+mkdir $tmp || exit 1
+
+# Build the 4-ary heap first such that 'build' is left in the default
+# configuration afterwards.
+
+build () {
+  heap=$1
+  shift
+  echo "./configure $* && make bench-heap"
+  ./configure $* 1>/dev/null 2>/dev/null || die "configuring '$heap' failed"
+  make bench-heap 1>/dev/null 2>/dev/null || die "building '$heap' failed"
+  cp build/bench-heap $tmp/bench-heap-$heap || exit 1
+}
+
+build quaternary --quaternary-heap
+build binary
+
+replay () {
+  $tmp/bench-heap-$1 -r $rounds -i $tmp/trace 2>/dev/null | \
+  awk '/^c total /{print $6}'
+}
+
+echo
+printf "%-40s %14s %14s %14s %8s\n" \
+  "file" "operations" "binary ns/op" "4-ary ns/op" "ratio"
+for file in $files
+do
+  operations="`$tmp/bench-heap-binary -w $warmup -c $conflicts -r 1 \
+    -o $tmp/trace $file 2>/dev/null | awk '/^c total /{print $3}'`"
+  [ x"$operations" = x ] && die "recording trace for '$file' failed"
+  binary_ns="`replay binary`"
+  quaternary_ns="`replay quaternary`"
+  [ x"$binary_ns" = x -o x"$quaternary_ns" = x ] && \
+    die "replaying trace of '$file' failed"
+  ratio="`echo $quaternary_ns $binary_ns | awk '{printf \"%.3f\", $1 / $2}'`"
+  printf "%-40s %14s %14s %14s %8s\n" \
+    "`basename $file`" "$operations" "$binary_ns" "$quaternary_ns" "$ratio"
+done
@@ -0,0 +1,112 @@
+#!/bin/sh
+
+# Compare propagations per second of the default watch layout with the one
+# enabled by './configure --packed-watches' on the given CNF files.  With
+# '-b' the 'bench-propagate' harness replays recorded decisions instead of
+# running the solver which gives less noisy numbers in a few seconds.
+
+binary="`basename $0`"
+
+usage () {
+cat <<EOF
+usage: $binary [ <option> ... ] <dimacs> ...
+
+where '<option>' is one of the following
+
+  -h                print this command line option summary
+  -c <conflicts>    conflict limit for each run (default '$conflicts')
+  -b                use 'bench-propagate' replay instead of solver runs
+EOF
+exit 0
+}
+
+if [ -t 1 ]
+then
+  BOLD="\033[1m"
+  NORMAL="\033[0m"
+  RED="\033[1;31m"
+else
+  BOLD=""
+  NORMAL=""
+  RED=""
+fi
+
+die () {
+  echo "${BOLD}$binary: ${RED}error:${NORMAL} $*"
+  exit 1
+}
+
+conflicts=100000
+bench=no
+files=""
+
+while [ $# -gt 0 ]
+do
+  case "$1" in
+    -h) usage;;
+    -b) bench=yes;;
+    -c)
+      shift
+      [ $# = 0 ] && die "argument to '-c' missing"
+      conflicts="$1"
+      ;;
+    -*) die "invalid option '$1' (try '-h')";;
+    /*) files="$files $1";;
+    *) files="$files `pwd`/$1";;
+  esac
+  shift
+done
+
+[ x"$files" = x ] && die "no DIMACS file specified (try '-h')"
+for file in $files
+do
+  [ -f "$file" ] || die "can not find '$file'"
+done
+
+cd "`dirname $0`/.."
+
+tmp=/tmp/compare-watch-layouts-$$
+trap "rm -rf $tmp" 0
+mkdir $tmp || exit 1
+
+# Build the packed layout first such that 'build' is left in the default
+# configuration afterwards.
+
+build () {
+  layout=$1
+  shift
+  echo "./configure $* && make kissat"
+  ./configure $* 1>/dev/null 2>/dev/null || die "configuring '$layout' failed"
+  make kissat 1>/dev/null 2>/dev/null || die "building '$layout' failed"
+  cp build/kissat $tmp/kissat-$layout || exit 1
+  [ $bench = no ] && return
+  make bench-propagate 1>/dev/null 2>/dev/null || \
+    die "building 'bench-propagate' for '$layout' failed"
+  cp build/bench-propagate $tmp/bench-propagate-$layout || exit 1
+}
+
+build packed --packed-watches
+build default
+
+propagations () {
+  if [ $bench = yes ]
+  then
+    $tmp/bench-propagate-$1 -m search "$2" 2>/dev/null | \
+    awk '/^c search /{print $3}'
+    return
+  fi
+  $tmp/kissat-$1 --conflicts=$conflicts "$2" 2>/dev/null | \
+  awk '/^c propagations:/{print $4}'
+}
+
+echo
+printf "%-40s %14s %14s %8s\n" "file" "default" "packed" "ratio"
+for file in $files
+do
+  default="`propagations default $file`"
+  packed="`propagations packed $file`"
+  [ x"$default" = x -o x"$packed" = x ] && die "no statistics for '$file'"
+  ratio="`echo $packed $default | awk '{printf \"%.3f\", $1 / $2}'`"
+  printf "%-40s %14s %14s %8s\n" \
+    "`basename $file`" "$default" "$packed" "$ratio"
+done
@@ -0,0 +1,98 @@
+#!/bin/sh
+
+# Measure how concurrent backbone probing scales with the number of threads
+# given to '--backbonethreads' on the given CNF files.  For each thread
+# count the wall-clock time spent in the concurrent probing phase, the
+# number of probed variables and the units found are summed over all files.
+
+binary="`basename $0`"
+
+usage () {
+cat <<EOF
+usage: $binary [ <option> ... ] <dimacs> ...
+
+where '<option>' is one of the following
+
+  -h                print this command line option summary
+  -k <kissat>       solver binary to use (default '$kissat')
+  -t <threads>      comma separated thread counts (default '$threads')
+  -c <conflicts>    conflict limit for each run (default '$conflicts')
+EOF
+exit 0
+}
+
+if [ -t 1 ]
+then
+  BOLD="\033[1m"
+  NORMAL="\033[0m"
+  RED="\033[1;31m"
+else
+  BOLD=""
+  NORMAL=""
+  RED=""
+fi
+
+die () {
+  echo "${BOLD}$binary: ${RED}error:${NORMAL} $*"
+  exit 1
+}
+
+kissat="`dirname $0`/../build/kissat"
+threads="1,2,4,8"
+conflicts=10000
+files=""
+
+while [ $# -gt 0 ]
+do
+  case "$1" in
+    -h) usage;;
+    -k)
+      shift
+      [ $# = 0 ] && die "argument to '-k' missing"
+      kissat="$1"
+      ;;
+    -t)
+      shift
+      [ $# = 0 ] && die "argument to '-t' missing"
+      threads="$1"
+      ;;
+    -c)
+      shift
+      [ $# = 0 ] && die "argument to '-c' missing"
+      conflicts="$1"
+      ;;
+    -*) die "invalid option '$1' (try '-h')";;
+    *) files="$files $1";;
+  esac
+  shift
+done
+
+[ x"$files" = x ] && die "no DIMACS file specified (try '-h')"
+for file in $files
+do
+  [ -f "$file" ] || die "can not find '$file'"
+done
+[ -x "$kissat" ] || die "can not find executable '$kissat'"
+
+# With a single thread the concurrent phase is skipped and all columns
+# stay zero.  The numbers are taken from the verbose phase message.
+
+echo
+printf "%8s %12s %12s %12s\n" "threads" "seconds" "probed" "units"
+for t in `echo $threads | tr ',' ' '`
+do
+  seconds=0
+  probed=0
+  units=0
+  for file in $files
+  do
+    set -- `$kissat -v -n --conflicts=$conflicts --backbonethreads=$t \
+      "$file" 2>/dev/null | \
+    awk '/concurrently probed/{ p += $5; u += $11; s += $14 }
+         END { printf "%f %d %d\n", s, p, u }'`
+    seconds="`echo $seconds $1 | awk '{printf \"%.2f\", $1 + $2}'`"
+    probed=`expr $probed + $2`
+    units=`expr $units + $3`
+  done
+  printf "%8s %12s %12s %12s\n" "$t" "$seconds" "$probed" "$units"
+done
@@ -128,13 +128,13 @@ void *kissat_realloc (kissat *solver, void *p, size_t old_bytes,
   }
   dec_bytes (solver, old_bytes);
 #ifdef LOGGING
-  if (GET_OPTION (log) > 3)
+  if (solver && GET_OPTION (log) > 3)
     kissat_begin_logging (solver, LOGPREFIX, "realloc (%p[%zu, %zu) = ", p,
                           old_bytes, new_bytes);
 #endif
   void *res = realloc (p, new_bytes);
 #ifdef LOGGING
-  if (GET_OPTION (log) > 3) {
+  if (solver && GET_OPTION (log) > 3) {
     printf ("%p", res);
     kissat_end_logging ();
   }
@@ -564,6 +564,9 @@ int kissat_analyze (kissat *solver, clause *conflict) {
     // Bump activity for smart vivification
     kissat_bump_clause_vivify_activity (solver, conflict);
     unsigned conflict_level;
+#ifndef NPROOFS
+    clause *const analyzed_conflict = conflict;
+#endif
     if (one_literal_on_conflict_level (solver, conflict, &conflict_level))
       res = 1;
     else if (!conflict_level)
@@ -586,6 +589,7 @@ int kissat_analyze (kissat *solver, clause *conflict) {
           kissat_shrink_clause (solver);
       }
       analyze_reason_side_literals (solver);
+      CHAIN_LEARNED_IN_PROOF (analyzed_conflict);
       kissat_learn_clause (solver);
       reset_analysis_but_not_analyzed_literals (solver);
       res = 1;
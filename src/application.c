@@ -7,10 +7,12 @@
 #include "keatures.h"
 #include "krite.h"
 #include "parse.h"
+#include "portfolio.h"
 #include "print.h"
 #include "proof.h"
 #include "resources.h"
 #include "simdscan.h"
+#include "snapshot.h"
 #include "witness.h"
 
 #include <inttypes.h>
@@ -25,6 +27,9 @@ struct application {
   kissat *solver;
   const char *input_path;
   const char *output_path;
+  const char *read_snapshot;
+  const char *write_snapshot;
+  const char *preprocessed_snapshot;
 #ifndef NPROOFS
   const char *proof_path;
   file proof_file;
@@ -36,6 +41,7 @@ struct application {
   int time;
   int conflicts;
   int decisions;
+  int threads;
   strictness strict;
   bool partial;
   bool witness;
@@ -48,6 +54,7 @@ static void init_app (application *application, kissat *solver) {
   application->witness = true;
   application->conflicts = -1;
   application->decisions = -1;
+  application->threads = 1;
   application->strict = NORMAL_PARSING;
 }
 
@@ -65,13 +72,29 @@ static void print_complete_dimacs_and_proof_usage (void) {
 #ifdef KISSAT_HAS_COMPRESSION
   printf (
       "The solver reads from '<stdin>' if '<dimacs>' is unspecified.\n");
-  printf (
-      "If the path has a '.bz2', '.gz', '.lzma', '7z' or '.xz' suffix\n");
-  printf ("then the solver tries to find a corresponding decompression\n");
-  printf ("tool ('bzip2', 'gzip', 'lzma', '7z', or 'xz') to decompress\n");
-  printf ("the input file on-the-fly after checking that the input file\n");
-  printf ("has the correct format (starts with the corresponding\n");
-  printf ("signature bytes).\n");
+  printf ("If the path has a '.bz2', '.gz', '.lzma', '7z', '.xz' or\n");
+  printf ("'.zst' suffix then the solver tries to find a corresponding\n");
+  printf ("decompression tool ('bzip2', 'gzip', 'lzma', '7z', 'xz' or\n");
+  printf ("'zstd') to decompress the input file on-the-fly after checking\n");
+  printf ("that the input file has the correct format (starts with the\n");
+  printf ("corresponding signature bytes).\n");
+#endif
+#ifdef KISSAT_HAS_DECOMPRESSION
+  printf ("This build decompresses");
+#ifdef KISSAT_HAS_BZIP2
+  printf (" '.bz2'");
+#endif
+#ifdef KISSAT_HAS_ZLIB
+  printf (" '.gz'");
+#endif
+#ifdef KISSAT_HAS_LZMA
+  printf (" '.lzma' '.xz'");
+#endif
+#ifdef KISSAT_HAS_ZSTD
+  printf (" '.zst'");
+#endif
+  printf (" files in-process\n");
+  printf ("without external tools.\n");
 #endif
   printf ("\n");
 #ifndef NPROOFS
@@ -83,7 +106,11 @@ static void print_complete_dimacs_and_proof_usage (void) {
       "to '<stdout>'. In this case the ASCII version of the DRAT format\n");
   printf (
       "is used.  For real files the binary proof format is used unless\n");
-  printf ("'--no-binary' is specified.\n");
+  printf ("'--no-binary' is specified.  With '--frat' the proof is\n");
+  printf ("written in the FRAT format, which has clause identifiers and\n");
+  printf ("hints and can be elaborated to LRAT for verified checkers.\n");
+  printf ("With '--proofcheck' the proof is checked on-the-fly by a\n");
+  printf ("background thread, even if no '<proof>' file is given.\n");
   printf ("\n");
 #ifdef KISSAT_HAS_COMPRESSION
   printf ("Writing of compressed proof files follows the same principle\n");
@@ -206,6 +233,8 @@ static void print_complete_usage (void) {
           " (ignore DIMACS header)\n");
   printf ("  --strict             stricter parsing"
           " (no empty header lines)\n");
+  printf ("  --threads=<number>   "
+          "portfolio solving with multiple threads\n");
   printf ("  --version            print version\n");
   printf ("\n");
   printf ("The following solving limits can be enforced:\n");
@@ -213,6 +242,25 @@ static void print_complete_usage (void) {
   printf ("  --conflicts=<limit>\n");
   printf ("  --decisions=<limit>\n");
   printf ("  --time=<seconds>\n");
+#ifndef NOPTIONS
+  printf ("\n");
+  printf ("Memory usage can be bounded by reducing learned clauses\n");
+  printf ("more aggressively when getting close to the limit:\n");
+  printf ("\n");
+  printf ("  --memory-limit=<MB>  same as '--memorylimit=<MB>'\n");
+#endif
+  printf ("\n");
+  printf (
+      "Binary snapshots of the solver state can be written and read:\n");
+  printf ("\n");
+  printf ("  --read-snapshot=<file>\n");
+  printf ("  --write-snapshot=<file>\n");
+  printf ("  --write-preprocessed-snapshot=<file>\n");
+  printf ("\n");
+  printf ("Reading a snapshot replaces parsing '<dimacs>'.  Snapshots\n");
+  printf ("are written either directly after parsing or after\n");
+  printf ("preprocessing.  Reading a preprocessed snapshot skips\n");
+  printf ("preprocessing.\n");
   printf ("\n");
   printf (
       "Satisfying assignments have by default values for all variables\n");
@@ -370,6 +418,15 @@ static bool most_likely_existing_cnf_file (const char *path) {
   (!strcmp ((ARG), "--" NAME) || !strcmp ((ARG), "--" NAME "=1") || \
    !strcmp ((ARG), "--" NAME "=true"))
 
+static const char *parse_path_option (const char *arg, const char *name) {
+  if (!strncmp (arg, "--no-", 5))
+    return 0;
+  const char *res = kissat_parse_option_name (arg, name);
+  if (res && !*res)
+    return 0;
+  return res;
+}
+
 static bool parse_options (application *application, int argc,
                            char **argv) {
   kissat *solver = application->solver;
@@ -382,6 +439,10 @@ static bool parse_options (application *application, int argc,
 #endif
   const char *conflicts_option = 0;
   const char *decisions_option = 0;
+#ifndef NOPTIONS
+  const char *memory_limit_option = 0;
+#endif
+  const char *threads_option = 0;
   const char *time_option = 0;
   const char *valstr;
   for (int i = 1; i < argc; i++) {
@@ -488,6 +549,50 @@ static bool parse_options (application *application, int argc,
         decisions_option = arg;
       } else
         ERROR ("invalid argument in '%s' (try '-h')", arg);
+    }
+#ifndef NOPTIONS
+    else if ((valstr = kissat_parse_option_name (arg, "memory-limit"))) {
+      int val;
+      if (kissat_parse_option_value (valstr, &val) && val > 0) {
+        if (memory_limit_option)
+          ERROR ("multiple '%s' and '%s'", memory_limit_option, arg);
+        kissat_set_option (solver, "memorylimit", val);
+        memory_limit_option = arg;
+      } else
+        ERROR ("invalid argument in '%s' (try '-h')", arg);
+    }
+#endif
+    else if ((valstr = kissat_parse_option_name (arg, "threads"))) {
+      int val;
+      if (kissat_parse_option_value (valstr, &val) && val > 0) {
+        if (threads_option)
+          ERROR ("multiple '%s' and '%s'", threads_option, arg);
+        application->threads = val;
+        threads_option = arg;
+      } else
+        ERROR ("invalid argument in '%s' (try '-h')", arg);
+    } else if ((valstr = parse_path_option (arg, "read-snapshot"))) {
+      if (application->read_snapshot)
+        ERROR ("multiple snapshots '%s' and '%s' to read",
+               application->read_snapshot, valstr);
+      if (!kissat_file_readable (valstr))
+        ERROR ("can not read snapshot '%s'", valstr);
+      application->read_snapshot = valstr;
+    } else if ((valstr = parse_path_option (arg, "write-snapshot"))) {
+      if (application->write_snapshot)
+        ERROR ("multiple snapshots '%s' and '%s' to write",
+               application->write_snapshot, valstr);
+      if (!kissat_file_writable (valstr))
+        ERROR ("can not write snapshot '%s'", valstr);
+      application->write_snapshot = valstr;
+    } else if ((valstr = parse_path_option (
+                    arg, "write-preprocessed-snapshot"))) {
+      if (application->preprocessed_snapshot)
+        ERROR ("multiple preprocessed snapshots '%s' and '%s' to write",
+               application->preprocessed_snapshot, valstr);
+      if (!kissat_file_writable (valstr))
+        ERROR ("can not write preprocessed snapshot '%s'", valstr);
+      application->preprocessed_snapshot = valstr;
     } else if (!strcmp (arg, "--partial"))
       application->partial = true;
 #ifndef NPROOFS
@@ -613,6 +718,25 @@ static bool parse_options (application *application, int argc,
            "(use '-f' to force reading without decompression)",
            application->input_path);
 #endif
+#ifndef NPROOFS
+  if (application->proof_path && application->threads > 1)
+    ERROR ("can not write proof with '%s'", threads_option);
+  if (application->proof_path && application->read_snapshot)
+    ERROR ("can not write proof for snapshot '%s'",
+           application->read_snapshot);
+  if (GET_OPTION (proofcheck) && application->threads > 1)
+    ERROR ("can not check proof with '%s'", threads_option);
+  if (GET_OPTION (proofcheck) && application->read_snapshot)
+    ERROR ("can not check proof for snapshot '%s'",
+           application->read_snapshot);
+#endif
+  if (application->read_snapshot && application->input_path)
+    ERROR ("can not read both '%s' and snapshot '%s'",
+           application->input_path, application->read_snapshot);
+  if (application->read_snapshot && application->write_snapshot &&
+      !strcmp (application->read_snapshot, application->write_snapshot))
+    ERROR ("will not read and write snapshot '%s' at the same time",
+           application->read_snapshot);
 #if !defined(QUIET) && !defined(NOPTIONS)
   if (kissat_get_option (solver, "quiet")) {
     if (kissat_get_option (solver, "statistics"))
@@ -663,12 +787,71 @@ static bool parse_input (application *application) {
   return true;
 }
 
+static bool read_snapshot (application *application) {
+#ifndef QUIET
+  double entered = kissat_process_time ();
+#endif
+  kissat *solver = application->solver;
+  const char *path = application->read_snapshot;
+  file file;
+  if (!kissat_open_to_read_file (&file, path))
+    ERROR ("failed to open snapshot '%s' for reading", path);
+  kissat_section (solver, "snapshot");
+  kissat_message (solver, "opened and reading %ssnapshot:",
+                  file.compressed ? "compressed " : "");
+  kissat_line (solver);
+  kissat_message (solver, "  %s", file.path);
+  kissat_line (solver);
+  const char *error =
+      kissat_read_snapshot (solver, &file, &application->max_var);
+  kissat_close_file (&file);
+  if (error)
+    ERROR ("%s: invalid snapshot: %s", path, error);
+#ifndef QUIET
+  kissat_message (solver, "restored %s state of %s",
+                  solver->preprocessed ? "preprocessed" : "parsed",
+                  FORMAT_BYTES (file.bytes));
+  kissat_message (solver, "finished reading snapshot after %.2f seconds",
+                  kissat_process_time () - entered);
+#endif
+  return true;
+}
+
+static bool write_snapshot (application *application) {
+  const char *path = application->write_snapshot;
+  if (!path)
+    return true;
+  kissat *solver = application->solver;
+  file file;
+  if (!kissat_open_to_write_file (&file, path))
+    ERROR ("failed to open snapshot '%s' for writing", path);
+  const bool ok = kissat_write_snapshot (solver, &file, false);
+  kissat_close_file (&file);
+  if (!ok)
+    ERROR ("failed to write snapshot '%s'", path);
+#ifndef QUIET
+  kissat_message (solver, "wrote parsed snapshot of %s to '%s'",
+                  FORMAT_BYTES (file.bytes), path);
+#endif
+  return true;
+}
+
 #ifndef NPROOFS
 
 static bool write_proof (application *application) {
   const char *path = application->proof_path;
-  if (!path)
+  kissat *solver = application->solver;
+  if (!path) {
+    if (!GET_OPTION (proofcheck))
+      return true;
+    kissat_init_proof (solver, 0, false);
+#ifndef QUIET
+    kissat_section (solver, "proving");
+    kissat_message (solver, "checking proof on-the-fly "
+                            "without writing it");
+#endif
     return true;
+  }
   file *file = &application->proof_file;
   bool binary = true;
   if (!strcmp (path, "-")) {
@@ -678,25 +861,29 @@ static bool write_proof (application *application) {
     ERROR ("failed to open and write proof to '%s'", path);
   else if (application->binary < 0)
     binary = false;
-  kissat_init_proof (application->solver, file, binary);
+  kissat_init_proof (solver, file, binary);
 #ifndef QUIET
-  kissat *solver = application->solver;
   kissat_section (solver, "proving");
-  kissat_message (solver, "%swriting proof to %sDRAT file:",
+  kissat_message (solver, "%swriting proof to %s%s file:",
                   file->close ? "opened and " : "",
-                  file->compressed ? "compressed " : "");
+                  file->compressed ? "compressed " : "",
+                  GET_OPTION (frat) ? "FRAT" : "DRAT");
   kissat_line (solver);
   kissat_message (solver, "  %s", file->path);
+  if (GET_OPTION (proofcheck)) {
+    kissat_line (solver);
+    kissat_message (solver, "checking proof on-the-fly");
+  }
 #endif
   return true;
 }
 
 static void close_proof (application *application) {
-  const char *path = application->proof_path;
-  if (!path)
+  if (!application->solver->proof)
     return;
   kissat_release_proof (application->solver);
-  kissat_close_file (&application->proof_file);
+  if (application->proof_path)
+    kissat_close_file (&application->proof_file);
 }
 
 #endif
@@ -795,12 +982,20 @@ static int run_application (kissat *solver, int argc, char **argv,
   if (!write_proof (&application))
     return 1;
 #endif
-  if (!parse_input (&application)) {
+  if (application.read_snapshot ? !read_snapshot (&application)
+                                 : !parse_input (&application)) {
+#ifndef NPROOFS
+    close_proof (&application);
+#endif
+    return 1;
+  }
+  if (!write_snapshot (&application)) {
 #ifndef NPROOFS
     close_proof (&application);
 #endif
     return 1;
   }
+  solver->snapshot = application.preprocessed_snapshot;
 #ifndef QUIET
 #ifndef NOPTIONS
   print_options (solver);
@@ -808,7 +1003,15 @@ static int run_application (kissat *solver, int argc, char **argv,
   print_limits (&application);
   kissat_section (solver, "solving");
 #endif
-  int res = kissat_solve (solver);
+  kissat *winner = solver;
+  int res;
+  if (application.threads > 1 && !solver->inconsistent)
+    res = kissat_portfolio_solve (solver, application.threads, &winner);
+  else
+    res = kissat_solve (solver);
+  if (solver->snapshot)
+    kissat_warning (solver, "not writing preprocessed snapshot '%s' "
+                    "(solved before preprocessing)", solver->snapshot);
 #ifndef NPROOFS
   close_proof (&application);
 #endif
@@ -834,18 +1037,20 @@ static int run_application (kissat *solver, int argc, char **argv,
     } else if (res == 10) {
 #ifndef NDEBUG
       if (GET_OPTION (check))
-        kissat_check_satisfying_assignment (solver);
+        kissat_check_satisfying_assignment (winner);
 #endif
       printf ("s SATISFIABLE\n");
       fflush (stdout);
       if (application.witness)
-        kissat_print_witness (solver, application.max_var,
+        kissat_print_witness (winner, application.max_var,
                               application.partial);
     } else {
       printf ("s UNKNOWN\n");
       fflush (stdout);
     }
   }
+  if (winner != solver)
+    kissat_release (winner);
   if (application.output_path) {
     // TODO want to use 'struct file' from 'file.h'?
     const char *path = application.output_path;
@@ -77,9 +77,11 @@ void kissat_shrink_arena (kissat *solver) {
                 kissat_percent (size, capacity), FORMAT_COUNT (size),
                 (int) sizeof (ward), FORMAT_BYTES (size_bytes));
 #endif
-  if (size > capacity / 4) {
+  const bool pressure = solver->pressure;
+  if (size > (pressure ? capacity / 2 : capacity / 4)) {
     kissat_phase (solver, "arena", GET (arena_resized),
-                  "not shrinking since more than 25%% filled");
+                  "not shrinking since more than %d%% filled",
+                  pressure ? 50 : 25);
     return;
   }
   INC (arena_resized);
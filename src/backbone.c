@@ -6,9 +6,11 @@
 #include "inline.h"
 #include "internal.h"
 #include "logging.h"
+#include "parallel.h"
 #include "print.h"
 #include "proprobe.h"
 #include "report.h"
+#include "resources.h"
 #include "terminate.h"
 #include "trail.h"
 #include "utilities.h"
@@ -314,6 +316,385 @@ check_large_clauses_watched_after_binary_clauses (kissat *solver) {
 
 #endif
 
+// Concurrent failed literal probing ('backbonethreads > 1') runs before
+// the sequential backbone rounds.  Both literals of active variables are
+// probed independently from the root-level assignment on helper threads,
+// each with its own values, reasons and trail, while the main thread
+// waits.  Propagation only follows a flat snapshot of the binary
+// implications of clauses which are not root-level assigned, built once
+// per backbone computation.  For a failed probe the dominator of the
+// conflict is determined as in 'backbone_analyze' and its negation is a
+// backbone unit.  Literals implied by both literals of a variable are
+// lifted units.  Units are committed and propagated by the main thread in
+// variable order after each batch (see 'parallel.h').  Both kinds of units
+// can be derived by unit propagation over binary clauses and thus are
+// valid RUP steps.
+
+#define BACKBONE_BATCH_PER_THREAD 256
+
+typedef struct prober prober;
+typedef struct probing probing;
+
+struct prober {
+  value *values;
+  unsigned *reasons;
+  bool *analyzed;
+  mark *marks;
+  unsigneds trail;
+  unsigneds stack;
+  unsigneds marked;
+};
+
+struct probing {
+  kissat *solver;
+  unsigned threads;
+  unsigned size;
+  unsigned capacity;
+  prober *probers;
+  size_t *offsets;
+  unsigned *implied;
+  size_t size_implied;
+  const unsigned *variables;
+  unsigneds *units;
+  unsigned *lifted;
+  uint64_t *ticks;
+};
+
+static void push_prober_stack (unsigneds *stack, unsigned element) {
+  kissat *const solver = 0;
+  PUSH_STACK (*stack, element);
+}
+
+static void release_prober_stack (unsigneds *stack) {
+  kissat *const solver = 0;
+  RELEASE_STACK (*stack);
+}
+
+static void init_implications (kissat *solver, probing *probing) {
+  const value *const values = solver->values;
+  size_t *offsets = kissat_calloc (solver, LITS + 1, sizeof *offsets);
+  for (all_literals (lit)) {
+    if (values[lit])
+      continue;
+    for (all_binary_blocking_watches (watch, WATCHES (lit)))
+      if (watch.type.binary && !values[watch.binary.lit])
+        offsets[NOT (lit)]++;
+  }
+  size_t total = 0;
+  for (all_literals (lit))
+    total += offsets[lit], offsets[lit] = total;
+  offsets[LITS] = total;
+  unsigned *implied = kissat_nalloc (solver, total, sizeof *implied);
+  for (all_literals (lit)) {
+    if (values[lit])
+      continue;
+    const unsigned not_lit = NOT (lit);
+    for (all_binary_blocking_watches (watch, WATCHES (lit)))
+      if (watch.type.binary && !values[watch.binary.lit])
+        implied[--offsets[not_lit]] = watch.binary.lit;
+  }
+  probing->offsets = offsets;
+  probing->implied = implied;
+  probing->size_implied = total;
+}
+
+static void init_probing (kissat *solver, probing *probing,
+                          unsigned threads) {
+  probing->solver = solver;
+  probing->threads = threads;
+  probing->size = 0;
+  probing->capacity = threads * BACKBONE_BATCH_PER_THREAD;
+  probing->probers =
+      kissat_calloc (solver, threads, sizeof *probing->probers);
+  for (unsigned i = 0; i != threads; i++) {
+    prober *prober = probing->probers + i;
+    prober->values = kissat_calloc (solver, LITS, sizeof (value));
+    prober->reasons = kissat_nalloc (solver, VARS, sizeof (unsigned));
+    prober->analyzed = kissat_calloc (solver, VARS, sizeof (bool));
+    prober->marks = kissat_calloc (solver, LITS, sizeof (mark));
+  }
+  const unsigned capacity = probing->capacity;
+  probing->units = kissat_calloc (solver, capacity, sizeof *probing->units);
+  probing->lifted =
+      kissat_calloc (solver, capacity, sizeof *probing->lifted);
+  probing->ticks = kissat_calloc (solver, capacity, sizeof *probing->ticks);
+  init_implications (solver, probing);
+}
+
+static void release_probing (kissat *solver, probing *probing) {
+  const unsigned threads = probing->threads;
+  for (unsigned i = 0; i != threads; i++) {
+    prober *prober = probing->probers + i;
+    kissat_dealloc (solver, prober->values, LITS, sizeof (value));
+    kissat_dealloc (solver, prober->reasons, VARS, sizeof (unsigned));
+    kissat_dealloc (solver, prober->analyzed, VARS, sizeof (bool));
+    kissat_dealloc (solver, prober->marks, LITS, sizeof (mark));
+    release_prober_stack (&prober->trail);
+    release_prober_stack (&prober->stack);
+    release_prober_stack (&prober->marked);
+  }
+  kissat_dealloc (solver, probing->probers, threads,
+                  sizeof *probing->probers);
+  const unsigned capacity = probing->capacity;
+  for (unsigned i = 0; i != capacity; i++)
+    release_prober_stack (probing->units + i);
+  kissat_dealloc (solver, probing->units, capacity,
+                  sizeof *probing->units);
+  kissat_dealloc (solver, probing->lifted, capacity,
+                  sizeof *probing->lifted);
+  kissat_dealloc (solver, probing->ticks, capacity,
+                  sizeof *probing->ticks);
+  kissat_dealloc (solver, probing->offsets, LITS + 1,
+                  sizeof *probing->offsets);
+  kissat_dealloc (solver, probing->implied, probing->size_implied,
+                  sizeof *probing->implied);
+}
+
+static inline bool has_implications (probing *probing, unsigned lit) {
+  const size_t *const offsets = probing->offsets;
+  return offsets[lit] != offsets[lit + 1];
+}
+
+static void prober_assign (kissat *solver, prober *prober, unsigned lit,
+                           unsigned reason) {
+  (void) solver;
+  value *const values = prober->values;
+  values[lit] = 1;
+  values[NOT (lit)] = -1;
+  prober->reasons[IDX (lit)] = reason;
+  push_prober_stack (&prober->trail, lit);
+}
+
+static void prober_backtrack (kissat *solver, prober *prober) {
+  (void) solver;
+  value *const values = prober->values;
+  for (all_stack (unsigned, lit, prober->trail))
+    values[lit] = values[NOT (lit)] = 0;
+  CLEAR_STACK (prober->trail);
+}
+
+static unsigned prober_analyze (kissat *solver, prober *prober,
+                                unsigned conflict, unsigned other) {
+  (void) solver;
+  bool *const analyzed = prober->analyzed;
+  unsigneds *const stack = &prober->stack;
+  const unsigned lit_idx = IDX (conflict), other_idx = IDX (other);
+  analyzed[lit_idx] = true;
+  push_prober_stack (stack, lit_idx);
+  if (!analyzed[other_idx]) {
+    analyzed[other_idx] = true;
+    push_prober_stack (stack, other_idx);
+  }
+  const unsigned *t = END_STACK (prober->trail);
+  unsigned res = INVALID_LIT;
+  while (res == INVALID_LIT) {
+    assert (t > BEGIN_STACK (prober->trail));
+    const unsigned lit = *--t;
+    const unsigned idx = IDX (lit);
+    if (!analyzed[idx])
+      continue;
+    const unsigned reason = prober->reasons[idx];
+    assert (reason != INVALID_LIT);
+    const unsigned reason_idx = IDX (reason);
+    if (analyzed[reason_idx])
+      res = reason;
+    else {
+      analyzed[reason_idx] = true;
+      push_prober_stack (stack, reason_idx);
+    }
+  }
+  for (all_stack (unsigned, idx, *stack))
+    analyzed[idx] = false;
+  CLEAR_STACK (*stack);
+  return res;
+}
+
+// Returns the dominator of the conflict if probing 'probe' fails and
+// otherwise 'INVALID_LIT' leaving the implied literals on the trail.
+
+static unsigned prober_probe (probing *probing, prober *prober,
+                              unsigned probe, uint64_t *ticks) {
+  kissat *const solver = probing->solver;
+  const value *const fixed = solver->values;
+  const value *const values = prober->values;
+  const size_t *const offsets = probing->offsets;
+  const unsigned *const implied = probing->implied;
+  assert (EMPTY_STACK (prober->trail));
+  prober_assign (solver, prober, probe, INVALID_LIT);
+  for (size_t propagated = 0; propagated != SIZE_STACK (prober->trail);
+       propagated++) {
+    const unsigned lit = PEEK_STACK (prober->trail, propagated);
+    const unsigned *p = implied + offsets[lit];
+    const unsigned *const end = implied + offsets[lit + 1];
+    *ticks += 1 + kissat_cache_lines (end - p, sizeof (unsigned));
+    while (p != end) {
+      const unsigned other = *p++;
+      if (fixed[other])
+        continue;
+      const value value = values[other];
+      if (value > 0)
+        continue;
+      if (value < 0)
+        return prober_analyze (solver, prober, lit, other);
+      prober_assign (solver, prober, other, lit);
+    }
+  }
+  return INVALID_LIT;
+}
+
+static void probe_variable (probing *probing, prober *prober,
+                            unsigned idx, unsigneds *units,
+                            unsigned *lifted, uint64_t *ticks) {
+  kissat *const solver = probing->solver;
+  const unsigned lit = LIT (idx), not_lit = NOT (lit);
+  const value *const fixed = solver->values;
+  if (fixed[lit])
+    return;
+  const bool probe_lit = has_implications (probing, lit);
+  const bool probe_not_lit = has_implications (probing, not_lit);
+  mark *const marks = prober->marks;
+  unsigneds *const marked = &prober->marked;
+  assert (EMPTY_STACK (*marked));
+  if (probe_lit) {
+    const unsigned uip = prober_probe (probing, prober, lit, ticks);
+    if (uip != INVALID_LIT) {
+      prober_backtrack (solver, prober);
+      push_prober_stack (units, NOT (uip));
+      return;
+    }
+    if (probe_not_lit)
+      for (all_stack (unsigned, other, prober->trail)) {
+        marks[other] = 1;
+        push_prober_stack (marked, other);
+      }
+    prober_backtrack (solver, prober);
+  }
+  if (!probe_not_lit)
+    return;
+  const unsigned uip = prober_probe (probing, prober, not_lit, ticks);
+  if (uip != INVALID_LIT)
+    push_prober_stack (units, NOT (uip));
+  else if (probe_lit) {
+    for (all_stack (unsigned, other, prober->trail))
+      if (marks[other]) {
+        push_prober_stack (units, other);
+        *lifted += 1;
+      }
+  }
+  prober_backtrack (solver, prober);
+  for (all_stack (unsigned, other, *marked))
+    marks[other] = 0;
+  CLEAR_STACK (*marked);
+}
+
+static void probe_variable_task (void *state, unsigned task,
+                                 unsigned thread) {
+  probing *probing = state;
+  prober *const prober = probing->probers + thread;
+  unsigneds *const units = probing->units + task;
+  unsigned *const lifted = probing->lifted + task;
+  uint64_t *const ticks = probing->ticks + task;
+  CLEAR_STACK (*units);
+  *lifted = *ticks = 0;
+  probe_variable (probing, prober, probing->variables[task], units, lifted,
+                  ticks);
+}
+
+static size_t commit_probing_units (kissat *solver, probing *probing,
+                                    unsigneds *committed) {
+  size_t res = 0;
+  for (unsigned i = 0; i != probing->size; i++) {
+    const unsigneds *const units = probing->units + i;
+    const size_t lifted = probing->lifted[i];
+    const size_t failed = SIZE_STACK (*units) - lifted;
+    for (size_t j = 0; j != SIZE_STACK (*units); j++) {
+      const unsigned unit = PEEK_STACK (*units, j);
+      const value value = VALUE (unit);
+      if (value > 0)
+        continue;
+      if (value < 0) {
+        LOG ("concurrently derived both %s and its negation",
+             LOGLIT (unit));
+        CHECK_AND_ADD_UNIT (unit);
+        ADD_UNIT_TO_PROOF (unit);
+        solver->inconsistent = true;
+        CHECK_AND_ADD_EMPTY ();
+        ADD_EMPTY_TO_PROOF ();
+        return res;
+      }
+      if (j < failed) {
+        LOG ("concurrently failed backbone unit %s", LOGLIT (unit));
+        INC (backbone_units);
+      } else {
+        LOG ("concurrently lifted backbone unit %s", LOGLIT (unit));
+        INC (backbone_lifted);
+      }
+      kissat_learned_unit (solver, unit);
+      PUSH_STACK (*committed, unit);
+      res++;
+    }
+  }
+  return res;
+}
+
+static size_t probe_concurrently (kissat *solver, unsigned threads,
+                                  uint64_t ticks_limit, unsigneds *units) {
+#ifndef QUIET
+  const double start = kissat_wall_clock_time ();
+#endif
+  probing probing;
+  init_probing (solver, &probing, threads);
+  unsigneds variables;
+  INIT_STACK (variables);
+  const flags *const flags = solver->flags;
+  for (all_variables (idx))
+    if (flags[idx].active)
+      PUSH_STACK (variables, idx);
+  const unsigned *p = BEGIN_STACK (variables);
+  const unsigned *const end = END_STACK (variables);
+  size_t probed = 0, res = 0;
+  while (p != end) {
+    if (solver->statistics.backbone_ticks > ticks_limit)
+      break;
+    if (TERMINATED (backbone_terminated_2))
+      break;
+    size_t size = end - p;
+    if (size > probing.capacity)
+      size = probing.capacity;
+    probing.size = size;
+    probing.variables = p;
+    kissat_parallel_for (solver, threads, size, probe_variable_task,
+                         &probing);
+    p += size;
+    probed += size;
+    uint64_t ticks = 0;
+    for (size_t i = 0; i != size; i++)
+      ticks += probing.ticks[i];
+    ticks /= threads;
+    ADD (backbone_ticks, ticks);
+    ADD (probing_ticks, ticks);
+    ADD (ticks, ticks);
+    const size_t committed = commit_probing_units (solver, &probing, units);
+    res += committed;
+    if (solver->inconsistent)
+      break;
+    if (!committed)
+      continue;
+    if (kissat_probing_propagate (solver, 0, true))
+      break;
+  }
+  RELEASE_STACK (variables);
+  release_probing (solver, &probing);
+#ifndef QUIET
+  const double seconds = kissat_wall_clock_time () - start;
+  kissat_phase (solver, "backbone", GET (backbone_computations),
+                "concurrently probed %zu variables with %u threads "
+                "found %zu units in %.2f seconds",
+                probed, threads, res, seconds);
+#endif
+  return res;
+}
+
 static unsigned compute_backbone (kissat *solver) {
 #ifndef NDEBUG
   if (solver->large_clauses_watched_after_binary_clauses)
@@ -341,7 +722,7 @@ static unsigned compute_backbone (kissat *solver) {
 
   unsigned inconsistent = INVALID_LIT;
 
-  SET_EFFORT_LIMIT (ticks_limit, backbone, backbone_ticks);
+  SET_SCHEDULED_EFFORT_LIMIT (ticks_limit, backbone, backbone_ticks);
   size_t round_limit = GET_OPTION (backbonerounds);
   assert (solver->statistics.backbone_computations);
   round_limit *= solver->statistics.backbone_computations;
@@ -351,7 +732,13 @@ static unsigned compute_backbone (kissat *solver) {
 
   size_t round = 0;
 
+  const unsigned threads = GET_OPTION (backbonethreads);
+  if (threads > 1)
+    failed += probe_concurrently (solver, threads, ticks_limit, &units);
+
   for (;;) {
+    if (solver->inconsistent)
+      break;
     if (round >= round_limit) {
       kissat_very_verbose (solver, "backbone round limit %zu hit", round);
       break;
@@ -594,5 +981,6 @@ void kissat_binary_clauses_backbone (kissat *solver) {
   assert (solver->backbone_computing);
   solver->backbone_computing = false;
 #endif
+  STOP_PAYOFF (backbone, backbone_ticks);
   STOP (backbone);
 }
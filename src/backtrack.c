@@ -1,6 +1,7 @@
 #include "backtrack.h"
 #include "analyze.h"
 #include "inline.h"
+#include "inlinebuckets.h"
 #include "inlineheap.h"
 #include "inlinequeue.h"
 #include "print.h"
@@ -31,7 +32,13 @@ static inline void add_unassigned_variable_back_to_heap (kissat *solver,
                                                          unsigned lit) {
   assert (solver->stable);
   const unsigned idx = IDX (lit);
-  if (!kissat_heap_contains (scores, idx))
+  scorebuckets *buckets = &solver->buckets;
+  if (buckets->enabled) {
+    if (!kissat_bucket_contains (buckets, idx)) {
+      const double score = kissat_get_heap_score (scores, idx);
+      kissat_push_bucket (solver, buckets, idx, score);
+    }
+  } else if (!kissat_heap_contains (scores, idx))
     kissat_push_heap (solver, scores, idx);
 }
 
@@ -77,6 +84,9 @@ void kissat_backtrack_without_updating_phases (kissat *solver,
 
   LOG ("backtracking to decision level %u", new_level);
 
+  if (new_level < solver->saved_trail.level)
+    kissat_clear_saved_trail (solver);
+
   frame *new_frame = &FRAME (new_level + 1);
   SET_END_OF_STACK (solver->frames, new_frame);
 
@@ -154,6 +164,8 @@ void kissat_backtrack_in_consistent_state (kissat *solver,
 }
 
 void kissat_backtrack_after_conflict (kissat *solver, unsigned new_level) {
+  if (new_level < solver->level)
+    kissat_save_trail (solver, new_level, false);
   if (solver->level)
     kissat_backtrack_without_updating_phases (solver, solver->level - 1);
   kissat_update_target_and_best_phases (solver);
@@ -161,6 +173,7 @@ void kissat_backtrack_after_conflict (kissat *solver, unsigned new_level) {
 }
 
 void kissat_backtrack_propagate_and_flush_trail (kissat *solver) {
+  kissat_clear_saved_trail (solver);
   if (solver->level) {
     assert (solver->watching);
     kissat_backtrack_in_consistent_state (solver, 0);
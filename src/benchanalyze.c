@@ -0,0 +1,246 @@
+// Stand-alone conflict analysis benchmark compiled with 'make
+// bench-analyze'.
+//
+// It parses a DIMACS file, runs the solver for a number of warm-up
+// conflicts and then drives search itself (propagation, restarts and
+// decisions) for the following conflicts while measuring the time spent
+// in conflict analysis ('kissat_analyze') for each of them, which includes
+// deducing the first unique implication point clause, minimizing and
+// shrinking it, bumping and learning.  Search is deterministic and thus
+// every round replays exactly the same sequence of conflicts on a fresh
+// solver, which is checked by comparing a fingerprint of the learned
+// clauses.  Times are reported separately for conflicts with learned
+// clauses of at least '-l' literals and smaller ones.  To compare two
+// builds on the same conflicts use '--minimizeticks=0', since otherwise
+// cheaper analysis changes search ticks and thus the warm-up schedule.
+
+#include "analyze.h"
+#include "decide.h"
+#include "inline.h"
+#include "internal.h"
+#include "parse.h"
+#include "propsearch.h"
+#include "restart.h"
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char *usage =
+    "usage: bench-analyze [ <option> ... ] <dimacs>\n"
+    "\n"
+    "where '<option>' is one of the following\n"
+    "\n"
+    "  -h              print this command line option summary\n"
+    "  -v              verbose solver messages during warm-up\n"
+    "  -w <conflicts>  number of warm-up conflicts (default 20000)\n"
+    "  -c <conflicts>  number of measured conflicts (default 10000)\n"
+    "  -r <rounds>     replay rounds (default 5)\n"
+    "  -l <size>       large learned clause size limit (default 100)\n"
+    "\n"
+    "or a solver option '--<name>=<value>' set before parsing.\n";
+
+static void die (const char *fmt, ...) {
+  fputs ("bench-analyze: error: ", stderr);
+  va_list ap;
+  va_start (ap, fmt);
+  vfprintf (stderr, fmt, ap);
+  va_end (ap);
+  fputc ('\n', stderr);
+  exit (1);
+}
+
+static unsigned parse_count (const char *opt, const char *arg) {
+  if (!arg)
+    die ("argument to '%s' missing", opt);
+  char *end;
+  const long res = strtol (arg, &end, 10);
+  if (*end || res < 1 || res > 1e9)
+    die ("invalid argument '%s' to '%s'", arg, opt);
+  return res;
+}
+
+// Process time has too coarse granularity for timing single conflicts.
+
+static uint64_t nanoseconds (void) {
+  struct timespec ts;
+  if (clock_gettime (CLOCK_MONOTONIC, &ts))
+    die ("could not get monotonic time");
+  return 1000000000u * (uint64_t) ts.tv_sec + ts.tv_nsec;
+}
+
+typedef struct measured measured;
+
+struct measured {
+  uint64_t conflicts, literals, time;
+};
+
+typedef struct run run;
+
+struct run {
+  measured small, large;
+  uint64_t fingerprint;
+};
+
+// The clause learned during analysis is the reason of the last literal
+// on the trail, unless it was a unit.
+
+static unsigned learned_size (kissat *solver, uint64_t *fingerprint) {
+  if (EMPTY_ARRAY (solver->trail))
+    return 0;
+  const unsigned lit = END_ARRAY (solver->trail)[-1];
+  const assigned *const a = ASSIGNED (lit);
+  unsigned res;
+  if (!a->level)
+    res = 1;
+  else if (a->binary)
+    res = 2;
+  else if (a->reason == DECISION_REASON)
+    res = 0;
+  else
+    res = kissat_dereference_clause (solver, a->reason)->size;
+  *fingerprint = 1111111121u * (*fingerprint + lit) + res;
+  return res;
+}
+
+static kissat *warm_up (const char *path, unsigned warmup, bool verbose,
+                        int argc, char **argv) {
+  kissat *solver = kissat_init ();
+  if (!verbose)
+    kissat_set_option (solver, "quiet", 1);
+  // Adaptive reduce intervals depend on process time and would make
+  // rounds learn different clauses.
+  kissat_set_option (solver, "reduceadaptive", 0);
+  for (int i = 1; i != argc; i++) {
+    char name[kissat_options_max_name_buffer_size];
+    int value;
+    if (kissat_options_parse_arg (argv[i], name, &value))
+      kissat_set_option (solver, name, value);
+  }
+  file file;
+  if (!kissat_open_to_read_file (&file, path))
+    die ("can not read '%s'", path);
+  uint64_t lineno;
+  int max_var;
+  const char *error = kissat_parse_dimacs (solver, NORMAL_PARSING, &file,
+                                           &lineno, &max_var);
+  kissat_close_file (&file);
+  if (error)
+    die ("%s:%" PRIu64 ": parse error: %s", path, lineno, error);
+  kissat_set_conflict_limit (solver, warmup);
+  int res = kissat_solve (solver);
+  if (res || solver->inconsistent)
+    die ("instance solved during warm-up (reduce '-w')");
+  kissat_reset_search_of_queue (solver);
+  return solver;
+}
+
+static void measure (kissat *solver, run *run, unsigned conflicts,
+                     unsigned limit) {
+  unsigned analyzed = 0;
+  while (analyzed < conflicts) {
+    clause *conflict = kissat_search_propagate (solver);
+    if (conflict) {
+      analyzed++;
+      const uint64_t start = nanoseconds ();
+      const int res = kissat_analyze (solver, conflict);
+      const uint64_t time = nanoseconds () - start;
+      if (res)
+        die ("instance solved during measurement (reduce '-c')");
+      const unsigned size = learned_size (solver, &run->fingerprint);
+      measured *m = size < limit ? &run->small : &run->large;
+      m->conflicts++;
+      m->literals += size;
+      m->time += time;
+    } else if (solver->iterating)
+      solver->iterating = false;
+    else if (!solver->unassigned)
+      die ("instance solved during measurement (reduce '-c')");
+    else if (kissat_restarting (solver))
+      kissat_restart (solver);
+    else
+      kissat_decide (solver);
+  }
+}
+
+static void print_measured (const char *name, const measured *m) {
+  const double conflicts = m->conflicts;
+  printf ("c %-8s %10" PRIu64 " %12.1f %14.1f %16.0f\n", name,
+          m->conflicts, conflicts ? m->literals / conflicts : 0,
+          1e-6 * m->time, conflicts ? m->time / conflicts : 0);
+}
+
+int main (int argc, char **argv) {
+  unsigned warmup = 20000, conflicts = 10000, rounds = 5, limit = 100;
+  const char *path = 0;
+  bool verbose = false;
+  for (int i = 1; i != argc; i++) {
+    const char *arg = argv[i];
+    if (!strcmp (arg, "-h")) {
+      fputs (usage, stdout);
+      return 0;
+    } else if (!strcmp (arg, "-v"))
+      verbose = true;
+    else if (!strcmp (arg, "-w"))
+      warmup = parse_count (arg, argv[++i]);
+    else if (!strcmp (arg, "-c"))
+      conflicts = parse_count (arg, argv[++i]);
+    else if (!strcmp (arg, "-r"))
+      rounds = parse_count (arg, argv[++i]);
+    else if (!strcmp (arg, "-l"))
+      limit = parse_count (arg, argv[++i]);
+    else if (arg[0] == '-' && arg[1] == '-') {
+      char name[kissat_options_max_name_buffer_size];
+      int value;
+      if (!kissat_options_parse_arg (arg, name, &value))
+        die ("invalid solver option '%s' (try '-h')", arg);
+    } else if (arg[0] == '-')
+      die ("invalid option '%s' (try '-h')", arg);
+    else if (path)
+      die ("multiple files '%s' and '%s'", path, arg);
+    else
+      path = arg;
+  }
+  if (!path)
+    die ("no DIMACS file specified (try '-h')");
+
+  run best;
+  memset (&best, 0, sizeof best);
+  for (unsigned round = 0; round != rounds; round++) {
+    kissat *solver = warm_up (path, warmup, verbose && !round, argc, argv);
+    run run;
+    memset (&run, 0, sizeof run);
+    measure (solver, &run, conflicts, limit);
+    kissat_release (solver);
+    if (round && run.fingerprint != best.fingerprint)
+      die ("round %u learned different clauses than round 1", round + 1);
+    const uint64_t time = run.small.time + run.large.time;
+    printf ("c round %u analysis time %.2f ms\n", round + 1, 1e-6 * time);
+    fflush (stdout);
+    if (!round || time < best.small.time + best.large.time)
+      best = run;
+  }
+
+  measured total = best.small;
+  total.conflicts += best.large.conflicts;
+  total.literals += best.large.literals;
+  total.time += best.large.time;
+
+  printf ("c\nc fastest of %u rounds replaying %u conflicts "
+          "after %u warm-up conflicts\nc\n",
+          rounds, conflicts, warmup);
+  printf ("c %-8s %10s %12s %14s %16s\n", "learned", "conflicts", "size",
+          "ms", "ns/conflict");
+  char name[32];
+  sprintf (name, "<%u", limit);
+  print_measured (name, &best.small);
+  sprintf (name, ">=%u", limit);
+  print_measured (name, &best.large);
+  print_measured ("total", &total);
+  printf ("c\nc learned clauses fingerprint %016" PRIx64 "\n",
+          best.fingerprint);
+  return 0;
+}
@@ -0,0 +1,422 @@
+// Stand-alone score heap benchmark compiled with 'make bench-heap'.
+//
+// It parses a DIMACS file, runs the solver in stable mode for a number of
+// warm-up conflicts, restarts stable search and then records all
+// operations on the score heap during the following conflicts: score
+// updates of bumped variables ('bump.c') including rescaling, popping
+// assigned variables while looking for the next decision ('decide.c') and
+// pushing back unassigned variables during backtracking.  This trace is
+// replayed many times starting from a copy of the recorded initial heap.
+// Traces can be written and read, so that the same trace can be replayed
+// by a default build and one configured with '--quaternary-heap' (see the
+// script 'scripts/compare-heaps.sh').
+
+#include "analyze.h"
+#include "backtrack.h"
+#include "bump.h"
+#include "decide.h"
+#include "inline.h"
+#include "inlineheap.h"
+#include "internal.h"
+#include "parse.h"
+#include "propsearch.h"
+#include "reluctant.h"
+#include "resources.h"
+#include "restart.h"
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *usage =
+    "usage: bench-heap [ <option> ... ] [ <dimacs> ]\n"
+    "\n"
+    "where '<option>' is one of the following\n"
+    "\n"
+    "  -h              print this command line option summary\n"
+    "  -v              verbose solver messages during warm-up\n"
+    "  -w <conflicts>  number of warm-up conflicts (default 20000)\n"
+    "  -c <conflicts>  number of recorded conflicts (default 10000)\n"
+    "  -r <rounds>     replay rounds (default 100)\n"
+    "  -o <trace>      write recorded trace to this file\n"
+    "  -i <trace>      replay trace from this file (instead of "
+    "'<dimacs>')\n";
+
+static void die (const char *fmt, ...) {
+  fputs ("bench-heap: error: ", stderr);
+  va_list ap;
+  va_start (ap, fmt);
+  vfprintf (stderr, fmt, ap);
+  va_end (ap);
+  fputc ('\n', stderr);
+  exit (1);
+}
+
+static unsigned parse_count (const char *opt, const char *arg) {
+  if (!arg)
+    die ("argument to '%s' missing", opt);
+  char *end;
+  const long res = strtol (arg, &end, 10);
+  if (*end || res < 1 || res > 1e9)
+    die ("invalid argument '%s' to '%s'", arg, opt);
+  return res;
+}
+
+enum type {
+  PUSH_OPERATION = 0,
+  POP_OPERATION = 1,
+  UPDATE_OPERATION = 2,
+  RESCALE_OPERATION = 3,
+};
+
+#define TYPES 4
+
+static const char *type_names[TYPES] = {"push", "pop", "update",
+                                        "rescale"};
+
+// The argument is the variable index for pushes and updates and the
+// number of popped maximum variables for pops.  The score is the new
+// score of updated variables and the factor of rescaling.
+
+typedef struct operation operation;
+
+struct operation {
+  unsigned type;
+  unsigned arg;
+  double score;
+};
+
+typedef struct assignment assignment;
+
+struct assignment {
+  unsigned idx;
+  bool contained;
+  double score;
+};
+
+// clang-format off
+typedef STACK (operation) operations;
+typedef STACK (assignment) assignments;
+typedef STACK (double) doubles;
+// clang-format on
+
+typedef struct trace trace;
+
+struct trace {
+  unsigned vars;
+  doubles scores;
+  unsigneds stack;
+  operations operations;
+};
+
+static void push_operation (kissat *solver, trace *trace, unsigned type,
+                            unsigned arg, double score) {
+  const operation operation = {.type = type, .arg = arg, .score = score};
+  PUSH_STACK (trace->operations, operation);
+}
+
+static void save_assignments (kissat *solver, assignments *saved) {
+  heap *scores = SCORES;
+  CLEAR_STACK (*saved);
+  for (all_stack (unsigned, lit, solver->trail)) {
+    const unsigned idx = IDX (lit);
+    assignment assignment;
+    assignment.idx = idx;
+    assignment.contained = kissat_heap_contains (scores, idx);
+    assignment.score = kissat_get_heap_score (scores, idx);
+    PUSH_STACK (*saved, assignment);
+  }
+}
+
+// Score changes and pushes during conflict analysis and restarts only
+// affect variables assigned before, thus it is enough to compare their
+// state before and after.  A decrease of the score increment means that
+// all scores were rescaled, since otherwise it always increases.
+
+static void record_changes (kissat *solver, trace *trace,
+                            const assignments *saved, double old_scinc) {
+  const double new_scinc = solver->scinc;
+  if (new_scinc < old_scinc) {
+    const double decay = GET_OPTION (decay) * 1e-3;
+    const double factor = new_scinc * (1.0 - decay) / old_scinc;
+    push_operation (solver, trace, RESCALE_OPERATION, 0, factor);
+  }
+  heap *scores = SCORES;
+  for (all_stack (assignment, assignment, *saved)) {
+    const double score = kissat_get_heap_score (scores, assignment.idx);
+    if (score != assignment.score)
+      push_operation (solver, trace, UPDATE_OPERATION, assignment.idx,
+                      score);
+  }
+  for (all_stack (assignment, assignment, *saved))
+    if (!assignment.contained &&
+        kissat_heap_contains (scores, assignment.idx))
+      push_operation (solver, trace, PUSH_OPERATION, assignment.idx, 0);
+}
+
+static void record (kissat *solver, trace *trace, unsigned conflicts) {
+  if (solver->level)
+    kissat_backtrack_in_consistent_state (solver, 0);
+  heap *scores = SCORES;
+  trace->vars = VARS;
+  for (all_variables (idx))
+    PUSH_STACK (trace->scores, kissat_get_heap_score (scores, idx));
+  for (all_stack (heap_entry, entry, scores->stack))
+    PUSH_STACK (trace->stack, HEAP_ENTRY_IDX (entry));
+  assignments saved;
+  INIT_STACK (saved);
+  unsigned recorded = 0;
+  while (recorded < conflicts) {
+    clause *conflict = kissat_search_propagate (solver);
+    if (conflict) {
+      if (!solver->level)
+        break;
+      recorded++;
+      save_assignments (solver, &saved);
+      const double scinc = solver->scinc;
+      if (kissat_analyze (solver, conflict))
+        break;
+      record_changes (solver, trace, &saved, scinc);
+    } else if (!solver->unassigned)
+      break;
+    else if (kissat_restarting (solver)) {
+      save_assignments (solver, &saved);
+      const double scinc = solver->scinc;
+      kissat_restart (solver);
+      record_changes (solver, trace, &saved, scinc);
+    } else {
+      const size_t before = kissat_size_heap (scores);
+      kissat_decide (solver);
+      const size_t after = kissat_size_heap (scores);
+      assert (after <= before);
+      if (after < before)
+        push_operation (solver, trace, POP_OPERATION, before - after, 0);
+    }
+  }
+  if (solver->level) {
+    save_assignments (solver, &saved);
+    kissat_backtrack_in_consistent_state (solver, 0);
+    record_changes (solver, trace, &saved, solver->scinc);
+  }
+  RELEASE_STACK (saved);
+  printf ("c recorded %u conflicts with %zu heap operations\n", recorded,
+          SIZE_STACK (trace->operations));
+}
+
+static void write_trace (const trace *trace, const char *path) {
+  FILE *file = fopen (path, "wb");
+  if (!file)
+    die ("can not write '%s'", path);
+  const size_t stack = SIZE_STACK (trace->stack);
+  const size_t operations = SIZE_STACK (trace->operations);
+  bool ok = fwrite (&trace->vars, sizeof trace->vars, 1, file) == 1;
+  ok = ok && fwrite (&stack, sizeof stack, 1, file) == 1;
+  ok = ok && fwrite (&operations, sizeof operations, 1, file) == 1;
+  ok = ok && fwrite (BEGIN_STACK (trace->scores), sizeof (double),
+                     trace->vars, file) == trace->vars;
+  ok = ok && fwrite (BEGIN_STACK (trace->stack), sizeof (unsigned), stack,
+                     file) == stack;
+  ok = ok && fwrite (BEGIN_STACK (trace->operations), sizeof (operation),
+                     operations, file) == operations;
+  if (fclose (file) || !ok)
+    die ("failed to write '%s'", path);
+  printf ("c wrote trace to '%s'\n", path);
+}
+
+static void read_trace (kissat *solver, trace *trace, const char *path) {
+  FILE *file = fopen (path, "rb");
+  if (!file)
+    die ("can not read '%s'", path);
+  size_t stack, operations;
+  if (fread (&trace->vars, sizeof trace->vars, 1, file) != 1 ||
+      fread (&stack, sizeof stack, 1, file) != 1 ||
+      fread (&operations, sizeof operations, 1, file) != 1 ||
+      stack > trace->vars)
+    die ("invalid trace header in '%s'", path);
+  for (unsigned i = 0; i != trace->vars; i++)
+    PUSH_STACK (trace->scores, 0);
+  for (size_t i = 0; i != stack; i++)
+    PUSH_STACK (trace->stack, 0);
+  for (size_t i = 0; i != operations; i++)
+    push_operation (solver, trace, PUSH_OPERATION, 0, 0);
+  bool ok = fread (BEGIN_STACK (trace->scores), sizeof (double),
+                   trace->vars, file) == trace->vars;
+  ok = ok && fread (BEGIN_STACK (trace->stack), sizeof (unsigned), stack,
+                    file) == stack;
+  ok = ok && fread (BEGIN_STACK (trace->operations), sizeof (operation),
+                    operations, file) == operations;
+  fclose (file);
+  if (!ok)
+    die ("truncated trace '%s'", path);
+  for (all_stack (unsigned, idx, trace->stack))
+    if (idx >= trace->vars)
+      die ("invalid variable index in '%s'", path);
+  for (all_stack (operation, operation, trace->operations))
+    if (operation.type >= TYPES ||
+        (operation.type != POP_OPERATION &&
+         operation.type != RESCALE_OPERATION &&
+         operation.arg >= trace->vars))
+      die ("invalid operation in '%s'", path);
+  printf ("c read trace of %zu heap operations on %u variables "
+          "from '%s'\n",
+          operations, trace->vars, path);
+}
+
+// Pushing the recorded heap entries in order does not move any of them,
+// since the heap property holds.  Thus the copy has the same layout.
+
+static void init_heap (kissat *solver, const trace *trace, heap *heap) {
+  memset (heap, 0, sizeof *heap);
+  kissat_resize_heap (solver, heap, trace->vars);
+  for (unsigned idx = 0; idx != trace->vars; idx++) {
+    const double score = PEEK_STACK (trace->scores, idx);
+    if (score)
+      kissat_update_heap (solver, heap, idx, score);
+  }
+  for (all_stack (unsigned, idx, trace->stack))
+    kissat_push_heap (solver, heap, idx);
+}
+
+static void replay (kissat *solver, const trace *trace, heap *heap,
+                    uint64_t *counts) {
+  for (all_stack (operation, operation, trace->operations)) {
+    const unsigned arg = operation.arg;
+    switch (operation.type) {
+    case PUSH_OPERATION:
+      if (!kissat_heap_contains (heap, arg))
+        kissat_push_heap (solver, heap, arg);
+      break;
+    case POP_OPERATION:
+      for (unsigned i = 0; i != arg && !kissat_empty_heap (heap); i++)
+        kissat_pop_max_heap (solver, heap);
+      break;
+    case UPDATE_OPERATION:
+      kissat_update_heap (solver, heap, arg, operation.score);
+      break;
+    default:
+      assert (operation.type == RESCALE_OPERATION);
+      kissat_rescale_heap (solver, heap, operation.score);
+      break;
+    }
+    if (counts)
+      counts[operation.type] += operation.type == POP_OPERATION ? arg : 1;
+  }
+}
+
+int main (int argc, char **argv) {
+  unsigned warmup = 20000, conflicts = 10000, rounds = 100;
+  const char *path = 0, *input = 0, *output = 0;
+  bool verbose = false;
+  for (int i = 1; i != argc; i++) {
+    const char *arg = argv[i];
+    if (!strcmp (arg, "-h")) {
+      fputs (usage, stdout);
+      return 0;
+    } else if (!strcmp (arg, "-v"))
+      verbose = true;
+    else if (!strcmp (arg, "-w"))
+      warmup = parse_count (arg, argv[++i]);
+    else if (!strcmp (arg, "-c"))
+      conflicts = parse_count (arg, argv[++i]);
+    else if (!strcmp (arg, "-r"))
+      rounds = parse_count (arg, argv[++i]);
+    else if (!strcmp (arg, "-i")) {
+      if (!(input = argv[++i]))
+        die ("argument to '-i' missing");
+    } else if (!strcmp (arg, "-o")) {
+      if (!(output = argv[++i]))
+        die ("argument to '-o' missing");
+    } else if (arg[0] == '-')
+      die ("invalid option '%s' (try '-h')", arg);
+    else if (path)
+      die ("multiple files '%s' and '%s'", path, arg);
+    else
+      path = arg;
+  }
+  if (input && path)
+    die ("can not combine '-i %s' and '%s'", input, path);
+  if (input && output)
+    die ("can not combine '-i' and '-o'");
+  if (!input && !path)
+    die ("no DIMACS file nor trace specified (try '-h')");
+
+  kissat *solver = kissat_init ();
+  if (!verbose)
+    kissat_set_option (solver, "quiet", 1);
+  trace trace;
+  memset (&trace, 0, sizeof trace);
+  if (input)
+    read_trace (solver, &trace, input);
+  else {
+    kissat_set_option (solver, "stable", 2);
+    file file;
+    if (!kissat_open_to_read_file (&file, path))
+      die ("can not read '%s'", path);
+    uint64_t lineno;
+    int max_var;
+    const char *error = kissat_parse_dimacs (solver, NORMAL_PARSING, &file,
+                                             &lineno, &max_var);
+    kissat_close_file (&file);
+    if (error)
+      die ("%s:%" PRIu64 ": parse error: %s", path, lineno, error);
+
+    kissat_set_conflict_limit (solver, warmup);
+    int res = kissat_solve (solver);
+    if (res || solver->inconsistent)
+      die ("instance solved during warm-up (reduce '-w')");
+    solver->stable = true;
+    kissat_init_reluctant (solver);
+    kissat_update_scores (solver);
+    printf ("c warmed up with %" PRIu64 " conflicts\n", CONFLICTS);
+
+    record (solver, &trace, conflicts);
+    if (solver->inconsistent)
+      die ("instance solved during recording (reduce '-c')");
+    if (output)
+      write_trace (&trace, output);
+  }
+
+  printf ("c replaying on %u-ary heap with %zu-byte entries\n", HEAP_ARITY,
+          sizeof (heap_entry));
+
+  heap heap;
+  uint64_t counts[TYPES];
+  memset (counts, 0, sizeof counts);
+  init_heap (solver, &trace, &heap);
+  replay (solver, &trace, &heap, counts);
+  if (!input) {
+    const size_t recorded = kissat_size_heap (SCORES);
+    const size_t replayed = kissat_size_heap (&heap);
+    printf ("c replayed heap size %zu (recorded %zu)\n", replayed,
+            recorded);
+  }
+  kissat_release_heap (solver, &heap);
+
+  double time = 0;
+  for (unsigned round = 0; round != rounds; round++) {
+    init_heap (solver, &trace, &heap);
+    const double start = kissat_process_time ();
+    replay (solver, &trace, &heap, 0);
+    time += kissat_process_time () - start;
+    kissat_release_heap (solver, &heap);
+  }
+
+  uint64_t total = 0;
+  printf ("c\nc %-8s %14s\n", "type", "per round");
+  for (unsigned i = 0; i != TYPES; i++) {
+    printf ("c %-8s %14" PRIu64 "\n", type_names[i], counts[i]);
+    total += counts[i];
+  }
+  const double seconds = time / rounds;
+  printf ("c\nc %-8s %14" PRIu64 " %10.2f ms/round %8.2f ns/operation\n",
+          "total", total, 1e3 * seconds,
+          total ? 1e9 * seconds / total : 0.0);
+
+  RELEASE_STACK (trace.scores);
+  RELEASE_STACK (trace.stack);
+  RELEASE_STACK (trace.operations);
+  kissat_release (solver);
+  return 0;
+}
@@ -0,0 +1,307 @@
+// Stand-alone propagation benchmark compiled with 'make bench-propagate'.
+//
+// It parses a DIMACS file, runs the solver for a number of warm-up
+// conflicts to obtain a realistic clause database, watch lists and
+// heuristic state, then records the decisions leading to the following
+// conflicts of a real (focused mode) search.  These decision sequences
+// are replayed many times with pure propagation only (no analysis,
+// learning nor restarts) using the search, probing and beyond-conflict
+// propagation variants.  Since the replay is deterministic the numbers
+// allow to compare watch and clause layout changes within seconds.
+
+#include "analyze.h"
+#include "backtrack.h"
+#include "decide.h"
+#include "inline.h"
+#include "internal.h"
+#include "parse.h"
+#include "propbeyond.h"
+#include "proprobe.h"
+#include "propsearch.h"
+#include "resources.h"
+#include "restart.h"
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *usage =
+    "usage: bench-propagate [ <option> ... ] <dimacs>\n"
+    "\n"
+    "where '<option>' is one of the following\n"
+    "\n"
+    "  -h              print this command line option summary\n"
+    "  -v              verbose solver messages during warm-up\n"
+    "  -w <conflicts>  number of warm-up conflicts (default 20000)\n"
+    "  -c <conflicts>  number of recorded conflicts (default 1000)\n"
+    "  -r <rounds>     replay rounds per variant (default 100)\n"
+    "  -m <variant>    only 'search', 'probing' or 'beyond' "
+    "propagation\n";
+
+static void die (const char *fmt, ...) {
+  fputs ("bench-propagate: error: ", stderr);
+  va_list ap;
+  va_start (ap, fmt);
+  vfprintf (stderr, fmt, ap);
+  va_end (ap);
+  fputc ('\n', stderr);
+  exit (1);
+}
+
+static unsigned parse_count (const char *opt, const char *arg) {
+  if (!arg)
+    die ("argument to '%s' missing", opt);
+  char *end;
+  const long res = strtol (arg, &end, 10);
+  if (*end || res < 1 || res > 1e9)
+    die ("invalid argument '%s' to '%s'", arg, opt);
+  return res;
+}
+
+enum variant {
+  SEARCH_VARIANT = 0,
+  PROBING_VARIANT = 1,
+  BEYOND_VARIANT = 2,
+};
+
+#define VARIANTS 3
+
+static const char *variant_names[VARIANTS] = {"search", "probing",
+                                              "beyond"};
+
+// Recorded decisions of each conflict separated by 'INVALID_LIT'.
+
+static void record (kissat *solver, unsigneds *decisions,
+                    unsigned conflicts) {
+  if (solver->level)
+    kissat_backtrack_in_consistent_state (solver, 0);
+  unsigned recorded = 0;
+  while (recorded < conflicts) {
+    clause *conflict = kissat_search_propagate (solver);
+    if (conflict) {
+      if (!solver->level)
+        break;
+      for (unsigned level = 1; level <= solver->level; level++)
+        PUSH_STACK (*decisions, FRAME (level).decision);
+      PUSH_STACK (*decisions, INVALID_LIT);
+      recorded++;
+      if (kissat_analyze (solver, conflict))
+        break;
+    } else if (!solver->unassigned)
+      break;
+    else if (kissat_restarting (solver))
+      kissat_restart (solver);
+    else
+      kissat_decide (solver);
+  }
+  if (solver->level)
+    kissat_backtrack_in_consistent_state (solver, 0);
+  printf ("c recorded %u conflicts with %zu decisions\n", recorded,
+          SIZE_STACK (*decisions) - recorded);
+}
+
+static bool propagate (kissat *solver, enum variant variant) {
+  if (variant == SEARCH_VARIANT)
+    return kissat_search_propagate (solver);
+  if (variant == PROBING_VARIANT)
+    return kissat_probing_propagate (solver, 0, false);
+  assert (variant == BEYOND_VARIANT);
+  kissat_propagate_beyond_conflicts (solver);
+  return false;
+}
+
+#define SIZE_CLASSES 8
+
+static const char *size_class_names[SIZE_CLASSES] = {
+    "2", "3", "4", "5-8", "9-16", "17-32", "33-64", ">64"};
+
+static unsigned size_class (unsigned size) {
+  if (size <= 4)
+    return size - 2;
+  unsigned res = 3;
+  for (unsigned limit = 8; res + 1 < SIZE_CLASSES && size > limit;
+       limit *= 2)
+    res++;
+  return res;
+}
+
+typedef struct histogram histogram;
+
+struct histogram {
+  uint64_t visits[SIZE_CLASSES];
+  uint64_t lines;
+};
+
+// Approximates the watches visited by propagating the literals on the
+// trail between 'begin' and 'end' by the watch lists after propagation.
+
+static void visit (kissat *solver, histogram *histogram,
+                   const unsigned *begin, const unsigned *end) {
+  ward *const arena = BEGIN_STACK (solver->arena);
+  for (const unsigned *p = begin; p != end; p++) {
+    watches *watches = &WATCHES (NOT (*p));
+    const watch *const end_watches = END_WATCHES (*watches);
+    const watch *q = BEGIN_WATCHES (*watches);
+    histogram->lines +=
+        ((char *) end_watches - (char *) q + 63) / 64;
+    while (q != end_watches) {
+      const watch head = *q++;
+      if (head.type.binary) {
+        histogram->visits[0]++;
+        continue;
+      }
+      const watch tail = *q++;
+      const clause *const c = (clause *) (arena + tail.large.ref);
+      histogram->visits[size_class (c->size)]++;
+      histogram->lines++;
+    }
+  }
+}
+
+typedef struct counters counters;
+
+struct counters {
+  uint64_t propagations;
+  uint64_t ticks;
+};
+
+static void replay (kissat *solver, const unsigneds *decisions,
+                    enum variant variant, counters *counters,
+                    histogram *histogram) {
+  assert (!solver->level);
+  const unsigned *const end = END_STACK (*decisions);
+  const unsigned *p = BEGIN_STACK (*decisions);
+  if (variant == PROBING_VARIANT)
+    solver->probing = true;
+  else if (variant == BEYOND_VARIANT)
+    solver->warming = true;
+  while (p != end) {
+    bool conflict = false;
+    unsigned lit;
+    while ((lit = *p++) != INVALID_LIT) {
+      if (conflict || !solver->unassigned)
+        continue;
+      const value value = VALUE (lit);
+      if (value > 0)
+        continue;
+      if (value < 0) {
+        conflict = true;
+        continue;
+      }
+      kissat_internal_assume (solver, lit);
+      const unsigned *begin = solver->propagate;
+      conflict = propagate (solver, variant);
+      counters->propagations += solver->propagate - begin;
+      counters->ticks += solver->ticks;
+      if (histogram)
+        visit (solver, histogram, begin, solver->propagate);
+    }
+    kissat_backtrack_without_updating_phases (solver, 0);
+  }
+  solver->probing = solver->warming = false;
+}
+
+int main (int argc, char **argv) {
+  unsigned warmup = 20000, conflicts = 1000, rounds = 100;
+  const char *path = 0, *only = 0;
+  bool verbose = false;
+  for (int i = 1; i != argc; i++) {
+    const char *arg = argv[i];
+    if (!strcmp (arg, "-h")) {
+      fputs (usage, stdout);
+      return 0;
+    } else if (!strcmp (arg, "-v"))
+      verbose = true;
+    else if (!strcmp (arg, "-w"))
+      warmup = parse_count (arg, argv[++i]);
+    else if (!strcmp (arg, "-c"))
+      conflicts = parse_count (arg, argv[++i]);
+    else if (!strcmp (arg, "-r"))
+      rounds = parse_count (arg, argv[++i]);
+    else if (!strcmp (arg, "-m")) {
+      if (!(only = argv[++i]))
+        die ("argument to '-m' missing");
+    } else if (arg[0] == '-')
+      die ("invalid option '%s' (try '-h')", arg);
+    else if (path)
+      die ("multiple files '%s' and '%s'", path, arg);
+    else
+      path = arg;
+  }
+  if (!path)
+    die ("no DIMACS file specified (try '-h')");
+  if (only) {
+    unsigned i = 0;
+    while (i != VARIANTS && strcmp (only, variant_names[i]))
+      i++;
+    if (i == VARIANTS)
+      die ("invalid variant '%s' (try '-h')", only);
+  }
+
+  kissat *solver = kissat_init ();
+  if (!verbose)
+    kissat_set_option (solver, "quiet", 1);
+  file file;
+  if (!kissat_open_to_read_file (&file, path))
+    die ("can not read '%s'", path);
+  uint64_t lineno;
+  int max_var;
+  const char *error =
+      kissat_parse_dimacs (solver, NORMAL_PARSING, &file, &lineno, &max_var);
+  kissat_close_file (&file);
+  if (error)
+    die ("%s:%" PRIu64 ": parse error: %s", path, lineno, error);
+
+  kissat_set_conflict_limit (solver, warmup);
+  int res = kissat_solve (solver);
+  if (res || solver->inconsistent)
+    die ("instance solved during warm-up (reduce '-w')");
+  printf ("c warmed up with %" PRIu64 " conflicts\n", CONFLICTS);
+
+  unsigneds decisions;
+  INIT_STACK (decisions);
+  record (solver, &decisions, conflicts);
+  if (solver->inconsistent)
+    die ("instance solved during recording (reduce '-c')");
+
+  counters counters;
+  histogram histogram;
+  memset (&counters, 0, sizeof counters);
+  memset (&histogram, 0, sizeof histogram);
+  replay (solver, &decisions, SEARCH_VARIANT, &counters, &histogram);
+
+  printf ("c\nc %-8s %14s %14s %10s %10s\n", "variant", "props/sec",
+          "propagations", "ticks", "ticks/prop");
+  for (unsigned i = 0; i != VARIANTS; i++) {
+    if (only && strcmp (only, variant_names[i]))
+      continue;
+    memset (&counters, 0, sizeof counters);
+    const double start = kissat_process_time ();
+    for (unsigned round = 0; round != rounds; round++)
+      replay (solver, &decisions, i, &counters, 0);
+    const double time = kissat_process_time () - start;
+    const uint64_t p = counters.propagations;
+    const uint64_t t = counters.ticks;
+    printf ("c %-8s %14.0f %14" PRIu64 " %10" PRIu64 " %10.2f\n",
+            variant_names[i], time > 0 ? p / time : 0.0, p, t,
+            p ? t / (double) p : 0.0);
+  }
+
+  uint64_t visits = 0;
+  for (unsigned i = 0; i != SIZE_CLASSES; i++)
+    visits += histogram.visits[i];
+  printf ("c\nc %-8s %14s %8s\n", "size", "watch visits", "percent");
+  for (unsigned i = 0; i != SIZE_CLASSES; i++)
+    printf ("c %-8s %14" PRIu64 " %7.2f%%\n", size_class_names[i],
+            histogram.visits[i],
+            visits ? 100.0 * histogram.visits[i] / visits : 0.0);
+  printf ("c\nc %" PRIu64 " cache lines touched by watches and clauses "
+          "in one search replay\n",
+          histogram.lines);
+
+  RELEASE_STACK (decisions);
+  kissat_release (solver);
+  return 0;
+}
@@ -0,0 +1,150 @@
+#include "allocate.h"
+#include "inlinebuckets.h"
+#include "internal.h"
+#include "logging.h"
+
+#include <string.h>
+
+static void unbucket_links (bucket_link *links, unsigned begin,
+                            unsigned end) {
+  for (unsigned idx = begin; idx < end; idx++)
+    links[idx].bucket = UNBUCKETED;
+}
+
+void kissat_enable_buckets (kissat *solver, scorebuckets *buckets,
+                            unsigned size) {
+  assert (!buckets->enabled);
+  LOG ("enabling score buckets for %u variables", size);
+  buckets->enabled = true;
+  buckets->size = size;
+  buckets->links = kissat_nalloc (solver, size, sizeof *buckets->links);
+  unbucket_links (buckets->links, 0, size);
+  buckets->first = kissat_nalloc (solver, BUCKETS, sizeof (unsigned));
+  memset (buckets->first, 0xff, BUCKETS * sizeof (unsigned));
+  memset (buckets->summary, 0, sizeof buckets->summary);
+  memset (buckets->nonempty, 0, sizeof buckets->nonempty);
+}
+
+void kissat_resize_buckets (kissat *solver, scorebuckets *buckets,
+                            unsigned new_size) {
+  if (!buckets->enabled)
+    return;
+  const unsigned old_size = buckets->size;
+  if (old_size == new_size)
+    return;
+  LOG ("resizing score buckets from %u to %u", old_size, new_size);
+#ifndef NDEBUG
+  for (unsigned idx = new_size; idx < old_size; idx++)
+    assert (buckets->links[idx].bucket == UNBUCKETED);
+#endif
+  buckets->links = kissat_nrealloc (solver, buckets->links, old_size,
+                                    new_size, sizeof *buckets->links);
+  unbucket_links (buckets->links, old_size, new_size);
+  buckets->size = new_size;
+}
+
+void kissat_release_buckets (kissat *solver, scorebuckets *buckets) {
+  if (!buckets->enabled)
+    return;
+  LOG ("releasing score buckets");
+  DEALLOC (buckets->links, buckets->size);
+  DEALLOC (buckets->first, BUCKETS);
+  memset (buckets, 0, sizeof *buckets);
+}
+
+// Remove all variables from the buckets and save them on the given
+// stack in increasing bucket order and within a bucket from back to
+// front.  Pushing them in this order again (after rescaling or
+// compacting) thus keeps their relative order.
+
+void kissat_flush_buckets (kissat *solver, scorebuckets *buckets,
+                           unsigneds *flushed) {
+  assert (buckets->enabled);
+  bucket_link *const links = buckets->links;
+  unsigned *const first = buckets->first;
+  for (unsigned word = 0; word < BUCKET_WORDS; word++) {
+    uint64_t nonempty = buckets->nonempty[word];
+    while (nonempty) {
+      const uint64_t lowest = nonempty & -nonempty;
+      const unsigned bit = kissat_log2_floor_of_uint64 (lowest);
+      nonempty &= nonempty - 1;
+      const unsigned bucket = 64 * word + bit;
+      const size_t start = SIZE_STACK (*flushed);
+      for (unsigned idx = first[bucket]; idx != BUCKET_END;
+           idx = links[idx].next) {
+        links[idx].bucket = UNBUCKETED;
+        PUSH_STACK (*flushed, idx);
+      }
+      unsigned *p = BEGIN_STACK (*flushed) + start;
+      unsigned *q = END_STACK (*flushed);
+      while (p < --q) {
+        const unsigned tmp = *p;
+        *p++ = *q;
+        *q = tmp;
+      }
+      first[bucket] = BUCKET_END;
+    }
+    buckets->nonempty[word] = 0;
+  }
+  memset (buckets->summary, 0, sizeof buckets->summary);
+  LOG ("flushed %zu variables from score buckets", SIZE_STACK (*flushed));
+}
+
+// Rescaling scores by a factor which is not a power of two changes the
+// buckets of variables non-uniformly, so all of them are pushed again.
+
+void kissat_rebuild_buckets (kissat *solver, scorebuckets *buckets) {
+  if (!buckets->enabled)
+    return;
+  LOG ("rebuilding score buckets");
+  const heap *const scores = SCORES;
+  unsigneds flushed;
+  INIT_STACK (flushed);
+  kissat_flush_buckets (solver, buckets, &flushed);
+  for (all_stack (unsigned, idx, flushed)) {
+    const double score = kissat_get_heap_score (scores, idx);
+    kissat_push_bucket (solver, buckets, idx, score);
+  }
+  RELEASE_STACK (flushed);
+  kissat_check_buckets (solver, buckets);
+}
+
+#ifndef NDEBUG
+
+void kissat_check_buckets (kissat *solver, scorebuckets *buckets) {
+  if (!buckets->enabled)
+    return;
+  const heap *const scores = SCORES;
+  const bucket_link *const links = buckets->links;
+  unsigned contained = 0, listed = 0;
+  for (unsigned idx = 0; idx < buckets->size; idx++) {
+    const bucket_link *const l = links + idx;
+    if (l->bucket == UNBUCKETED)
+      continue;
+    contained++;
+    const double score = kissat_get_heap_score (scores, idx);
+    assert (l->bucket == kissat_score_bucket (score));
+    if (l->prev == BUCKET_END)
+      assert (buckets->first[l->bucket] == idx);
+    else
+      assert (links[l->prev].next == idx);
+    if (l->next != BUCKET_END)
+      assert (links[l->next].prev == idx);
+  }
+  for (unsigned bucket = 0; bucket < BUCKETS; bucket++) {
+    const unsigned word = bucket >> 6;
+    const uint64_t bit = (uint64_t) 1 << (bucket & 63);
+    const bool nonempty = buckets->nonempty[word] & bit;
+    assert (nonempty == (buckets->first[bucket] != BUCKET_END));
+    for (unsigned idx = buckets->first[bucket]; idx != BUCKET_END;
+         idx = links[idx].next) {
+      assert (links[idx].bucket == bucket);
+      listed++;
+    }
+    if (nonempty)
+      assert (buckets->summary[word >> 6] & ((uint64_t) 1 << (word & 63)));
+  }
+  assert (contained == listed);
+}
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef _buckets_h_INCLUDED
+#define _buckets_h_INCLUDED
+
+#include "stack.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Lazy bucketed score queue for stable mode decisions (option 'buckets').
+// Instead of a binary heap ordered by the exact EVSIDS score, variables
+// are kept in doubly linked lists, one for each bucket, where the bucket
+// of a variable is given by the exponent and the five most significant
+// mantissa bits of its score.  Scores within the same bucket thus differ
+// by less than a factor of 33/32 (about 1.031), which is less than the
+// growth 1/(1 - 0.05) (about 1.053) of the score increment during a single
+// conflict with the default 'decay'.  With only four bits the factor would
+// be 17/16 (1.0625) and thus larger.
+// Bumped variables are moved to the front of their list and the front of
+// the highest non-empty bucket is found through two levels of bit-maps.
+// As with the heap assigned variables are only removed lazily when they
+// show up as maximum during decisions, which gives amortized constant
+// time for all operations except rescaling, which rebuilds the buckets.
+// The actual scores remain stored in the 'scores' heap, which stays empty
+// while buckets are used.
+
+#define BUCKET_MANTISSA_BITS 5
+#define BUCKET_EXPONENT_RANGE 510
+
+#define LD_BUCKETS 15
+#define BUCKETS (1u << LD_BUCKETS)
+#define BUCKET_WORDS (BUCKETS / 64)
+#define BUCKET_SUMMARY_WORDS (BUCKET_WORDS / 64)
+
+#define BUCKET_END UINT_MAX
+#define UNBUCKETED UINT_MAX
+
+typedef struct bucket_link bucket_link;
+typedef struct scorebuckets scorebuckets;
+
+struct bucket_link {
+  unsigned prev, next;
+  unsigned bucket;
+};
+
+struct scorebuckets {
+  bool enabled;
+  unsigned size;
+  bucket_link *links;
+  unsigned *first;
+  uint64_t summary[BUCKET_SUMMARY_WORDS];
+  uint64_t nonempty[BUCKET_WORDS];
+};
+
+struct kissat;
+
+void kissat_enable_buckets (struct kissat *, scorebuckets *, unsigned size);
+void kissat_resize_buckets (struct kissat *, scorebuckets *, unsigned size);
+void kissat_release_buckets (struct kissat *, scorebuckets *);
+void kissat_flush_buckets (struct kissat *, scorebuckets *, unsigneds *);
+void kissat_rebuild_buckets (struct kissat *, scorebuckets *);
+
+static inline bool kissat_bucket_contains (const scorebuckets *buckets,
+                                           unsigned idx) {
+  assert (buckets->enabled);
+  assert (idx < buckets->size);
+  return buckets->links[idx].bucket != UNBUCKETED;
+}
+
+static inline unsigned kissat_score_bucket (double score) {
+  assert (score >= 0);
+  uint64_t bits;
+  memcpy (&bits, &score, sizeof bits);
+  bits >>= 52 - BUCKET_MANTISSA_BITS;
+  const uint64_t lower = (uint64_t) (1023 - BUCKET_EXPONENT_RANGE)
+                         << BUCKET_MANTISSA_BITS;
+  if (bits <= lower)
+    return 0;
+  const uint64_t res = bits - lower;
+  return res < BUCKETS ? res : BUCKETS - 1;
+}
+
+#ifndef NDEBUG
+void kissat_check_buckets (struct kissat *, scorebuckets *);
+#else
+#define kissat_check_buckets(...) \
+  do { \
+  } while (0)
+#endif
+
+#endif
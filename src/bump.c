@@ -1,5 +1,6 @@
 #include "bump.h"
 #include "analyze.h"
+#include "inlinebuckets.h"
 #include "inlineheap.h"
 #include "inlinequeue.h"
 #include "inlinevector.h"
@@ -35,6 +36,7 @@ void kissat_rescale_scores (kissat *solver) {
   assert (rescale > 0);
   const double factor = 1.0 / rescale;
   kissat_rescale_heap (solver, scores, factor);
+  kissat_rebuild_buckets (solver, &solver->buckets);
   solver->scinc *= factor;
   kissat_phase (solver, "rescale", GET (rescaled), "rescaled by factor %g",
                 factor);
@@ -60,16 +62,13 @@ static inline void bump_analyzed_variable_score (kissat *solver,
   const double new_score = old_score + inc;
   LOG ("new score[%u] = %g = %g + %g", idx, new_score, old_score, inc);
   kissat_update_heap (solver, scores, idx, new_score);
+  kissat_update_bucket (solver, &solver->buckets, idx, new_score);
   if (new_score > MAX_SCORE)
     kissat_rescale_scores (solver);
 }
 
 void kissat_bump_variable (kissat *solver, unsigned idx) {
   bump_analyzed_variable_score (solver, idx);
-  
-  // Invalidate decision cache when scores change (Optimization #4)
-  // The cached variables may no longer have the highest scores
-  solver->decision_cache_valid = false;
 }
 
 static void bump_analyzed_variable_scores (kissat *solver) {
@@ -115,8 +114,27 @@ void kissat_bump_analyzed (kissat *solver) {
   STOP (bump);
 }
 
+static void update_bucketed_scores (kissat *solver) {
+  heap *scores = SCORES;
+  scorebuckets *buckets = &solver->buckets;
+  if (!buckets->enabled) {
+    kissat_clear_heap (scores);
+    kissat_enable_buckets (solver, buckets, solver->size);
+  }
+  for (all_variables (idx))
+    if (ACTIVE (idx) && !kissat_bucket_contains (buckets, idx)) {
+      const double score = kissat_get_heap_score (scores, idx);
+      kissat_push_bucket (solver, buckets, idx, score);
+    }
+}
+
 void kissat_update_scores (kissat *solver) {
   assert (solver->stable);
+  if (GET_OPTION (buckets)) {
+    update_bucketed_scores (solver);
+    return;
+  }
+  kissat_release_buckets (solver, &solver->buckets);
   heap *scores = SCORES;
   for (all_variables (idx))
     if (ACTIVE (idx) && !kissat_heap_contains (scores, idx))
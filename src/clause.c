@@ -89,7 +89,11 @@ static reference new_large_clause (kissat *solver, bool original,
                                    bool redundant, unsigned glue,
                                    unsigned size, unsigned *lits) {
   assert (size > 2);
-  reference res = kissat_allocate_clause (solver, size);
+  reference res = INVALID_REF;
+  if (redundant && solver->watching)
+    res = kissat_allocate_recycled_clause (solver, size);
+  if (res == INVALID_REF)
+    res = kissat_allocate_clause (solver, size);
   clause *c = kissat_unchecked_dereference_clause (solver, res);
   init_clause (c, redundant, glue, size);
   memcpy (c->lits, lits, size * sizeof (unsigned));
@@ -99,7 +103,8 @@ static reference new_large_clause (kissat *solver, bool original,
   else
     kissat_connect_clause (solver, c);
   if (redundant) {
-    if (solver->first_reducible == INVALID_REF)
+    if (solver->first_reducible == INVALID_REF ||
+        res < solver->first_reducible)
       solver->first_reducible = res;
   } else {
     kissat_mark_added_literals (solver, size, lits);
@@ -610,6 +610,8 @@ void kissat_sparse_collect (kissat *solver, bool compact, reference start) {
   START (collect);
   INC (garbage_collections);
   INC (sparse_gcs);
+  kissat_clear_recycled_clauses (solver);
+  kissat_clear_saved_trail (solver);
   REPORT (1, 'G');
   unsigned vars, mfixed;
   if (compact)
@@ -731,6 +733,8 @@ void kissat_dense_collect (kissat *solver) {
   START (collect);
   INC (garbage_collections);
   INC (dense_garbage_collections);
+  kissat_clear_recycled_clauses (solver);
+  kissat_clear_saved_trail (solver);
   REPORT (1, 'G');
   dense_sweep_garbage_clauses (solver);
   REPORT (1, 'C');
@@ -1,5 +1,6 @@
 #include "compact.h"
 #include "inline.h"
+#include "inlinebuckets.h"
 #include "inlineheap.h"
 #include "print.h"
 #include "resize.h"
@@ -194,7 +195,8 @@ static void compact_scores (kissat *solver, heap *old_scores,
     LOG ("no need to copy scores of old untainted scores heap");
 
   LOG ("now pushing mapped literals onto new heap");
-  for (all_stack (unsigned, idx, old_scores->stack)) {
+  for (all_stack (heap_entry, entry, old_scores->stack)) {
+    const unsigned idx = HEAP_ENTRY_IDX (entry);
     const unsigned midx = map_idx (solver, idx);
     if (midx == INVALID_IDX)
       continue;
@@ -205,6 +207,24 @@ static void compact_scores (kissat *solver, heap *old_scores,
   *old_scores = new_scores;
 }
 
+static void compact_buckets (kissat *solver, scorebuckets *buckets) {
+  if (!buckets->enabled)
+    return;
+  LOG ("compacting score buckets");
+  unsigneds flushed;
+  INIT_STACK (flushed);
+  kissat_flush_buckets (solver, buckets, &flushed);
+  const heap *const scores = SCORES;
+  for (all_stack (unsigned, idx, flushed)) {
+    const unsigned midx = map_idx (solver, idx);
+    if (midx == INVALID_IDX)
+      continue;
+    const double score = kissat_get_heap_score (scores, midx);
+    kissat_push_bucket (solver, buckets, midx, score);
+  }
+  RELEASE_STACK (flushed);
+}
+
 static void compact_trail (kissat *solver) {
   LOG ("compacting trail");
   const size_t size = SIZE_ARRAY (solver->trail);
@@ -364,6 +384,7 @@ void kissat_finalize_compacting (kissat *solver, unsigned vars,
   compact_queue (solver);
   compact_stack (solver, &solver->sweep_schedule);
   compact_scores (solver, SCORES, vars);
+  compact_buckets (solver, &solver->buckets);
   compact_frames (solver);
   compact_export (solver, vars);
   compact_best_and_target_values (solver, vars);
@@ -0,0 +1,420 @@
+#include "compress.h"
+
+#ifdef KISSAT_HAS_COMPRESSOR
+
+#include "error.h"
+#include "utilities.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef KISSAT_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef KISSAT_HAS_BZIP2
+#include <bzlib.h>
+#endif
+
+#ifdef KISSAT_HAS_LZMA
+#include <lzma.h>
+#endif
+
+#ifdef KISSAT_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+#define size_output (1u << 17)
+
+enum format {
+  GZIP_FORMAT,
+  BZIP2_FORMAT,
+  LZMA_FORMAT,
+  XZ_FORMAT,
+  ZSTD_FORMAT,
+};
+
+typedef enum format format;
+
+struct compressor {
+  FILE *file;
+  const char *path;
+  format format;
+  union {
+#ifdef KISSAT_HAS_ZLIB
+    z_stream gzip;
+#endif
+#ifdef KISSAT_HAS_BZIP2
+    bz_stream bzip2;
+#endif
+#ifdef KISSAT_HAS_LZMA
+    lzma_stream lzma;
+#endif
+#ifdef KISSAT_HAS_ZSTD
+    ZSTD_CCtx *zstd;
+#endif
+  } stream;
+  unsigned char output[size_output];
+};
+
+static void compression_failed (compressor *compressor) {
+  kissat_fatal ("compressing '%s' failed", compressor->path);
+}
+
+static void write_output (compressor *compressor, size_t bytes) {
+  assert (bytes <= size_output);
+  if (!bytes)
+    return;
+  if (fwrite (compressor->output, 1, bytes, compressor->file) != bytes)
+    kissat_fatal ("writing compressed '%s' failed", compressor->path);
+}
+
+/*------------------------------------------------------------------------*/
+
+#ifdef KISSAT_HAS_ZLIB
+
+static bool init_gzip (compressor *compressor) {
+  z_stream *stream = &compressor->stream.gzip;
+  memset (stream, 0, sizeof *stream);
+  return deflateInit2 (stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16,
+                       8, Z_DEFAULT_STRATEGY) == Z_OK;
+}
+
+static void code_gzip (compressor *compressor, const unsigned char *ptr,
+                       size_t bytes, int flush) {
+  z_stream *stream = &compressor->stream.gzip;
+  do {
+    const uInt chunk = bytes < UINT_MAX ? bytes : UINT_MAX;
+    const int mode = chunk == bytes ? flush : Z_NO_FLUSH;
+    stream->next_in = (unsigned char *) ptr;
+    stream->avail_in = chunk;
+    do {
+      stream->next_out = compressor->output;
+      stream->avail_out = size_output;
+      const int res = deflate (stream, mode);
+      if (res == Z_STREAM_ERROR)
+        compression_failed (compressor);
+      write_output (compressor, size_output - stream->avail_out);
+    } while (!stream->avail_out);
+    assert (!stream->avail_in);
+    ptr += chunk;
+    bytes -= chunk;
+  } while (bytes);
+}
+
+static void release_gzip (compressor *compressor) {
+  deflateEnd (&compressor->stream.gzip);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+#ifdef KISSAT_HAS_BZIP2
+
+static bool init_bzip2 (compressor *compressor) {
+  bz_stream *stream = &compressor->stream.bzip2;
+  memset (stream, 0, sizeof *stream);
+  return BZ2_bzCompressInit (stream, 9, 0, 0) == BZ_OK;
+}
+
+static void code_bzip2 (compressor *compressor, const unsigned char *ptr,
+                        size_t bytes, int action) {
+  bz_stream *stream = &compressor->stream.bzip2;
+  do {
+    const unsigned chunk = bytes < UINT_MAX ? bytes : UINT_MAX;
+    const int mode = chunk == bytes ? action : BZ_RUN;
+    const int done = mode == BZ_RUN      ? BZ_RUN_OK
+                     : mode == BZ_FLUSH ? BZ_RUN_OK
+                                        : BZ_STREAM_END;
+    stream->next_in = (char *) ptr;
+    stream->avail_in = chunk;
+    for (;;) {
+      stream->next_out = (char *) compressor->output;
+      stream->avail_out = size_output;
+      const int res = BZ2_bzCompress (stream, mode);
+      if (res < 0)
+        compression_failed (compressor);
+      write_output (compressor, size_output - stream->avail_out);
+      if (res == done && (mode != BZ_RUN || !stream->avail_in))
+        break;
+    }
+    ptr += chunk;
+    bytes -= chunk;
+  } while (bytes);
+}
+
+static void release_bzip2 (compressor *compressor) {
+  BZ2_bzCompressEnd (&compressor->stream.bzip2);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+#ifdef KISSAT_HAS_LZMA
+
+// The legacy '.lzma' format does not support flushing and is thus only
+// flushed when finished.  We do not use the multi-threaded '.xz' encoder,
+// since it needs several large blocks in memory and the compressor is
+// already run in its own thread while writing proofs (see 'proof.c').
+
+static bool init_lzma (compressor *compressor) {
+  lzma_stream *stream = &compressor->stream.lzma;
+  const lzma_stream init = LZMA_STREAM_INIT;
+  *stream = init;
+  lzma_ret res;
+  if (compressor->format == LZMA_FORMAT) {
+    lzma_options_lzma options;
+    if (lzma_lzma_preset (&options, LZMA_PRESET_DEFAULT))
+      return false;
+    res = lzma_alone_encoder (stream, &options);
+  } else
+    res =
+        lzma_easy_encoder (stream, LZMA_PRESET_DEFAULT, LZMA_CHECK_CRC64);
+  return res == LZMA_OK;
+}
+
+static void code_lzma (compressor *compressor, const unsigned char *ptr,
+                       size_t bytes, lzma_action action) {
+  lzma_stream *stream = &compressor->stream.lzma;
+  if (action == LZMA_FULL_FLUSH && compressor->format == LZMA_FORMAT)
+    action = LZMA_RUN;
+  stream->next_in = ptr;
+  stream->avail_in = bytes;
+  for (;;) {
+    stream->next_out = compressor->output;
+    stream->avail_out = size_output;
+    const lzma_ret res = lzma_code (stream, action);
+    write_output (compressor, size_output - stream->avail_out);
+    if (res == LZMA_STREAM_END)
+      break;
+    if (res != LZMA_OK)
+      compression_failed (compressor);
+    if (action == LZMA_RUN && !stream->avail_in)
+      break;
+  }
+}
+
+static void release_lzma (compressor *compressor) {
+  lzma_end (&compressor->stream.lzma);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+#ifdef KISSAT_HAS_ZSTD
+
+// Compression level '3' is the default of the 'zstd' tool.
+
+static bool init_zstd (compressor *compressor) {
+  ZSTD_CCtx *stream = ZSTD_createCCtx ();
+  if (!stream)
+    return false;
+  if (ZSTD_isError (
+          ZSTD_CCtx_setParameter (stream, ZSTD_c_compressionLevel, 3))) {
+    ZSTD_freeCCtx (stream);
+    return false;
+  }
+  compressor->stream.zstd = stream;
+  return true;
+}
+
+static void code_zstd (compressor *compressor, const unsigned char *ptr,
+                       size_t bytes, ZSTD_EndDirective mode) {
+  ZSTD_CCtx *stream = compressor->stream.zstd;
+  ZSTD_inBuffer input = {ptr, bytes, 0};
+  size_t remaining;
+  do {
+    ZSTD_outBuffer output = {compressor->output, size_output, 0};
+    remaining = ZSTD_compressStream2 (stream, &output, &input, mode);
+    if (ZSTD_isError (remaining))
+      compression_failed (compressor);
+    write_output (compressor, output.pos);
+  } while (mode == ZSTD_e_continue ? input.pos < input.size : remaining);
+}
+
+static void release_zstd (compressor *compressor) {
+  ZSTD_freeCCtx (compressor->stream.zstd);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+compressor *kissat_open_compressor (const char *path) {
+  format format;
+#define FORMAT(SUFFIX, FORMAT) \
+  if (kissat_has_suffix (path, SUFFIX)) \
+    format = FORMAT; \
+  else
+#ifdef KISSAT_HAS_ZLIB
+  FORMAT (".gz", GZIP_FORMAT)
+#endif
+#ifdef KISSAT_HAS_BZIP2
+  FORMAT (".bz2", BZIP2_FORMAT)
+#endif
+#ifdef KISSAT_HAS_LZMA
+  FORMAT (".lzma", LZMA_FORMAT)
+  FORMAT (".xz", XZ_FORMAT)
+#endif
+#ifdef KISSAT_HAS_ZSTD
+  FORMAT (".zst", ZSTD_FORMAT)
+#endif
+  return 0;
+#undef FORMAT
+  FILE *file = fopen (path, "w");
+  if (!file)
+    return 0;
+  compressor *res = malloc (sizeof *res);
+  if (!res)
+    kissat_fatal ("out-of-memory allocating compressor");
+  res->file = file;
+  res->path = path;
+  res->format = format;
+  bool initialized = false;
+  switch (format) {
+#ifdef KISSAT_HAS_ZLIB
+  case GZIP_FORMAT:
+    initialized = init_gzip (res);
+    break;
+#endif
+#ifdef KISSAT_HAS_BZIP2
+  case BZIP2_FORMAT:
+    initialized = init_bzip2 (res);
+    break;
+#endif
+#ifdef KISSAT_HAS_LZMA
+  case LZMA_FORMAT:
+  case XZ_FORMAT:
+    initialized = init_lzma (res);
+    break;
+#endif
+#ifdef KISSAT_HAS_ZSTD
+  case ZSTD_FORMAT:
+    initialized = init_zstd (res);
+    break;
+#endif
+  default:
+    break;
+  }
+  if (initialized)
+    return res;
+  fclose (file);
+  free (res);
+  return 0;
+}
+
+size_t kissat_compress (compressor *compressor, const void *ptr,
+                        size_t bytes) {
+  if (!bytes)
+    return 0;
+  switch (compressor->format) {
+#ifdef KISSAT_HAS_ZLIB
+  case GZIP_FORMAT:
+    code_gzip (compressor, ptr, bytes, Z_NO_FLUSH);
+    break;
+#endif
+#ifdef KISSAT_HAS_BZIP2
+  case BZIP2_FORMAT:
+    code_bzip2 (compressor, ptr, bytes, BZ_RUN);
+    break;
+#endif
+#ifdef KISSAT_HAS_LZMA
+  case LZMA_FORMAT:
+  case XZ_FORMAT:
+    code_lzma (compressor, ptr, bytes, LZMA_RUN);
+    break;
+#endif
+#ifdef KISSAT_HAS_ZSTD
+  case ZSTD_FORMAT:
+    code_zstd (compressor, ptr, bytes, ZSTD_e_continue);
+    break;
+#endif
+  default:
+    assert (!"unsupported compression format");
+    return 0;
+  }
+  return bytes;
+}
+
+// Flushing makes all data written so far decodable (except for '.lzma').
+
+void kissat_flush_compressor (compressor *compressor) {
+  switch (compressor->format) {
+#ifdef KISSAT_HAS_ZLIB
+  case GZIP_FORMAT:
+    code_gzip (compressor, 0, 0, Z_SYNC_FLUSH);
+    break;
+#endif
+#ifdef KISSAT_HAS_BZIP2
+  case BZIP2_FORMAT:
+    code_bzip2 (compressor, 0, 0, BZ_FLUSH);
+    break;
+#endif
+#ifdef KISSAT_HAS_LZMA
+  case LZMA_FORMAT:
+  case XZ_FORMAT:
+    code_lzma (compressor, 0, 0, LZMA_FULL_FLUSH);
+    break;
+#endif
+#ifdef KISSAT_HAS_ZSTD
+  case ZSTD_FORMAT:
+    code_zstd (compressor, 0, 0, ZSTD_e_flush);
+    break;
+#endif
+  default:
+    break;
+  }
+  fflush (compressor->file);
+}
+
+FILE *kissat_compressor_file (compressor *compressor) {
+  return compressor->file;
+}
+
+void kissat_close_compressor (compressor *compressor) {
+  switch (compressor->format) {
+#ifdef KISSAT_HAS_ZLIB
+  case GZIP_FORMAT:
+    code_gzip (compressor, 0, 0, Z_FINISH);
+    release_gzip (compressor);
+    break;
+#endif
+#ifdef KISSAT_HAS_BZIP2
+  case BZIP2_FORMAT:
+    code_bzip2 (compressor, 0, 0, BZ_FINISH);
+    release_bzip2 (compressor);
+    break;
+#endif
+#ifdef KISSAT_HAS_LZMA
+  case LZMA_FORMAT:
+  case XZ_FORMAT:
+    code_lzma (compressor, 0, 0, LZMA_FINISH);
+    release_lzma (compressor);
+    break;
+#endif
+#ifdef KISSAT_HAS_ZSTD
+  case ZSTD_FORMAT:
+    code_zstd (compressor, 0, 0, ZSTD_e_end);
+    release_zstd (compressor);
+    break;
+#endif
+  default:
+    break;
+  }
+  if (fclose (compressor->file))
+    kissat_fatal ("closing compressed '%s' failed", compressor->path);
+  free (compressor);
+}
+
+#else
+
+int kissat_compress_dummy_to_avoid_warning;
+
+#endif
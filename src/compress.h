@@ -0,0 +1,31 @@
+#ifndef _compress_h_INCLUDED
+#define _compress_h_INCLUDED
+
+#include <stdbool.h>
+#include <stdio.h>
+
+// In-process compression of written files (mostly proofs) through the
+// same libraries used for in-process decompression (see 'decompress.h').
+// Otherwise compressed output is written through external compressors.
+
+#if defined(KISSAT_HAS_ZLIB) || defined(KISSAT_HAS_BZIP2) || \
+    defined(KISSAT_HAS_LZMA) || defined(KISSAT_HAS_ZSTD)
+#define KISSAT_HAS_COMPRESSOR
+#endif
+
+#ifdef KISSAT_HAS_COMPRESSOR
+
+typedef struct compressor compressor;
+
+// Returns zero if the suffix of 'path' does not correspond to a supported
+// format or the file can not be opened for writing.
+
+compressor *kissat_open_compressor (const char *path);
+size_t kissat_compress (compressor *, const void *, size_t);
+void kissat_flush_compressor (compressor *);
+FILE *kissat_compressor_file (compressor *);
+void kissat_close_compressor (compressor *);
+
+#endif
+
+#endif
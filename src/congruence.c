@@ -5,6 +5,7 @@
 #include "inlinevector.h"
 #include "internal.h"
 #include "logging.h"
+#include "parallel.h"
 #include "print.h"
 #include "proprobe.h"
 #include "rank.h"
@@ -3862,6 +3863,294 @@ static void extract_ite_gates_with_base_clause (closure *closure,
 
 #endif
 
+#ifndef INDEX_BINARY_CLAUSES
+
+// Concurrent AND gate extraction ('congruencethreads > 1') splits the
+// irredundant base clauses into ranges, which are searched for AND gates
+// in parallel.  Threads only read binary watches, values and negated
+// binary occurrence counts, use thread-local marks and record for each
+// base clause the LHS literals of matching gates.  Hashing these gates
+// and merging their LHS is then performed by the main thread in clause
+// order (see 'parallel.h') exactly as during sequential extraction.  After
+// a unit has been derived the recorded gates might be stale and thus the
+// remaining base clauses are processed sequentially.
+
+#define CONGRUENCE_TASKS_PER_THREAD 8
+
+typedef struct and_extractor and_extractor;
+typedef struct and_extraction and_extraction;
+
+struct and_extractor {
+  mark *marks;
+  unsigneds lits;
+  unsigneds marked;
+  unsigneds sorter;
+};
+
+struct and_extraction {
+  closure *closure;
+  unsigned threads;
+  unsigned tasks;
+  references candidates;
+  and_extractor *extractors;
+  unsigneds *detected;
+  unsigneds records;
+};
+
+// Thread-local stacks are not accounted (zero solver) as they are
+// allocated concurrently.
+
+static void push_extractor_stack (unsigneds *stack, unsigned element) {
+  kissat *const solver = 0;
+  PUSH_STACK (*stack, element);
+}
+
+static void release_extractor_stack (unsigneds *stack) {
+  kissat *const solver = 0;
+  RELEASE_STACK (*stack);
+}
+
+static void sort_extractor_lits (and_extractor *extractor,
+                                 const unsigned *negbincount, size_t size,
+                                 unsigned *lits) {
+  kissat *const solver = 0;
+#undef SORTER
+#define SORTER (extractor->sorter)
+  QUICK_SORT (unsigned, size, lits, SMALLER_NEGATED_BIN_COUNT);
+  INSERTION_SORT (unsigned, size, lits, SMALLER_NEGATED_BIN_COUNT);
+#undef SORTER
+#define SORTER (solver->sorter)
+}
+
+// Records are 'ref, count, lhs_1, ..., lhs_count' where a zero 'count'
+// denotes a satisfied base clause which still has to be collected.
+
+static void detect_and_gates_with_base_clause (closure *closure,
+                                               and_extractor *extractor,
+                                               unsigneds *detected,
+                                               reference ref) {
+  kissat *const solver = closure->solver;
+  clause *const c = kissat_dereference_clause (solver, ref);
+  const value *const values = solver->values;
+  unsigned arity_limit = MIN (GET_OPTION (congruenceandarity), MAX_ARITY);
+  const unsigned size_limit = arity_limit + 1;
+  const unsigned *const negbincount = closure->negbincount;
+  unsigneds *const lits = &extractor->lits;
+  unsigned size = 0, max_negbincount = 0;
+  CLEAR_STACK (*lits);
+  for (all_literals_in_clause (lit, c)) {
+    const value value = values[lit];
+    if (value < 0)
+      continue;
+    if (value > 0) {
+      push_extractor_stack (detected, ref);
+      push_extractor_stack (detected, 0);
+      return;
+    }
+    if (++size > size_limit)
+      return;
+    const unsigned count = negbincount[lit];
+    if (!count)
+      return;
+    if (count > max_negbincount)
+      max_negbincount = count;
+    push_extractor_stack (lits, lit);
+  }
+  if (size < 3)
+    return;
+  const unsigned arity = size - 1;
+  if (max_negbincount < arity)
+    return;
+  unsigned *begin_lits = BEGIN_STACK (*lits), *reduced_lits = begin_lits;
+  const unsigned *const end_lits = END_STACK (*lits);
+  mark *const marks = extractor->marks;
+  for (unsigned *p = begin_lits; p != end_lits; p++) {
+    const unsigned lit = *p, count = negbincount[lit];
+    marks[NOT (lit)] = 1;
+    if (count < arity) {
+      if (reduced_lits < p)
+        *p = *reduced_lits, *reduced_lits++ = lit;
+      else if (reduced_lits == p)
+        reduced_lits++;
+    }
+  }
+  assert (reduced_lits < end_lits);
+  const size_t reduced_size = end_lits - reduced_lits;
+  sort_extractor_lits (extractor, negbincount, reduced_size, reduced_lits);
+  unsigneds *const marked = &extractor->marked;
+  assert (EMPTY_STACK (*marked));
+  const size_t record = SIZE_STACK (*detected);
+  unsigned found = 0;
+  for (unsigned *p = reduced_lits; p != end_lits; p++) {
+    const unsigned lhs = *p, not_lhs = NOT (lhs);
+    watches *const watches = &WATCHES (not_lhs);
+    const watch *const end_watches = END_WATCHES (*watches);
+    const watch *q = BEGIN_WATCHES (*watches);
+    unsigned matched = 0;
+    if (p == reduced_lits) {
+      while (q != end_watches) {
+        const watch watch = *q++;
+        assert (watch.type.binary);
+        const unsigned other = watch.binary.lit;
+        if (!marks[other])
+          continue;
+        matched++;
+        marks[other] |= 2;
+        push_extractor_stack (marked, other);
+      }
+    } else if (EMPTY_STACK (*marked))
+      break;
+    else if (marks[not_lhs] < 2)
+      continue;
+    else {
+      while (q != end_watches) {
+        const watch watch = *q++;
+        assert (watch.type.binary);
+        const unsigned other = watch.binary.lit;
+        const mark mark = marks[other];
+        if (!mark)
+          continue;
+        matched++;
+        if (mark & 2)
+          marks[other] = mark | 4;
+      }
+      unsigned *const begin_marked = BEGIN_STACK (*marked);
+      const unsigned *const end_marked = END_STACK (*marked);
+      unsigned *r = begin_marked;
+      for (const unsigned *s = begin_marked; s != end_marked; s++) {
+        const unsigned lit = *s;
+        if (lit == not_lhs) {
+          marks[lit] = 1;
+          continue;
+        }
+        mark mark = marks[lit];
+        if (mark & 4) {
+          mark = 3;
+          *r++ = lit;
+        } else
+          mark = 1;
+        marks[lit] = mark;
+      }
+      SET_END_OF_STACK (*marked, r);
+    }
+    if (matched < arity)
+      continue;
+    if (!found++) {
+      push_extractor_stack (detected, ref);
+      push_extractor_stack (detected, 0);
+    }
+    push_extractor_stack (detected, lhs);
+  }
+  if (found)
+    PEEK_STACK (*detected, record + 1) = found;
+  for (const unsigned *p = begin_lits; p != end_lits; p++)
+    marks[NOT (*p)] = 0;
+  CLEAR_STACK (*marked);
+}
+
+static void detect_and_gates_task (void *state, unsigned task,
+                                   unsigned thread) {
+  and_extraction *extraction = state;
+  const size_t size = SIZE_STACK (extraction->candidates);
+  const size_t tasks = extraction->tasks;
+  const size_t begin = (size * task) / tasks;
+  const size_t end = (size * (task + 1)) / tasks;
+  const reference *const candidates = BEGIN_STACK (extraction->candidates);
+  and_extractor *const extractor = extraction->extractors + thread;
+  unsigneds *const detected = extraction->detected + task;
+  for (size_t i = begin; i != end; i++)
+    detect_and_gates_with_base_clause (extraction->closure, extractor,
+                                       detected, candidates[i]);
+}
+
+static void detect_and_gates_concurrently (closure *closure,
+                                           and_extraction *extraction,
+                                           unsigned threads) {
+  kissat *const solver = closure->solver;
+  extraction->closure = closure;
+  extraction->threads = threads;
+  INIT_STACK (extraction->candidates);
+  INIT_STACK (extraction->records);
+  clause *last_irredundant = kissat_last_irredundant_clause (solver);
+  for (all_clauses (c)) {
+    if (last_irredundant && last_irredundant < c)
+      break;
+    if (c->redundant)
+      continue;
+    if (c->garbage)
+      continue;
+    const reference ref = kissat_reference_clause (solver, c);
+    PUSH_STACK (extraction->candidates, ref);
+  }
+  const size_t size = SIZE_STACK (extraction->candidates);
+  size_t tasks = threads * (size_t) CONGRUENCE_TASKS_PER_THREAD;
+  if (tasks > size)
+    tasks = size;
+  extraction->tasks = tasks;
+  extraction->extractors =
+      kissat_calloc (solver, threads, sizeof *extraction->extractors);
+  for (unsigned i = 0; i != threads; i++)
+    extraction->extractors[i].marks =
+        kissat_calloc (solver, LITS, sizeof (mark));
+  extraction->detected =
+      kissat_calloc (solver, tasks, sizeof *extraction->detected);
+  kissat_parallel_for (solver, threads, tasks, detect_and_gates_task,
+                       extraction);
+  for (unsigned i = 0; i != threads; i++) {
+    and_extractor *extractor = extraction->extractors + i;
+    kissat_dealloc (solver, extractor->marks, LITS, sizeof (mark));
+    release_extractor_stack (&extractor->lits);
+    release_extractor_stack (&extractor->marked);
+    release_extractor_stack (&extractor->sorter);
+  }
+  kissat_dealloc (solver, extraction->extractors, threads,
+                  sizeof *extraction->extractors);
+  for (size_t i = 0; i != tasks; i++) {
+    unsigneds *detected = extraction->detected + i;
+    for (all_stack (unsigned, element, *detected))
+      PUSH_STACK (extraction->records, element);
+    release_extractor_stack (detected);
+  }
+  kissat_dealloc (solver, extraction->detected, tasks,
+                  sizeof *extraction->detected);
+  RELEASE_STACK (extraction->candidates);
+  kissat_very_verbose (solver,
+                       "detected AND gates in %zu base clauses "
+                       "with %u threads in %zu tasks",
+                       size, threads, tasks);
+}
+
+static const unsigned *replay_and_gates (closure *closure, clause *c,
+                                         const unsigned *record) {
+  kissat *const solver = closure->solver;
+  assert (record[0] == kissat_reference_clause (solver, c));
+  const unsigned count = record[1];
+  const unsigned *const begin = record + 2, *const end = begin + count;
+  if (!count) {
+    LOGCLS (c, "found satisfied");
+    kissat_mark_clause_as_garbage (solver, c);
+    return end;
+  }
+  const value *const values = solver->values;
+  unsigneds *lits = &closure->lits;
+  CLEAR_STACK (*lits);
+  for (all_literals_in_clause (lit, c))
+    if (!values[lit])
+      PUSH_STACK (*lits, lit);
+  LOGCLS (c, "replaying %u concurrently detected AND gates with base",
+          count);
+  for (const unsigned *p = begin; p != end; p++) {
+    if (solver->inconsistent)
+      break;
+    if (c->garbage)
+      break;
+    (void) new_and_gate (closure, *p);
+  }
+  return end;
+}
+
+#endif
+
 static void extract_and_gates (closure *closure) {
   kissat *const solver = closure->solver;
   if (!GET_OPTION (congruenceands))
@@ -3873,6 +4162,18 @@ static void extract_and_gates (closure *closure) {
   const uint64_t gates_before = s->congruent_gates_ands;
 #endif
   init_and_gate_extraction (closure);
+#ifndef INDEX_BINARY_CLAUSES
+  const unsigned threads = GET_OPTION (congruencethreads);
+  const bool concurrent = threads > 1;
+  and_extraction extraction;
+  const unsigned *record = 0, *end_records = 0;
+  if (concurrent) {
+    detect_and_gates_concurrently (closure, &extraction, threads);
+    record = BEGIN_STACK (extraction.records);
+    end_records = END_STACK (extraction.records);
+  }
+  const size_t trail = SIZE_ARRAY (solver->trail);
+#endif
   clause *last_irredundant = kissat_last_irredundant_clause (solver);
   for (all_clauses (c)) {
     if (TERMINATED (congruence_terminated_1))
@@ -3885,8 +4186,22 @@ static void extract_and_gates (closure *closure) {
       continue;
     if (c->garbage)
       continue;
+#ifndef INDEX_BINARY_CLAUSES
+    if (concurrent && SIZE_ARRAY (solver->trail) == trail) {
+      const reference ref = kissat_reference_clause (solver, c);
+      while (record != end_records && record[0] < ref)
+        record += 2 + record[1];
+      if (record != end_records && record[0] == ref)
+        record = replay_and_gates (closure, c, record);
+      continue;
+    }
+#endif
     extract_and_gates_with_base_clause (closure, c);
   }
+#ifndef INDEX_BINARY_CLAUSES
+  if (concurrent)
+    RELEASE_STACK (extraction.records);
+#endif
   reset_and_gate_extraction (closure);
 #ifndef QUIET
   const uint64_t matched = s->congruent_matched_ands - matched_before;
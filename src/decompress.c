@@ -0,0 +1,473 @@
+#include "decompress.h"
+
+#ifdef KISSAT_HAS_DECOMPRESSION
+
+#include "error.h"
+#include "utilities.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef KISSAT_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef KISSAT_HAS_BZIP2
+#include <bzlib.h>
+#endif
+
+#ifdef KISSAT_HAS_LZMA
+#include <lzma.h>
+#endif
+
+#ifdef KISSAT_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+#define size_input (1u << 17)
+
+enum format {
+  GZIP_FORMAT,
+  BZIP2_FORMAT,
+  LZMA_FORMAT,
+  XZ_FORMAT,
+  ZSTD_FORMAT,
+};
+
+typedef enum format format;
+
+struct decompressor {
+  FILE *file;
+  const char *path;
+  format format;
+  bool eof;
+  bool done;
+  size_t size;
+  union {
+#ifdef KISSAT_HAS_ZLIB
+    z_stream gzip;
+#endif
+#ifdef KISSAT_HAS_BZIP2
+    bz_stream bzip2;
+#endif
+#ifdef KISSAT_HAS_LZMA
+    lzma_stream lzma;
+#endif
+#ifdef KISSAT_HAS_ZSTD
+    struct {
+      ZSTD_DStream *stream;
+      size_t pos, remaining;
+    } zstd;
+#endif
+  } stream;
+  unsigned char input[size_input];
+};
+
+static bool fill_input (decompressor *decompressor) {
+  if (decompressor->eof)
+    return false;
+  decompressor->size =
+      fread (decompressor->input, 1, size_input, decompressor->file);
+  if (decompressor->size)
+    return true;
+  decompressor->eof = true;
+  return false;
+}
+
+static void decompression_failed (decompressor *decompressor) {
+  kissat_fatal ("decompressing '%s' failed (truncated or corrupted)",
+                decompressor->path);
+}
+
+static bool match_input_signature (decompressor *decompressor,
+                                   const unsigned char *sig,
+                                   size_t size) {
+  assert (!decompressor->size);
+  if (!fill_input (decompressor))
+    return false;
+  if (decompressor->size < size)
+    return false;
+  return !memcmp (decompressor->input, sig, size);
+}
+
+/*------------------------------------------------------------------------*/
+
+#ifdef KISSAT_HAS_ZLIB
+
+static bool init_gzip (decompressor *decompressor) {
+  z_stream *stream = &decompressor->stream.gzip;
+  memset (stream, 0, sizeof *stream);
+  if (inflateInit2 (stream, 15 + 32) != Z_OK)
+    return false;
+  stream->next_in = decompressor->input;
+  stream->avail_in = decompressor->size;
+  return true;
+}
+
+static size_t read_gzip (decompressor *decompressor, unsigned char *ptr,
+                         size_t bytes) {
+  z_stream *stream = &decompressor->stream.gzip;
+  stream->next_out = ptr;
+  stream->avail_out = bytes < UINT_MAX ? bytes : UINT_MAX;
+  const size_t size = stream->avail_out;
+  while (stream->avail_out) {
+    if (!stream->avail_in && fill_input (decompressor)) {
+      stream->next_in = decompressor->input;
+      stream->avail_in = decompressor->size;
+    }
+    const uInt before = stream->avail_out;
+    const int res = inflate (stream, Z_NO_FLUSH);
+    if (res == Z_STREAM_END) {
+      if (!stream->avail_in && !fill_input (decompressor)) {
+        decompressor->done = true;
+        break;
+      }
+      if (!stream->avail_in) {
+        stream->next_in = decompressor->input;
+        stream->avail_in = decompressor->size;
+      }
+      inflateReset (stream);
+    } else if (res != Z_OK && res != Z_BUF_ERROR)
+      decompression_failed (decompressor);
+    else if (decompressor->eof && before == stream->avail_out)
+      decompression_failed (decompressor);
+  }
+  return size - stream->avail_out;
+}
+
+static void release_gzip (decompressor *decompressor) {
+  inflateEnd (&decompressor->stream.gzip);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+#ifdef KISSAT_HAS_BZIP2
+
+static bool init_bzip2 (decompressor *decompressor) {
+  bz_stream *stream = &decompressor->stream.bzip2;
+  memset (stream, 0, sizeof *stream);
+  if (BZ2_bzDecompressInit (stream, 0, 0) != BZ_OK)
+    return false;
+  stream->next_in = (char *) decompressor->input;
+  stream->avail_in = decompressor->size;
+  return true;
+}
+
+static size_t read_bzip2 (decompressor *decompressor, unsigned char *ptr,
+                          size_t bytes) {
+  bz_stream *stream = &decompressor->stream.bzip2;
+  stream->next_out = (char *) ptr;
+  stream->avail_out = bytes < UINT_MAX ? bytes : UINT_MAX;
+  const size_t size = stream->avail_out;
+  while (stream->avail_out) {
+    if (!stream->avail_in && fill_input (decompressor)) {
+      stream->next_in = (char *) decompressor->input;
+      stream->avail_in = decompressor->size;
+    }
+    const unsigned before = stream->avail_out;
+    const int res = BZ2_bzDecompress (stream);
+    if (res == BZ_STREAM_END) {
+      if (!stream->avail_in && !fill_input (decompressor)) {
+        decompressor->done = true;
+        break;
+      }
+      char *next_in = stream->avail_in ? stream->next_in
+                                       : (char *) decompressor->input;
+      const unsigned avail_in =
+          stream->avail_in ? stream->avail_in : decompressor->size;
+      char *next_out = stream->next_out;
+      const unsigned avail_out = stream->avail_out;
+      BZ2_bzDecompressEnd (stream);
+      memset (stream, 0, sizeof *stream);
+      if (BZ2_bzDecompressInit (stream, 0, 0) != BZ_OK)
+        decompression_failed (decompressor);
+      stream->next_in = next_in;
+      stream->avail_in = avail_in;
+      stream->next_out = next_out;
+      stream->avail_out = avail_out;
+    } else if (res != BZ_OK)
+      decompression_failed (decompressor);
+    else if (decompressor->eof && before == stream->avail_out)
+      decompression_failed (decompressor);
+  }
+  return size - stream->avail_out;
+}
+
+static void release_bzip2 (decompressor *decompressor) {
+  BZ2_bzDecompressEnd (&decompressor->stream.bzip2);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+#ifdef KISSAT_HAS_LZMA
+
+// Multi-threaded decoding of multi-block '.xz' files is available since
+// version 5.4.0 of 'liblzma'.  It falls back to single-threaded decoding
+// for single-block files (as produced by 'xz' without '-T').
+
+#if LZMA_VERSION >= 50040002
+#define KISSAT_HAS_LZMA_MT
+#endif
+
+static bool init_lzma (decompressor *decompressor) {
+  lzma_stream *stream = &decompressor->stream.lzma;
+  const lzma_stream init = LZMA_STREAM_INIT;
+  *stream = init;
+  lzma_ret res;
+  if (decompressor->format == LZMA_FORMAT)
+    res = lzma_alone_decoder (stream, UINT64_MAX);
+  else {
+#ifdef KISSAT_HAS_LZMA_MT
+    lzma_mt mt;
+    memset (&mt, 0, sizeof mt);
+    mt.flags = LZMA_CONCATENATED;
+    mt.threads = lzma_cputhreads ();
+    if (!mt.threads)
+      mt.threads = 1;
+    mt.memlimit_threading = lzma_physmem () / 4;
+    mt.memlimit_stop = UINT64_MAX;
+    res = lzma_stream_decoder_mt (stream, &mt);
+#else
+    res = lzma_stream_decoder (stream, UINT64_MAX, LZMA_CONCATENATED);
+#endif
+  }
+  if (res != LZMA_OK)
+    return false;
+  stream->next_in = decompressor->input;
+  stream->avail_in = decompressor->size;
+  return true;
+}
+
+static size_t read_lzma (decompressor *decompressor, unsigned char *ptr,
+                         size_t bytes) {
+  lzma_stream *stream = &decompressor->stream.lzma;
+  stream->next_out = ptr;
+  stream->avail_out = bytes;
+  while (stream->avail_out) {
+    if (!stream->avail_in && fill_input (decompressor)) {
+      stream->next_in = decompressor->input;
+      stream->avail_in = decompressor->size;
+    }
+    const lzma_action action = decompressor->eof ? LZMA_FINISH : LZMA_RUN;
+    const lzma_ret res = lzma_code (stream, action);
+    if (res == LZMA_STREAM_END) {
+      decompressor->done = true;
+      break;
+    }
+    if (res != LZMA_OK)
+      decompression_failed (decompressor);
+  }
+  return bytes - stream->avail_out;
+}
+
+static void release_lzma (decompressor *decompressor) {
+  lzma_end (&decompressor->stream.lzma);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+#ifdef KISSAT_HAS_ZSTD
+
+// Frames of 'pzstd' and 'zstd -T' are decoded one after the other, since
+// 'libzstd' only provides multi-threaded compression.
+
+static bool init_zstd (decompressor *decompressor) {
+  ZSTD_DStream *stream = ZSTD_createDStream ();
+  if (!stream)
+    return false;
+  if (ZSTD_isError (ZSTD_initDStream (stream))) {
+    ZSTD_freeDStream (stream);
+    return false;
+  }
+  decompressor->stream.zstd.stream = stream;
+  decompressor->stream.zstd.pos = 0;
+  decompressor->stream.zstd.remaining = 0;
+  return true;
+}
+
+static size_t read_zstd (decompressor *decompressor, unsigned char *ptr,
+                         size_t bytes) {
+  ZSTD_inBuffer input = {decompressor->input, decompressor->size,
+                         decompressor->stream.zstd.pos};
+  ZSTD_outBuffer output = {ptr, bytes, 0};
+  while (output.pos < output.size) {
+    if (input.pos == input.size && fill_input (decompressor)) {
+      input.size = decompressor->size;
+      input.pos = 0;
+    }
+    const size_t before_input = input.pos;
+    const size_t before_output = output.pos;
+    const size_t res = ZSTD_decompressStream (
+        decompressor->stream.zstd.stream, &output, &input);
+    if (ZSTD_isError (res))
+      decompression_failed (decompressor);
+    if (before_input != input.pos || before_output != output.pos)
+      decompressor->stream.zstd.remaining = res;
+    else if (decompressor->eof) {
+      if (decompressor->stream.zstd.remaining)
+        decompression_failed (decompressor);
+      decompressor->done = true;
+      break;
+    }
+  }
+  decompressor->stream.zstd.pos = input.pos;
+  return output.pos;
+}
+
+static void release_zstd (decompressor *decompressor) {
+  ZSTD_freeDStream (decompressor->stream.zstd.stream);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
+decompressor *kissat_open_decompressor (const char *path) {
+  format format;
+  const unsigned char *sig;
+  size_t size_sig;
+#define FORMAT(SUFFIX, FORMAT, ...) \
+  if (kissat_has_suffix (path, SUFFIX)) { \
+    static const unsigned char signature[] = {__VA_ARGS__}; \
+    format = FORMAT; \
+    sig = signature; \
+    size_sig = sizeof signature; \
+  } else
+#ifdef KISSAT_HAS_ZLIB
+  FORMAT (".gz", GZIP_FORMAT, 0x1F, 0x8B)
+#endif
+#ifdef KISSAT_HAS_BZIP2
+  FORMAT (".bz2", BZIP2_FORMAT, 0x42, 0x5A, 0x68)
+#endif
+#ifdef KISSAT_HAS_LZMA
+  FORMAT (".lzma", LZMA_FORMAT, 0x5D, 0x00, 0x00, 0x80, 0x00)
+  FORMAT (".xz", XZ_FORMAT, 0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00)
+#endif
+#ifdef KISSAT_HAS_ZSTD
+  FORMAT (".zst", ZSTD_FORMAT, 0x28, 0xB5, 0x2F, 0xFD)
+#endif
+  return 0;
+#undef FORMAT
+  FILE *file = fopen (path, "r");
+  if (!file)
+    return 0;
+  decompressor *res = malloc (sizeof *res);
+  if (!res)
+    kissat_fatal ("out-of-memory allocating decompressor");
+  res->file = file;
+  res->path = path;
+  res->format = format;
+  res->eof = res->done = false;
+  res->size = 0;
+  bool initialized = false;
+  if (match_input_signature (res, sig, size_sig)) {
+    switch (format) {
+#ifdef KISSAT_HAS_ZLIB
+    case GZIP_FORMAT:
+      initialized = init_gzip (res);
+      break;
+#endif
+#ifdef KISSAT_HAS_BZIP2
+    case BZIP2_FORMAT:
+      initialized = init_bzip2 (res);
+      break;
+#endif
+#ifdef KISSAT_HAS_LZMA
+    case LZMA_FORMAT:
+    case XZ_FORMAT:
+      initialized = init_lzma (res);
+      break;
+#endif
+#ifdef KISSAT_HAS_ZSTD
+    case ZSTD_FORMAT:
+      initialized = init_zstd (res);
+      break;
+#endif
+    default:
+      break;
+    }
+  }
+  if (initialized)
+    return res;
+  fclose (file);
+  free (res);
+  return 0;
+}
+
+size_t kissat_decompress (decompressor *decompressor, void *ptr,
+                          size_t bytes) {
+  if (decompressor->done || !bytes)
+    return 0;
+  switch (decompressor->format) {
+#ifdef KISSAT_HAS_ZLIB
+  case GZIP_FORMAT:
+    return read_gzip (decompressor, ptr, bytes);
+#endif
+#ifdef KISSAT_HAS_BZIP2
+  case BZIP2_FORMAT:
+    return read_bzip2 (decompressor, ptr, bytes);
+#endif
+#ifdef KISSAT_HAS_LZMA
+  case LZMA_FORMAT:
+  case XZ_FORMAT:
+    return read_lzma (decompressor, ptr, bytes);
+#endif
+#ifdef KISSAT_HAS_ZSTD
+  case ZSTD_FORMAT:
+    return read_zstd (decompressor, ptr, bytes);
+#endif
+  default:
+    assert (!"unsupported decompression format");
+    return 0;
+  }
+}
+
+FILE *kissat_decompressor_file (decompressor *decompressor) {
+  return decompressor->file;
+}
+
+void kissat_close_decompressor (decompressor *decompressor) {
+  switch (decompressor->format) {
+#ifdef KISSAT_HAS_ZLIB
+  case GZIP_FORMAT:
+    release_gzip (decompressor);
+    break;
+#endif
+#ifdef KISSAT_HAS_BZIP2
+  case BZIP2_FORMAT:
+    release_bzip2 (decompressor);
+    break;
+#endif
+#ifdef KISSAT_HAS_LZMA
+  case LZMA_FORMAT:
+  case XZ_FORMAT:
+    release_lzma (decompressor);
+    break;
+#endif
+#ifdef KISSAT_HAS_ZSTD
+  case ZSTD_FORMAT:
+    release_zstd (decompressor);
+    break;
+#endif
+  default:
+    break;
+  }
+  fclose (decompressor->file);
+  free (decompressor);
+}
+
+#else
+
+int kissat_decompress_dummy_to_avoid_warning;
+
+#endif
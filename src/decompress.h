@@ -0,0 +1,29 @@
+#ifndef _decompress_h_INCLUDED
+#define _decompress_h_INCLUDED
+
+#include <stdio.h>
+
+// In-process decompression of compressed input files through 'zlib',
+// 'libbz2', 'liblzma' and 'libzstd' if they were found by 'configure'.
+// Otherwise compressed input is read through external decompressors.
+
+#if defined(KISSAT_HAS_ZLIB) || defined(KISSAT_HAS_BZIP2) || \
+    defined(KISSAT_HAS_LZMA) || defined(KISSAT_HAS_ZSTD)
+#define KISSAT_HAS_DECOMPRESSION
+#endif
+
+#ifdef KISSAT_HAS_DECOMPRESSION
+
+typedef struct decompressor decompressor;
+
+// Returns zero if the suffix of 'path' does not correspond to a supported
+// format, the file can not be opened or its signature does not match.
+
+decompressor *kissat_open_decompressor (const char *path);
+size_t kissat_decompress (decompressor *, void *, size_t);
+FILE *kissat_decompressor_file (decompressor *);
+void kissat_close_decompressor (decompressor *);
+
+#endif
+
+#endif
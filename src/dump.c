@@ -121,7 +121,8 @@ static void dump_scores (kissat *solver) {
   printf ("scores.vars = %u\n", heap->vars);
   printf ("scores.size = %u\n", heap->size);
   for (unsigned i = 0; i < SIZE_STACK (heap->stack); i++)
-    printf ("scores.stack[%u] = %u\n", i, PEEK_STACK (heap->stack, i));
+    printf ("scores.stack[%u] = %u\n", i,
+            HEAP_ENTRY_IDX (PEEK_STACK (heap->stack, i)));
   for (unsigned i = 0; i < heap->vars; i++)
     printf ("scores.score[%u] = %g\n", i, heap->score[i]);
   for (unsigned i = 0; i < heap->vars; i++)
@@ -7,6 +7,7 @@
 #include "inline.h"
 #include "inlineheap.h"
 #include "kitten.h"
+#include "parallel.h"
 #include "print.h"
 #include "propdense.h"
 #include "report.h"
@@ -143,6 +144,8 @@ static unsigned schedule_variables (kissat *solver) {
       continue;
     if (!flags->eliminate)
       continue;
+    if (flags->frozen)
+      continue;
     LOG ("scheduling %s", LOGVAR (idx));
     scheduled++;
     update_after_removing_variable (solver, idx);
@@ -378,6 +381,8 @@ static bool can_eliminate_variable (kissat *solver, unsigned idx) {
     return false;
   if (!flags->eliminate)
     return false;
+  if (flags->frozen)
+    return false;
 
   return true;
 }
@@ -413,6 +418,195 @@ static bool eliminate_variable (kissat *solver, unsigned idx) {
   return true;
 }
 
+/*------------------------------------------------------------------------*/
+
+// Parallel elimination ('eliminatethreads > 1') pops a batch of candidates
+// from the schedule and greedily selects those which do not occur together
+// with an already selected candidate in any clause.  Eliminating one of
+// them thus neither adds nor removes clauses of the others.  Resolvents of
+// the selected candidates are generated concurrently on the unchanged
+// formula with thread-local marks and resolvent buffers.  They are then
+// committed in the order of selection (see 'parallel.h').  Candidates for
+// which concurrent resolution was not conclusive (bound exceeded or units
+// resolved) as well as all candidates after a unit was derived fall back
+// to sequential (gate-based) elimination.
+
+#define ELIMINATE_BATCH_PER_THREAD 16
+
+typedef struct batch batch;
+
+struct batch {
+  kissat *solver;
+  unsigned threads;
+  unsigned size;
+  unsigned capacity;
+  resolver *resolvers;
+  value **marks;
+  unsigneds marked;
+  unsigneds deferred;
+#ifndef QUIET
+  uint64_t tried;
+#endif
+};
+
+static void init_batch (kissat *solver, batch *batch, unsigned threads) {
+  batch->solver = solver;
+  batch->threads = threads;
+  batch->size = 0;
+  batch->capacity = threads * ELIMINATE_BATCH_PER_THREAD;
+  batch->resolvers =
+      kissat_calloc (solver, batch->capacity, sizeof *batch->resolvers);
+  batch->marks = kissat_calloc (solver, threads, sizeof *batch->marks);
+  for (unsigned i = 0; i != threads; i++)
+    batch->marks[i] = kissat_calloc (solver, LITS, sizeof (value));
+  INIT_STACK (batch->marked);
+  INIT_STACK (batch->deferred);
+}
+
+static void release_batch (kissat *solver, batch *batch) {
+  for (unsigned i = 0; i != batch->capacity; i++)
+    kissat_release_resolver (batch->resolvers + i);
+  kissat_dealloc (solver, batch->resolvers, batch->capacity,
+                  sizeof *batch->resolvers);
+  for (unsigned i = 0; i != batch->threads; i++)
+    kissat_dealloc (solver, batch->marks[i], LITS, sizeof (value));
+  kissat_dealloc (solver, batch->marks, batch->threads,
+                  sizeof *batch->marks);
+  RELEASE_STACK (batch->marked);
+  RELEASE_STACK (batch->deferred);
+}
+
+static inline void mark_variable (kissat *solver, batch *batch,
+                                  unsigned lit) {
+  const unsigned pos = LIT (IDX (lit));
+  value *const marks = solver->marks;
+  if (marks[pos])
+    return;
+  marks[pos] = 1;
+  PUSH_STACK (batch->marked, pos);
+}
+
+static void mark_neighbourhood (kissat *solver, batch *batch,
+                                unsigned lit) {
+  ward *const arena = BEGIN_STACK (solver->arena);
+  watches *const watches = &WATCHES (lit);
+  for (all_binary_large_watches (watch, *watches)) {
+    if (watch.type.binary)
+      mark_variable (solver, batch, watch.binary.lit);
+    else {
+      const reference ref = watch.large.ref;
+      clause *const c = (clause *) (arena + ref);
+      if (c->garbage)
+        continue;
+      for (all_literals_in_clause (other, c))
+        mark_variable (solver, batch, other);
+    }
+  }
+}
+
+static void schedule_batch (kissat *solver, batch *batch) {
+  heap *const schedule = &solver->schedule;
+  const value *const marks = solver->marks;
+  const unsigned max_popped = 4 * batch->capacity;
+  unsigned popped = 0;
+  batch->size = 0;
+  assert (EMPTY_STACK (batch->deferred));
+  while (batch->size < batch->capacity && popped < max_popped &&
+         !kissat_empty_heap (schedule)) {
+    const unsigned idx = kissat_pop_max_heap (solver, schedule);
+    popped++;
+    if (!can_eliminate_variable (solver, idx))
+      continue;
+    const unsigned lit = LIT (idx);
+    if (marks[lit]) {
+      PUSH_STACK (batch->deferred, idx);
+      continue;
+    }
+    mark_variable (solver, batch, lit);
+    mark_neighbourhood (solver, batch, lit);
+    mark_neighbourhood (solver, batch, NOT (lit));
+    batch->resolvers[batch->size++].idx = idx;
+  }
+  value *const unmark = solver->marks;
+  for (all_stack (unsigned, lit, batch->marked))
+    unmark[lit] = 0;
+  CLEAR_STACK (batch->marked);
+  LOG ("scheduled batch of %u independent candidates (%zu deferred)",
+       batch->size, SIZE_STACK (batch->deferred));
+}
+
+static void resolve_batch_candidate (void *state, unsigned task,
+                                     unsigned thread) {
+  batch *batch = state;
+  kissat_resolve_concurrently (batch->solver, batch->marks[thread],
+                               batch->resolvers + task);
+}
+
+static void commit_resolvents (kissat *solver, resolver *resolver) {
+  const unsigned idx = resolver->idx;
+  LOG ("committing concurrent elimination of %s", LOGVAR (idx));
+  FLAGS (idx)->eliminate = false;
+  INC (eliminate_attempted);
+  assert (EMPTY_STACK (solver->resolvents));
+  for (all_stack (unsigned, lit, resolver->resolvents))
+    PUSH_STACK (solver->resolvents, lit);
+  connect_resolvents (solver);
+  if (!solver->inconsistent)
+    weaken_clauses (solver, resolver->lit);
+  INC (eliminated);
+  kissat_mark_eliminated_variable (solver, idx);
+}
+
+static unsigned eliminate_batch (kissat *solver, batch *batch,
+                                 uint64_t resolution_limit,
+                                 bool *limit_hit) {
+#ifndef QUIET
+  batch->tried = 0;
+#endif
+  statistics *s = &solver->statistics;
+  if (s->eliminate_resolutions > resolution_limit) {
+    *limit_hit = true;
+    return 0;
+  }
+  schedule_batch (solver, batch);
+  kissat_parallel_for (solver, batch->threads, batch->size,
+                       resolve_batch_candidate, batch);
+  for (unsigned i = 0; i != batch->size; i++)
+    ADD (eliminate_resolutions, batch->resolvers[i].resolutions);
+  const size_t trail = SIZE_ARRAY (solver->trail);
+  unsigned eliminated = 0;
+  for (unsigned i = 0; !solver->inconsistent && i != batch->size; i++) {
+    resolver *resolver = batch->resolvers + i;
+    const unsigned idx = resolver->idx;
+    if (!can_eliminate_variable (solver, idx))
+      continue;
+    if (s->eliminate_resolutions > resolution_limit) {
+      *limit_hit = true;
+      break;
+    }
+#ifndef QUIET
+    batch->tried++;
+#endif
+    if (resolver->status == RESOLVER_FAILED)
+      FLAGS (idx)->eliminate = false;
+    else if (resolver->status == RESOLVER_RESOLVED &&
+             SIZE_ARRAY (solver->trail) == trail) {
+      commit_resolvents (solver, resolver);
+      eliminated++;
+    } else if (eliminate_variable (solver, idx))
+      eliminated++;
+    if (!solver->inconsistent)
+      kissat_flush_units_while_connected (solver);
+  }
+  if (!solver->inconsistent)
+    for (all_stack (unsigned, idx, batch->deferred))
+      update_after_removing_variable (solver, idx);
+  CLEAR_STACK (batch->deferred);
+  return eliminated;
+}
+
+/*------------------------------------------------------------------------*/
+
 static void eliminate_variables (kissat *solver) {
   kissat_very_verbose (solver,
                        "trying to eliminate variables with bound %u",
@@ -425,13 +619,19 @@ static void eliminate_variables (kissat *solver) {
 #endif
   unsigned last_round_eliminated = 0;
 
-  SET_EFFORT_LIMIT (resolution_limit, eliminate, eliminate_resolutions);
+  SET_SCHEDULED_EFFORT_LIMIT (resolution_limit, eliminate,
+                              eliminate_resolutions);
 
   bool complete;
   int round = 0;
 
   const bool forward = GET_OPTION (forward);
 
+  const unsigned threads = GET_OPTION (eliminatethreads);
+  batch batch;
+  if (threads > 1)
+    init_batch (solver, &batch, threads);
+
   for (;;) {
     round++;
     LOG ("starting new elimination round %d", round);
@@ -471,6 +671,25 @@ static void eliminate_variables (kissat *solver) {
         complete = false;
         break;
       }
+      if (threads > 1) {
+        bool limit_hit = false;
+        last_round_eliminated +=
+            eliminate_batch (solver, &batch, resolution_limit, &limit_hit);
+#ifndef QUIET
+        tried += batch.tried;
+#endif
+        if (limit_hit) {
+          kissat_extremely_verbose (
+              solver,
+              "eliminate round %u hits "
+              "resolution limit %" PRIu64 " at %" PRIu64 " resolutions",
+              round, resolution_limit,
+              solver->statistics.eliminate_resolutions);
+          complete = false;
+          break;
+        }
+        continue;
+      }
       unsigned idx = kissat_pop_max_heap (solver, &solver->schedule);
       if (!can_eliminate_variable (solver, idx))
         continue;
@@ -526,6 +745,11 @@ static void eliminate_variables (kissat *solver) {
       break;
   }
 
+  if (threads > 1)
+    release_batch (solver, &batch);
+
+  STOP_PAYOFF (eliminate, eliminate_resolutions);
+
   const unsigned remain = kissat_size_heap (&solver->schedule);
   kissat_release_heap (solver, &solver->schedule);
 #ifndef QUIET
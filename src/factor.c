@@ -5,6 +5,7 @@
 #include "heap.h"
 #include "import.h"
 #include "inline.h"
+#include "inlinebuckets.h"
 #include "inlineheap.h"
 #include "inlinequeue.h"
 #include "inlinevector.h"
@@ -853,6 +854,7 @@ adjust_scores_and_phases_of_fresh_variables (factoring *factoring) {
            LOGVAR (idx));
       const double score = 0;
       kissat_update_heap (solver, &solver->scores, idx, score);
+      kissat_update_bucket (solver, &solver->buckets, idx, score);
     }
   }
   {
@@ -1068,6 +1070,8 @@ static void connect_clauses_to_factor (kissat *solver) {
 static bool kissat_factoring (kissat *solver) {
   if (!GET_OPTION (factor))
     return false;
+  if (GET_OPTION (incremental))
+    return false;
   if (!solver->active)
     return false;
   unsigned active = solver->active;
@@ -1105,7 +1109,7 @@ void kissat_factor (kissat *solver) {
                 "binary clause bounded variable addition");
   uint64_t limit = GET_OPTION (factoriniticks);
   if (s->factorizations > 1) {
-    SET_EFFORT_LIMIT (tmp, factor, factor_ticks);
+    SET_SCHEDULED_EFFORT_LIMIT (tmp, factor, factor_ticks);
     limit = tmp;
   } else {
     kissat_very_verbose (solver,
@@ -1152,5 +1156,6 @@ void kissat_factor (kissat *solver) {
 #endif
   if (completed)
     solver->limits.factor.marked = s->literals_factor;
+  STOP_PAYOFF (factor, factor_ticks);
   STOP (factor);
 }
@@ -755,6 +755,8 @@ static bool try_to_fast_eliminate (kissat *solver, unsigned pivot) {
   assert (!solver->inconsistent);
   if (!ACTIVE (pivot))
     return false;
+  if (FLAGS (pivot)->frozen)
+    return false;
   const unsigned lit = LIT (pivot);
   const unsigned not_lit = NOT (lit);
   const size_t fasteloccs = GET_OPTION (fasteloccs);
@@ -854,6 +856,8 @@ void kissat_fast_variable_elimination (kissat *solver) {
         continue;
       if (!pivot_flags->eliminate)
         continue;
+      if (pivot_flags->frozen)
+        continue;
       const unsigned lit = LIT (pivot);
       const size_t pos = flush_occurrences (solver, lit);
       if (pos > fasteloccs)
@@ -9,6 +9,10 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#ifdef KISSAT_HAS_MMAP
+#include <sys/mman.h>
+#endif
+
 bool kissat_file_exists (const char *path) {
   if (!path)
     return false;
@@ -123,12 +127,41 @@ bool kissat_find_executable (const char *name) {
   return res;
 }
 
+#ifdef KISSAT_HAS_DECOMPRESSION
+#define CLEAR_DECOMPRESSOR(FILE) \
+  do { \
+    (FILE)->decompressor = 0; \
+  } while (0)
+#else
+#define CLEAR_DECOMPRESSOR(FILE) \
+  do { \
+  } while (0)
+#endif
+
+#ifdef KISSAT_HAS_COMPRESSOR
+#define CLEAR_COMPRESSOR(FILE) \
+  do { \
+    (FILE)->compressor = 0; \
+  } while (0)
+#else
+#define CLEAR_COMPRESSOR(FILE) \
+  do { \
+  } while (0)
+#endif
+
+#define CLEAR_CODECS(FILE) \
+  do { \
+    CLEAR_DECOMPRESSOR (FILE); \
+    CLEAR_COMPRESSOR (FILE); \
+  } while (0)
+
 static int bz2sig[] = {0x42, 0x5A, 0x68, EOF};
 static int gzsig[] = {0x1F, 0x8B, EOF};
 static int lzmasig[] = {0x5D, 0x00, 0x00, 0x80, 0x00, EOF};
 static int sig7z[] = {0x37, 0x7A, 0xBC, 0xAF, 0x27, 0x1C, EOF};
 static int xzsig[] = {0xFD, 0x37, 0x7A, 0x58, 0x5A, 0x00, 0x00, EOF};
 static int Zsig[] = {0x1F, 0x9D, 0x90, EOF};
+static int zstdsig[] = {0x28, 0xB5, 0x2F, 0xFD, EOF};
 
 static bool match_signature (const char *path, const int *sig) {
   assert (path);
@@ -192,6 +225,7 @@ void kissat_read_already_open_file (file *file, FILE *f, const char *path) {
   file->compressed = false;
   file->path = path;
   file->bytes = 0;
+  CLEAR_CODECS (file);
 }
 
 void kissat_write_already_open_file (file *file, FILE *f,
@@ -202,11 +236,19 @@ void kissat_write_already_open_file (file *file, FILE *f,
   file->compressed = false;
   file->path = path;
   file->bytes = 0;
+  CLEAR_CODECS (file);
 }
 
 #ifndef KISSAT_HAS_COMPRESSION
 
 bool kissat_looks_like_a_compressed_file (const char *path) {
+#ifdef KISSAT_HAS_DECOMPRESSION
+  decompressor *decompressor = kissat_open_decompressor (path);
+  if (decompressor) {
+    kissat_close_decompressor (decompressor);
+    return false;
+  }
+#endif
 #define RETURN_TRUE_IF_COMPRESSED(SUFFIX, SIGNATURE) \
   if (kissat_has_suffix (path, SUFFIX) && \
       match_signature (path, SIGNATURE)) \
@@ -218,6 +260,7 @@ bool kissat_looks_like_a_compressed_file (const char *path) {
   RETURN_TRUE_IF_COMPRESSED (".7z", sig7z);
   RETURN_TRUE_IF_COMPRESSED (".xz", xzsig);
   RETURN_TRUE_IF_COMPRESSED (".Z", Zsig);
+  RETURN_TRUE_IF_COMPRESSED (".zst", zstdsig);
 
   return false;
 }
@@ -225,6 +268,19 @@ bool kissat_looks_like_a_compressed_file (const char *path) {
 #endif
 
 bool kissat_open_to_read_file (file *file, const char *path) {
+#ifdef KISSAT_HAS_DECOMPRESSION
+  file->decompressor = kissat_open_decompressor (path);
+  if (file->decompressor) {
+    file->file = kissat_decompressor_file (file->decompressor);
+    file->close = true;
+    file->reading = true;
+    file->compressed = true;
+    file->path = path;
+    file->bytes = 0;
+    CLEAR_COMPRESSOR (file);
+    return true;
+  }
+#endif
 #ifdef KISSAT_HAS_COMPRESSION
 #define READ_PIPE(SUFFIX, CMD, SIG) \
   do { \
@@ -237,6 +293,7 @@ bool kissat_open_to_read_file (file *file, const char *path) {
       file->compressed = true; \
       file->path = path; \
       file->bytes = 0; \
+      CLEAR_CODECS (file); \
       return true; \
     } \
   } while (0)
@@ -246,6 +303,7 @@ bool kissat_open_to_read_file (file *file, const char *path) {
   READ_PIPE (".7z", "7z x -so %s 2>/dev/null", sig7z);
   READ_PIPE (".xz", "xz -c -d %s", xzsig);
   READ_PIPE (".Z", "gzip -c -d %s", Zsig);
+  READ_PIPE (".zst", "zstd -c -d %s", zstdsig);
 #endif
   file->file = fopen (path, "r");
   if (!file->file)
@@ -255,11 +313,25 @@ bool kissat_open_to_read_file (file *file, const char *path) {
   file->compressed = false;
   file->path = path;
   file->bytes = 0;
+  CLEAR_CODECS (file);
 
   return true;
 }
 
 bool kissat_open_to_write_file (file *file, const char *path) {
+#ifdef KISSAT_HAS_COMPRESSOR
+  file->compressor = kissat_open_compressor (path);
+  if (file->compressor) {
+    file->file = kissat_compressor_file (file->compressor);
+    file->close = true;
+    file->reading = false;
+    file->compressed = true;
+    file->path = path;
+    file->bytes = 0;
+    CLEAR_DECOMPRESSOR (file);
+    return true;
+  }
+#endif
 #if defined(KISSAT_HAS_COMPRESSION) && !defined(SAFE)
 #define WRITE_PIPE(SUFFIX, CMD) \
   do { \
@@ -275,6 +347,7 @@ bool kissat_open_to_write_file (file *file, const char *path) {
       file->compressed = true; \
       file->path = path; \
       file->bytes = 0; \
+      CLEAR_CODECS (file); \
       return true; \
     } \
   } while (0)
@@ -292,12 +365,29 @@ bool kissat_open_to_write_file (file *file, const char *path) {
   file->compressed = false;
   file->path = path;
   file->bytes = 0;
+  CLEAR_CODECS (file);
   return true;
 }
 
 void kissat_close_file (file *file) {
   assert (file);
   assert (file->file);
+#ifdef KISSAT_HAS_DECOMPRESSION
+  if (file->decompressor) {
+    kissat_close_decompressor (file->decompressor);
+    file->decompressor = 0;
+    file->file = 0;
+    return;
+  }
+#endif
+#ifdef KISSAT_HAS_COMPRESSOR
+  if (file->compressor) {
+    kissat_close_compressor (file->compressor);
+    file->compressor = 0;
+    file->file = 0;
+    return;
+  }
+#endif
 #ifdef KISSAT_HAS_COMPRESSION
   if (file->close && file->compressed)
     pclose (file->file);
@@ -308,3 +398,40 @@ void kissat_close_file (file *file) {
     fclose (file->file);
   file->file = 0;
 }
+
+const unsigned char *kissat_map_file (file *file, size_t *size_ptr) {
+  assert (file);
+  assert (file->file);
+  assert (file->reading);
+#ifdef KISSAT_HAS_MMAP
+  if (!file->close || file->compressed || file->bytes)
+    return 0;
+  const int fd = fileno (file->file);
+  struct stat buf;
+  if (fstat (fd, &buf) || !S_ISREG (buf.st_mode) || !buf.st_size)
+    return 0;
+  const size_t size = buf.st_size;
+  void *res = mmap (0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (res == MAP_FAILED)
+    return 0;
+#ifdef MADV_SEQUENTIAL
+  (void) madvise (res, size, MADV_SEQUENTIAL);
+#endif
+  *size_ptr = size;
+  return res;
+#else
+  (void) file;
+  (void) size_ptr;
+  return 0;
+#endif
+}
+
+void kissat_unmap_file (const unsigned char *chars, size_t size) {
+#ifdef KISSAT_HAS_MMAP
+  munmap ((void *) chars, size);
+#else
+  (void) chars;
+  (void) size;
+  assert (!chars);
+#endif
+}
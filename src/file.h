@@ -7,6 +7,8 @@
 #include <stdio.h>
 
 #include "attribute.h"
+#include "compress.h"
+#include "decompress.h"
 #include "keatures.h"
 
 bool kissat_file_exists (const char *path);
@@ -24,6 +26,12 @@ struct file {
   bool compressed;
   const char *path;
   uint64_t bytes;
+#ifdef KISSAT_HAS_DECOMPRESSION
+  decompressor *decompressor;
+#endif
+#ifdef KISSAT_HAS_COMPRESSOR
+  compressor *compressor;
+#endif
 };
 
 void kissat_read_already_open_file (file *, FILE *, const char *path);
@@ -34,6 +42,12 @@ bool kissat_open_to_write_file (file *, const char *path);
 
 void kissat_close_file (file *);
 
+// Maps a regular uncompressed file opened for reading into memory and
+// returns zero if this is not possible (compressed, pipe or 'stdin').
+
+const unsigned char *kissat_map_file (file *, size_t *size_ptr);
+void kissat_unmap_file (const unsigned char *, size_t size);
+
 #ifndef KISSAT_HAS_COMPRESSION
 
 bool kissat_looks_like_a_compressed_file (const char *path);
@@ -60,10 +74,16 @@ static inline size_t kissat_read (file *file, void *ptr, size_t bytes) {
   assert (file);
   assert (file->file);
   assert (file->reading);
+  size_t res;
+#ifdef KISSAT_HAS_DECOMPRESSION
+  if (file->decompressor)
+    res = kissat_decompress (file->decompressor, ptr, bytes);
+  else
+#endif
 #ifdef KISSAT_HAS_UNLOCKEDIO
-  size_t res = fread_unlocked (ptr, 1, bytes, file->file);
+    res = fread_unlocked (ptr, 1, bytes, file->file);
 #else
-  size_t res = fread (ptr, 1, bytes, file->file);
+    res = fread (ptr, 1, bytes, file->file);
 #endif
   file->bytes += res;
   return res;
@@ -73,10 +93,16 @@ static inline size_t kissat_write (file *file, void *ptr, size_t bytes) {
   assert (file);
   assert (file->file);
   assert (!file->reading);
+  size_t res;
+#ifdef KISSAT_HAS_COMPRESSOR
+  if (file->compressor)
+    res = kissat_compress (file->compressor, ptr, bytes);
+  else
+#endif
 #ifdef KISSAT_HAS_UNLOCKEDIO
-  size_t res = fwrite_unlocked (ptr, 1, bytes, file->file);
+    res = fwrite_unlocked (ptr, 1, bytes, file->file);
 #else
-  size_t res = fwrite (ptr, 1, bytes, file->file);
+    res = fwrite (ptr, 1, bytes, file->file);
 #endif
   file->bytes += res;
   return res;
@@ -86,10 +112,17 @@ static inline int kissat_getc (file *file) {
   assert (file);
   assert (file->file);
   assert (file->reading);
+  int res;
+#ifdef KISSAT_HAS_DECOMPRESSION
+  unsigned char ch;
+  if (file->decompressor)
+    res = kissat_decompress (file->decompressor, &ch, 1) ? ch : EOF;
+  else
+#endif
 #ifdef KISSAT_HAS_UNLOCKEDIO
-  int res = getc_unlocked (file->file);
+    res = getc_unlocked (file->file);
 #else
-  int res = getc (file->file);
+    res = getc (file->file);
 #endif
   if (res != EOF)
     file->bytes++;
@@ -100,10 +133,17 @@ static inline int kissat_putc (file *file, int ch) {
   assert (file);
   assert (file->file);
   assert (!file->reading);
+  int res;
+#ifdef KISSAT_HAS_COMPRESSOR
+  unsigned char tmp = ch;
+  if (file->compressor)
+    res = kissat_compress (file->compressor, &tmp, 1) ? ch : EOF;
+  else
+#endif
 #ifdef KISSAT_HAS_UNLOCKEDIO
-  int res = putc_unlocked (ch, file->file);
+    res = putc_unlocked (ch, file->file);
 #else
-  int res = putc (ch, file->file);
+    res = putc (ch, file->file);
 #endif
   if (res != EOF)
     file->bytes++;
@@ -114,10 +154,15 @@ static inline void kissat_flush (file *file) {
   assert (file);
   assert (file->file);
   assert (!file->reading);
+#ifdef KISSAT_HAS_COMPRESSOR
+  if (file->compressor)
+    kissat_flush_compressor (file->compressor);
+  else
+#endif
 #ifdef KISSAT_HAS_UNLOCKEDIO
-  fflush_unlocked (file->file);
+    fflush_unlocked (file->file);
 #else
-  fflush (file->file);
+    fflush (file->file);
 #endif
 }
 
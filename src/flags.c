@@ -1,4 +1,5 @@
 #include "inline.h"
+#include "inlinebuckets.h"
 #include "inlineheap.h"
 #include "inlinequeue.h"
 
@@ -19,8 +20,12 @@ static inline void activate_literal (kissat *solver, unsigned lit) {
   kissat_update_heap (solver, &solver->scores, idx, score);
   if (solver->stable) {
     const unsigned lit = LIT (idx);
-    if (!VALUE (lit))
-      kissat_push_heap (solver, &solver->scores, idx);
+    if (!VALUE (lit)) {
+      if (solver->buckets.enabled)
+        kissat_push_bucket (solver, &solver->buckets, idx, score);
+      else
+        kissat_push_heap (solver, &solver->scores, idx);
+    }
   }
   assert (solver->unassigned < UINT_MAX);
   solver->unassigned++;
@@ -45,6 +50,9 @@ static inline void deactivate_variable (kissat *solver, flags *f,
   kissat_dequeue (solver, idx);
   if (kissat_heap_contains (SCORES, idx))
     kissat_pop_heap (solver, SCORES, idx);
+  scorebuckets *buckets = &solver->buckets;
+  if (buckets->enabled && kissat_bucket_contains (buckets, idx))
+    kissat_pop_bucket (solver, buckets, idx);
 }
 
 void kissat_activate_literal (kissat *solver, unsigned lit) {
@@ -3,38 +3,85 @@
 #include "internal.h"
 #include "logging.h"
 
+#include <stdint.h>
 #include <string.h>
 
+#ifdef QUATERNARY_HEAP
+
+#define HEAP_CACHE_LINE 64
+#define HEAP_PADDING (HEAP_CACHE_LINE / sizeof (heap_entry) - 1)
+
+static size_t bytes_heap_entries (size_t capacity) {
+  return (HEAP_PADDING + capacity) * sizeof (heap_entry) + HEAP_CACHE_LINE;
+}
+
+static void release_heap_entries (kissat *solver, heap *heap) {
+  if (!heap->entries)
+    return;
+  const size_t capacity = CAPACITY_STACK (heap->stack);
+  kissat_free (solver, heap->entries, bytes_heap_entries (capacity));
+  heap->entries = 0;
+}
+
+void kissat_enlarge_heap_entries (kissat *solver, heap *heap) {
+  const size_t size = SIZE_STACK (heap->stack);
+  const size_t old_capacity = CAPACITY_STACK (heap->stack);
+  const size_t new_capacity = old_capacity ? 2 * old_capacity : 4;
+  void *entries = kissat_malloc (solver, bytes_heap_entries (new_capacity));
+  uintptr_t line = (uintptr_t) entries + HEAP_CACHE_LINE - 1;
+  line &= ~(uintptr_t) (HEAP_CACHE_LINE - 1);
+  heap_entry *begin = (heap_entry *) line + HEAP_PADDING;
+  if (size)
+    memcpy (begin, heap->stack.begin, size * sizeof (heap_entry));
+  release_heap_entries (solver, heap);
+  heap->entries = entries;
+  heap->stack.begin = begin;
+  heap->stack.end = begin + size;
+  heap->stack.allocated = begin + new_capacity;
+  LOG ("enlarged heap entries from %zu to %zu", old_capacity,
+       new_capacity);
+}
+
+#endif
+
 void kissat_release_heap (kissat *solver, heap *heap) {
+#ifdef QUATERNARY_HEAP
+  release_heap_entries (solver, heap);
+#else
   RELEASE_STACK (heap->stack);
+#endif
   DEALLOC (heap->pos, heap->size);
   DEALLOC (heap->score, heap->size);
   memset (heap, 0, sizeof *heap);
 }
 
+void kissat_clear_heap (heap *heap) {
+  for (all_stack (heap_entry, entry, heap->stack))
+    heap->pos[HEAP_ENTRY_IDX (entry)] = DISCONTAIN;
+  CLEAR_STACK (heap->stack);
+}
+
 #ifndef NDEBUG
 
 void kissat_check_heap (heap *heap) {
-  const unsigned *const stack = BEGIN_STACK (heap->stack);
+  const heap_entry *const stack = BEGIN_STACK (heap->stack);
   const unsigned end = SIZE_STACK (heap->stack);
   const unsigned *const pos = heap->pos;
   const double *const score = heap->score;
   for (unsigned i = 0; i < end; i++) {
-    const unsigned idx = stack[i];
+    const unsigned idx = HEAP_ENTRY_IDX (stack[i]);
     const unsigned idx_pos = pos[idx];
     assert (idx_pos == i);
+#ifdef QUATERNARY_HEAP
+    assert (stack[i].score == score[idx]);
+#endif
     unsigned child_pos = HEAP_CHILD (idx_pos);
-    unsigned parent_pos = HEAP_PARENT (child_pos);
-    assert (parent_pos == idx_pos);
-    if (child_pos < end) {
-      unsigned child = stack[child_pos];
+    for (unsigned j = 0; j < HEAP_ARITY && child_pos < end;
+         j++, child_pos++) {
+      const unsigned parent_pos = HEAP_PARENT (child_pos);
+      assert (parent_pos == idx_pos);
+      const unsigned child = HEAP_ENTRY_IDX (stack[child_pos]);
       assert (score[idx] >= score[child]);
-      if (++child_pos < end) {
-        parent_pos = HEAP_PARENT (child_pos);
-        assert (parent_pos == idx_pos);
-        child = stack[child_pos];
-        assert (score[idx] >= score[child]);
-      }
     }
   }
 }
@@ -69,6 +116,11 @@ void kissat_rescale_heap (kissat *solver, heap *heap, double factor) {
   double *score = heap->score;
   for (unsigned i = 0; i < heap->vars; i++)
     score[i] *= factor;
+#ifdef QUATERNARY_HEAP
+  const heap_entry *const end = END_STACK (heap->stack);
+  for (heap_entry *p = BEGIN_STACK (heap->stack); p != end; p++)
+    p->score *= factor;
+#endif
 #ifndef NDEBUG
   kissat_check_heap (heap);
 #endif
@@ -96,7 +148,8 @@ void kissat_enlarge_heap (kissat *solver, heap *heap, unsigned new_vars) {
 
 static void dump_heap (heap *heap) {
   for (unsigned i = 0; i < SIZE_STACK (heap->stack); i++)
-    printf ("heap.stack[%u] = %u\n", i, PEEK_STACK (heap->stack, i));
+    printf ("heap.stack[%u] = %u\n", i,
+            HEAP_ENTRY_IDX (PEEK_STACK (heap->stack, i)));
   for (unsigned i = 0; i < heap->vars; i++)
     printf ("heap.pos[%u] = %u\n", i, heap->pos[i]);
   for (unsigned i = 0; i < heap->vars; i++)
@@ -11,13 +11,53 @@
 #define DISCONTAIN UINT_MAX
 #define DISCONTAINED(IDX) ((int) (IDX) < 0)
 
+// By default the heap is binary and its stack only holds variable
+// indices, while comparisons during bubbling up and down look up scores
+// in the separate 'score' array.  With '--quaternary-heap' it is 4-ary
+// instead and every entry carries a copy of the score of its variable.
+// The entries are then allocated separately with three padding entries in
+// front of the root and the first cache line boundary after them.  Thus
+// the four children of a node always fill exactly one 64 byte cache line
+// which is read to compare them, while the tree has half the depth (with
+// the root at the start of the stack the children straddle two cache lines
+// for three quarters of all nodes instead).  The 'score' array
+// remains the authoritative score of all (also not contained) variables.
+// Scores are kept as 'double' since EVSIDS scores are only rescaled
+// after exceeding 'MAX_SCORE' which is out of range for 'float'.
+
+#ifdef QUATERNARY_HEAP
+
+typedef struct heap_entry heap_entry;
+
+struct heap_entry {
+  double score;
+  unsigned idx;
+};
+
+#define HEAP_ENTRY_IDX(E) ((E).idx)
+
+#else
+
+typedef unsigned heap_entry;
+
+#define HEAP_ENTRY_IDX(E) (E)
+
+#endif
+
+// clang-format off
+typedef STACK (heap_entry) heap_entries;
+// clang-format on
+
 typedef struct heap heap;
 
 struct heap {
   bool tainted;
   unsigned vars;
   unsigned size;
-  unsigneds stack;
+  heap_entries stack;
+#ifdef QUATERNARY_HEAP
+  void *entries;
+#endif
   double *score;
   unsigned *pos;
 };
@@ -26,6 +66,7 @@ struct kissat;
 
 void kissat_resize_heap (struct kissat *, heap *, unsigned size);
 void kissat_release_heap (struct kissat *, heap *);
+void kissat_clear_heap (heap *);
 
 static inline bool kissat_heap_contains (heap *heap, unsigned idx) {
   return idx < heap->vars && !DISCONTAINED (heap->pos[idx]);
@@ -51,13 +92,17 @@ static inline size_t kissat_size_heap (heap *heap) {
 
 static inline unsigned kissat_max_heap (heap *heap) {
   assert (!kissat_empty_heap (heap));
-  return PEEK_STACK (heap->stack, 0);
+  return HEAP_ENTRY_IDX (PEEK_STACK (heap->stack, 0));
 }
 
 void kissat_rescale_heap (struct kissat *, heap *heap, double factor);
 
 void kissat_enlarge_heap (struct kissat *, heap *, unsigned new_vars);
 
+#ifdef QUATERNARY_HEAP
+void kissat_enlarge_heap_entries (struct kissat *, heap *);
+#endif
+
 static inline double kissat_max_score_on_heap (heap *heap) {
   if (!heap->tainted)
     return 0;
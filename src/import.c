@@ -35,6 +35,12 @@ static void adjust_exports_for_external_literal (kissat *solver,
     PUSH_STACK (solver->export, 0);
   POKE_STACK (solver->export, iidx, (int) eidx);
   LOG ("exporting internal variable %u as external literal %u", iidx, eidx);
+  if (eidx < SIZE_STACK (solver->frozen) &&
+      PEEK_STACK (solver->frozen, eidx)) {
+    LOG ("internal variable %u inherits frozen external variable %u", iidx,
+         eidx);
+    FLAGS (iidx)->frozen = true;
+  }
 }
 
 static inline unsigned import_literal (kissat *solver, int elit,
@@ -98,3 +104,27 @@ unsigned kissat_fresh_literal (kissat *solver) {
   kissat_activate_literal (solver, res);
   return res;
 }
+
+unsigned kissat_import_variable (kissat *solver, unsigned eidx,
+                                 bool extension) {
+  assert (VALID_EXTERNAL_LITERAL ((int) eidx));
+  adjust_imports_for_external_literal (solver, eidx);
+  const unsigned res = import_literal (solver, eidx, extension);
+  assert (res != INVALID_LIT);
+  kissat_activate_literal (solver, res);
+  return res;
+}
+
+void kissat_import_eliminated (kissat *solver, unsigned eidx,
+                               unsigned pos) {
+  assert (VALID_EXTERNAL_LITERAL ((int) eidx));
+  assert (pos < SIZE_STACK (solver->eliminated));
+  adjust_imports_for_external_literal (solver, eidx);
+  struct import *import = &PEEK_STACK (solver->import, eidx);
+  assert (!import->imported);
+  import->lit = pos;
+  import->imported = true;
+  import->eliminated = true;
+  LOG ("importing eliminated external variable %u as eliminated[%u]", eidx,
+       pos);
+}
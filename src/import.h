@@ -1,9 +1,20 @@
 #ifndef _import_h_INLCUDED
 #define _import_h_INLCUDED
 
+#include <stdbool.h>
+
 struct kissat;
 
 unsigned kissat_import_literal (struct kissat *solver, int lit);
 unsigned kissat_fresh_literal (struct kissat *solver);
 
+// Restore the import map of another solver or a snapshot variable by
+// variable.  Imported variables are activated.  Eliminated variables refer
+// to an already existing position on the 'eliminated' stack.
+
+unsigned kissat_import_variable (struct kissat *solver, unsigned eidx,
+                                 bool extension);
+void kissat_import_eliminated (struct kissat *solver, unsigned eidx,
+                               unsigned pos);
+
 #endif
@@ -0,0 +1,273 @@
+#include "incremental.h"
+#include "analyze.h"
+#include "backtrack.h"
+#include "decide.h"
+#include "import.h"
+#include "inline.h"
+#include "inlineframes.h"
+#include "print.h"
+#include "propsearch.h"
+#include "require.h"
+#include "sort.h"
+
+void kissat_prepare_incremental (kissat *solver) {
+  if (!EMPTY_STACK (solver->failed)) {
+    LOG ("resetting %zu failed assumptions", SIZE_STACK (solver->failed));
+    CLEAR_STACK (solver->failed);
+  }
+  if (!solver->level)
+    return;
+  LOG ("backtracking to root level to prepare for new input");
+  solver->extended = false;
+  kissat_backtrack_in_consistent_state (solver, 0);
+#ifndef NDEBUG
+  clause *conflict =
+#endif
+      kissat_search_propagate (solver);
+  assert (!conflict);
+}
+
+bool kissat_eliminated_external (kissat *solver, int elit) {
+  const unsigned eidx = ABS (elit);
+  if (eidx >= SIZE_STACK (solver->import))
+    return false;
+  const import *const import = &PEEK_STACK (solver->import, eidx);
+  kissat_require (!import->extension || !GET (searches),
+                  "variable %u used internally as extension variable "
+                  "(use option 'incremental' or reserve variables)",
+                  eidx);
+  return import->eliminated;
+}
+
+void kissat_restore_eliminated (kissat *solver) {
+  kissat_require (GET_OPTION (incremental),
+                  "can not restore eliminated variables "
+                  "(use option 'incremental' or freeze variables)");
+  kissat_require (!kissat_proving (solver),
+                  "can not restore eliminated variables while proving");
+  assert (!solver->level);
+  assert (EMPTY_STACK (solver->clause));
+
+  const size_t eliminated = SIZE_STACK (solver->eliminated);
+  kissat_extremely_verbose (solver,
+                            "restoring %zu eliminated variables "
+                            "from extension stack of size %zu",
+                            eliminated, SIZE_STACK (solver->extend));
+  ADD (restored, eliminated);
+
+  for (all_variables (idx))
+    if (FLAGS (idx)->eliminated)
+      POKE_STACK (solver->export, idx, 0);
+
+  import *const begin_import = BEGIN_STACK (solver->import);
+  const import *const end_import = END_STACK (solver->import);
+  for (import *import = begin_import; import != end_import; import++) {
+    if (!import->eliminated)
+      continue;
+    import->lit = 0;
+    import->imported = false;
+    import->eliminated = false;
+  }
+
+  CLEAR_STACK (solver->eliminated);
+  CLEAR_STACK (solver->etrail);
+  solver->extended = false;
+
+  extensions extend = solver->extend;
+  INIT_STACK (solver->extend);
+
+  bool empty = true;
+  for (all_stack (extension, ext, extend)) {
+    if (ext.blocking && !empty)
+      kissat_add (solver, 0);
+    kissat_add (solver, ext.lit);
+    empty = false;
+  }
+  if (!empty)
+    kissat_add (solver, 0);
+
+  RELEASE_STACK (extend);
+}
+
+bool kissat_assuming (kissat *solver) {
+  return solver->level < SIZE_STACK (solver->assumptions);
+}
+
+static unsigned assumption_literal (kissat *solver, int elit) {
+  const unsigned eidx = ABS (elit);
+  const import *const import = &PEEK_STACK (solver->import, eidx);
+  assert (import->imported);
+  assert (!import->eliminated);
+  unsigned ilit = import->lit;
+  if (elit < 0)
+    ilit = NOT (ilit);
+  return ilit;
+}
+
+static inline bool less_int (int a, int b) { return a < b; }
+
+static void analyze_reason_literal (kissat *solver, assigned *all_assigned,
+                                    unsigned lit) {
+  const unsigned idx = IDX (lit);
+  const assigned *const a = all_assigned + idx;
+  if (!a->level)
+    return;
+  if (a->analyzed)
+    return;
+  kissat_push_analyzed (solver, all_assigned, idx);
+}
+
+static void analyze_failed_assumption (kissat *solver, int elit,
+                                       unsigned ilit) {
+  assert (VALUE (ilit) < 0);
+  LOG ("analyzing failed assumption %s", LOGLIT (ilit));
+  INC (assumptions_failed);
+  ints *failed = &solver->failed;
+  assert (EMPTY_STACK (*failed));
+  PUSH_STACK (*failed, elit);
+  assigned *all_assigned = solver->assigned;
+  if (all_assigned[IDX (ilit)].level) {
+    assert (EMPTY_STACK (solver->analyzed));
+    kissat_push_analyzed (solver, all_assigned, IDX (ilit));
+    for (size_t i = 0; i < SIZE_STACK (solver->analyzed); i++) {
+      const unsigned idx = PEEK_STACK (solver->analyzed, i);
+      const assigned *const a = all_assigned + idx;
+      assert (a->level);
+      const unsigned pos = LIT (idx);
+      const unsigned lit = VALUE (pos) > 0 ? pos : NOT (pos);
+      if (a->reason == DECISION_REASON) {
+        LOG ("failed assumption %s", LOGLIT (lit));
+        PUSH_STACK (*failed, kissat_export_literal (solver, lit));
+      } else if (a->binary)
+        analyze_reason_literal (solver, all_assigned, a->reason);
+      else {
+        assert (a->reason != UNIT_REASON);
+        clause *reason = kissat_dereference_clause (solver, a->reason);
+        for (all_literals_in_clause (other, reason))
+          if (IDX (other) != idx)
+            analyze_reason_literal (solver, all_assigned, other);
+      }
+    }
+    kissat_reset_only_analyzed_literals (solver);
+  }
+  SORT_STACK (int, *failed, less_int);
+  LOGINTS (SIZE_STACK (*failed), BEGIN_STACK (*failed),
+           "failed assumptions");
+}
+
+int kissat_decide_assumption (kissat *solver) {
+  assert (kissat_assuming (solver));
+  const int elit = PEEK_STACK (solver->assumptions, solver->level);
+  const unsigned ilit = assumption_literal (solver, elit);
+  const value value = VALUE (ilit);
+  if (value < 0) {
+    analyze_failed_assumption (solver, elit, ilit);
+    return 20;
+  }
+  if (value > 0) {
+    LOG ("assumption %s already satisfied", LOGLIT (ilit));
+    solver->level++;
+    kissat_push_frame (solver, ilit);
+  } else
+    kissat_internal_assume (solver, ilit);
+  return 0;
+}
+
+static void freeze_variable (kissat *solver, unsigned eidx) {
+  while (eidx >= SIZE_STACK (solver->frozen))
+    PUSH_STACK (solver->frozen, 0);
+  unsigned *count = BEGIN_STACK (solver->frozen) + eidx;
+  kissat_require (*count < UINT_MAX, "variable %u frozen too often", eidx);
+  if ((*count)++)
+    return;
+  LOG ("freezing external variable %u", eidx);
+  if (kissat_eliminated_external (solver, eidx))
+    kissat_restore_eliminated (solver);
+  else if (eidx < SIZE_STACK (solver->import)) {
+    const import *const import = &PEEK_STACK (solver->import, eidx);
+    if (import->imported)
+      FLAGS (IDX (import->lit))->frozen = true;
+  }
+}
+
+static void melt_variable (kissat *solver, unsigned eidx) {
+  unsigned *count = BEGIN_STACK (solver->frozen) + eidx;
+  assert (*count);
+  if (--*count)
+    return;
+  LOG ("melting external variable %u", eidx);
+  if (eidx >= SIZE_STACK (solver->import))
+    return;
+  const import *const import = &PEEK_STACK (solver->import, eidx);
+  if (import->imported && !import->eliminated)
+    FLAGS (IDX (import->lit))->frozen = false;
+}
+
+void kissat_reset_assumptions (kissat *solver) {
+  if (EMPTY_STACK (solver->assumptions))
+    return;
+  LOG ("resetting %zu assumptions", SIZE_STACK (solver->assumptions));
+  for (all_stack (int, elit, solver->assumptions))
+    melt_variable (solver, ABS (elit));
+  CLEAR_STACK (solver->assumptions);
+}
+
+void kissat_assume (kissat *solver, int elit) {
+  kissat_require_initialized (solver);
+  kissat_require_valid_external_internal (elit);
+  kissat_require (elit, "invalid zero assumption");
+  kissat_require (EMPTY_STACK (solver->clause),
+                  "incomplete clause (terminating zero not added)");
+  kissat_prepare_incremental (solver);
+  freeze_variable (solver, ABS (elit));
+  const unsigned ilit = kissat_import_literal (solver, elit);
+  assert (ilit != INVALID_LIT);
+  if (!kissat_fixed (solver, ilit))
+    kissat_activate_literal (solver, ilit);
+  LOG ("assuming external literal %d (internal %s)", elit, LOGLIT (ilit));
+  PUSH_STACK (solver->assumptions, elit);
+}
+
+int kissat_failed (kissat *solver, int elit) {
+  kissat_require_initialized (solver);
+  kissat_require_valid_external_internal (elit);
+  const int *l = BEGIN_STACK (solver->failed);
+  const int *r = END_STACK (solver->failed);
+  while (l < r) {
+    const int *m = l + (r - l) / 2;
+    if (*m < elit)
+      l = m + 1;
+    else if (elit < *m)
+      r = m;
+    else
+      return 1;
+  }
+  return 0;
+}
+
+void kissat_freeze (kissat *solver, int elit) {
+  kissat_require_initialized (solver);
+  kissat_require_valid_external_internal (elit);
+  kissat_require (elit, "invalid zero literal");
+  kissat_require (EMPTY_STACK (solver->clause),
+                  "incomplete clause (terminating zero not added)");
+  kissat_prepare_incremental (solver);
+  freeze_variable (solver, ABS (elit));
+}
+
+void kissat_melt (kissat *solver, int elit) {
+  kissat_require_initialized (solver);
+  kissat_require_valid_external_internal (elit);
+  kissat_require (kissat_frozen (solver, elit), "literal %d not frozen",
+                  elit);
+  melt_variable (solver, ABS (elit));
+}
+
+int kissat_frozen (kissat *solver, int elit) {
+  kissat_require_initialized (solver);
+  kissat_require_valid_external_internal (elit);
+  const unsigned eidx = ABS (elit);
+  if (eidx >= SIZE_STACK (solver->frozen))
+    return 0;
+  return PEEK_STACK (solver->frozen, eidx) > 0;
+}
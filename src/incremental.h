@@ -0,0 +1,27 @@
+#ifndef _incremental_h_INCLUDED
+#define _incremental_h_INCLUDED
+
+#include <stdbool.h>
+
+// Incremental solving through the IPASIR interface.  Clauses, learned
+// clauses, scores and phases are kept between calls to 'kissat_solve'.
+// Assumptions are decided in order on the first decision levels and a
+// falsified assumption is analyzed to determine the failed assumptions.
+// Frozen variables are neither eliminated nor substituted.  If an
+// eliminated variable is used again all eliminated variables are restored
+// from the extension stack, which requires the 'incremental' option as
+// otherwise eliminated clauses are not saved completely.  For the same
+// reason extension variables are not introduced in incremental mode and
+// users can not refer to extension variables introduced before.
+
+struct kissat;
+
+void kissat_prepare_incremental (struct kissat *);
+bool kissat_eliminated_external (struct kissat *, int elit);
+void kissat_restore_eliminated (struct kissat *);
+
+bool kissat_assuming (struct kissat *);
+int kissat_decide_assumption (struct kissat *);
+void kissat_reset_assumptions (struct kissat *);
+
+#endif
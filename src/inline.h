@@ -72,11 +72,28 @@ kissat_push_large_watch (kissat *solver, watches *watches, reference ref) {
   PUSH_WATCHES (*watches, watch);
 }
 
+// With '--packed-watches' binary watches are kept in front of the watches
+// of large clauses while watching.  Then propagation scans binary watches
+// in one dense run without moving them (see 'PROPAGATE_LITERAL').  Large
+// watches are two words with the binary bit of both cleared and are moved
+// up by one word to make room for the new binary watch.
+
 static inline void kissat_push_binary_watch (kissat *solver,
                                              watches *watches,
                                              unsigned other) {
   const watch watch = kissat_binary_watch (other);
   PUSH_WATCHES (*watches, watch);
+#ifdef PACKED_WATCHES
+  if (!solver->watching)
+    return;
+  union watch *const begin = BEGIN_WATCHES (*watches);
+  union watch *p = END_WATCHES (*watches) - 1;
+  while (p != begin && !p[-1].type.binary) {
+    *p = p[-1];
+    p--;
+  }
+  *p = watch;
+#endif
 }
 
 static inline void kissat_push_blocking_watch (kissat *solver,
@@ -38,6 +38,7 @@ static inline void kissat_assign (kissat *solver, const bool probing,
     solver->unflushed++;
     if (reason != UNIT_REASON) {
       CHECK_AND_ADD_UNIT (lit);
+      CHAIN_UNIT_IN_PROOF (lit, binary, reason);
       ADD_UNIT_TO_PROOF (lit);
       reason = UNIT_REASON;
       binary = false;
@@ -0,0 +1,118 @@
+#ifndef _inlinebuckets_h_INCLUDED
+#define _inlinebuckets_h_INCLUDED
+
+#include "internal.h"
+#include "logging.h"
+
+static inline void kissat_mark_nonempty_bucket (scorebuckets *buckets,
+                                                unsigned bucket) {
+  const unsigned word = bucket >> 6;
+  buckets->nonempty[word] |= (uint64_t) 1 << (bucket & 63);
+  buckets->summary[word >> 6] |= (uint64_t) 1 << (word & 63);
+}
+
+static inline void kissat_mark_empty_bucket (scorebuckets *buckets,
+                                             unsigned bucket) {
+  const unsigned word = bucket >> 6;
+  uint64_t *p = buckets->nonempty + word;
+  *p &= ~((uint64_t) 1 << (bucket & 63));
+  if (!*p)
+    buckets->summary[word >> 6] &= ~((uint64_t) 1 << (word & 63));
+}
+
+static inline void kissat_link_bucket (scorebuckets *buckets,
+                                       unsigned idx, unsigned bucket) {
+  bucket_link *const links = buckets->links;
+  bucket_link *const l = links + idx;
+  const unsigned next = buckets->first[bucket];
+  l->prev = BUCKET_END;
+  l->next = next;
+  l->bucket = bucket;
+  if (next == BUCKET_END)
+    kissat_mark_nonempty_bucket (buckets, bucket);
+  else
+    links[next].prev = idx;
+  buckets->first[bucket] = idx;
+}
+
+static inline void kissat_unlink_bucket (scorebuckets *buckets,
+                                         unsigned idx) {
+  bucket_link *const links = buckets->links;
+  bucket_link *const l = links + idx;
+  const unsigned prev = l->prev, next = l->next, bucket = l->bucket;
+  if (prev == BUCKET_END) {
+    assert (buckets->first[bucket] == idx);
+    buckets->first[bucket] = next;
+    if (next == BUCKET_END)
+      kissat_mark_empty_bucket (buckets, bucket);
+  } else
+    links[prev].next = next;
+  if (next != BUCKET_END)
+    links[next].prev = prev;
+  l->bucket = UNBUCKETED;
+}
+
+static inline void kissat_push_bucket (kissat *solver,
+                                       scorebuckets *buckets, unsigned idx,
+                                       double score) {
+  assert (!kissat_bucket_contains (buckets, idx));
+  const unsigned bucket = kissat_score_bucket (score);
+  LOG ("push %s with score %g to bucket %u", LOGVAR (idx), score, bucket);
+  kissat_link_bucket (buckets, idx, bucket);
+#ifndef LOGGING
+  (void) solver;
+#endif
+}
+
+static inline void kissat_pop_bucket (kissat *solver,
+                                      scorebuckets *buckets, unsigned idx) {
+  assert (kissat_bucket_contains (buckets, idx));
+  LOG ("pop %s from bucket %u", LOGVAR (idx), buckets->links[idx].bucket);
+  kissat_unlink_bucket (buckets, idx);
+#ifndef LOGGING
+  (void) solver;
+#endif
+}
+
+// Contained variables with a changed score are moved to the front of
+// their (possibly new) bucket, which gives recently bumped variables
+// precedence over others with almost the same score.
+
+static inline void kissat_update_bucket (kissat *solver,
+                                         scorebuckets *buckets,
+                                         unsigned idx, double new_score) {
+  if (!buckets->enabled)
+    return;
+  if (!kissat_bucket_contains (buckets, idx))
+    return;
+  const unsigned bucket = kissat_score_bucket (new_score);
+  if (buckets->first[bucket] == idx)
+    return;
+  LOG ("update %s with score %g to bucket %u", LOGVAR (idx), new_score,
+       bucket);
+  kissat_unlink_bucket (buckets, idx);
+  kissat_link_bucket (buckets, idx, bucket);
+#ifndef LOGGING
+  (void) solver;
+#endif
+}
+
+static inline unsigned kissat_max_bucket (const scorebuckets *buckets) {
+  unsigned i = BUCKET_SUMMARY_WORDS;
+  while (i--) {
+    const uint64_t summary = buckets->summary[i];
+    if (!summary)
+      continue;
+    const unsigned word = 64 * i + kissat_log2_floor_of_uint64 (summary);
+    const uint64_t nonempty = buckets->nonempty[word];
+    assert (nonempty);
+    const unsigned bucket =
+        64 * word + kissat_log2_floor_of_uint64 (nonempty);
+    const unsigned res = buckets->first[bucket];
+    assert (res != BUCKET_END);
+    return res;
+  }
+  return BUCKET_END;
+}
+
+#endif
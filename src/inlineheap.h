@@ -5,6 +5,88 @@
 #include "internal.h"
 #include "logging.h"
 
+#ifdef QUATERNARY_HEAP
+
+#define HEAP_ARITY 4
+
+// Since the root is preceded by three padding entries on a cache line (see
+// 'kissat_enlarge_heap_entries'), the 16 byte entries of the children
+// '4 * POS + 1' to '4 * POS + 4' of all nodes start at a cache line.
+
+#define HEAP_CHILD(POS) (assert ((POS) < (1u << 30)), (4 * (POS) + 1))
+
+#define HEAP_PARENT(POS) (assert ((POS) > 0), (((POS) - 1) / 4))
+
+static inline void kissat_bubble_up (kissat *solver, heap *heap,
+                                     unsigned idx) {
+  heap_entry *stack = BEGIN_STACK (heap->stack);
+  unsigned *pos = heap->pos;
+  unsigned idx_pos = pos[idx];
+  const heap_entry entry = stack[idx_pos];
+  assert (entry.idx == idx);
+  const double idx_score = entry.score;
+  while (idx_pos) {
+    const unsigned parent_pos = HEAP_PARENT (idx_pos);
+    const heap_entry parent = stack[parent_pos];
+    if (parent.score >= idx_score)
+      break;
+    LOG ("heap bubble up: %u@%u = %g swapped with %u@%u = %g", parent.idx,
+         parent_pos, parent.score, idx, idx_pos, idx_score);
+    stack[idx_pos] = parent;
+    pos[parent.idx] = idx_pos;
+    idx_pos = parent_pos;
+  }
+  stack[idx_pos] = entry;
+  pos[idx] = idx_pos;
+#ifndef LOGGING
+  (void) solver;
+#endif
+}
+
+static inline void kissat_bubble_down (kissat *solver, heap *heap,
+                                       unsigned idx) {
+  heap_entry *stack = BEGIN_STACK (heap->stack);
+  const unsigned end = SIZE_STACK (heap->stack);
+  unsigned *pos = heap->pos;
+  unsigned idx_pos = pos[idx];
+  const heap_entry entry = stack[idx_pos];
+  assert (entry.idx == idx);
+  const double idx_score = entry.score;
+  for (;;) {
+    const unsigned first_pos = HEAP_CHILD (idx_pos);
+    if (first_pos >= end)
+      break;
+    const unsigned last_pos = MIN (first_pos + HEAP_ARITY, end);
+    unsigned child_pos = first_pos;
+    double child_score = stack[first_pos].score;
+    for (unsigned sibling_pos = first_pos + 1; sibling_pos < last_pos;
+         sibling_pos++) {
+      const double sibling_score = stack[sibling_pos].score;
+      if (sibling_score > child_score) {
+        child_pos = sibling_pos;
+        child_score = sibling_score;
+      }
+    }
+    if (child_score <= idx_score)
+      break;
+    const heap_entry child = stack[child_pos];
+    LOG ("heap bubble down: %u@%u = %g swapped with %u@%u = %g", child.idx,
+         child_pos, child_score, idx, idx_pos, idx_score);
+    stack[idx_pos] = child;
+    pos[child.idx] = idx_pos;
+    idx_pos = child_pos;
+  }
+  stack[idx_pos] = entry;
+  pos[idx] = idx_pos;
+#ifndef LOGGING
+  (void) solver;
+#endif
+}
+
+#else
+
+#define HEAP_ARITY 2
+
 #define HEAP_CHILD(POS) (assert ((POS) < (1u << 31)), (2 * (POS) + 1))
 
 #define HEAP_PARENT(POS) (assert ((POS) > 0), (((POS) - 1) / 2))
@@ -73,6 +155,8 @@ static inline void kissat_bubble_down (kissat *solver, heap *heap,
 #endif
 }
 
+#endif
+
 #define HEAP_IMPORT(IDX) \
   do { \
     assert ((IDX) < UINT_MAX - 1); \
@@ -88,7 +172,14 @@ static inline void kissat_push_heap (kissat *solver, heap *heap,
   assert (!kissat_heap_contains (heap, idx));
   HEAP_IMPORT (idx);
   heap->pos[idx] = SIZE_STACK (heap->stack);
+#ifdef QUATERNARY_HEAP
+  if (FULL_STACK (heap->stack))
+    kissat_enlarge_heap_entries (solver, heap);
+  const heap_entry entry = {.score = heap->score[idx], .idx = idx};
+  PUSH_STACK (heap->stack, entry);
+#else
   PUSH_STACK (heap->stack, idx);
+#endif
   kissat_bubble_up (solver, heap, idx);
 }
 
@@ -96,13 +187,14 @@ static inline void kissat_pop_heap (kissat *solver, heap *heap,
                                     unsigned idx) {
   LOG ("pop heap %u", idx);
   assert (kissat_heap_contains (heap, idx));
-  const unsigned last = POP_STACK (heap->stack);
+  const heap_entry last_entry = POP_STACK (heap->stack);
+  const unsigned last = HEAP_ENTRY_IDX (last_entry);
   heap->pos[last] = DISCONTAIN;
   if (last == idx)
     return;
   const unsigned idx_pos = heap->pos[idx];
   heap->pos[idx] = DISCONTAIN;
-  POKE_STACK (heap->stack, idx_pos, last);
+  POKE_STACK (heap->stack, idx_pos, last_entry);
   heap->pos[last] = idx_pos;
   kissat_bubble_up (solver, heap, last);
   kissat_bubble_down (solver, heap, last);
@@ -113,18 +205,19 @@ static inline void kissat_pop_heap (kissat *solver, heap *heap,
 
 static inline unsigned kissat_pop_max_heap (kissat *solver, heap *heap) {
   assert (!EMPTY_STACK (heap->stack));
-  unsigneds *stack = &heap->stack;
-  unsigned *const begin = BEGIN_STACK (*stack);
-  const unsigned idx = *begin;
+  heap_entries *stack = &heap->stack;
+  heap_entry *const begin = BEGIN_STACK (*stack);
+  const unsigned idx = HEAP_ENTRY_IDX (*begin);
   assert (!heap->pos[idx]);
   LOG ("pop max heap %u", idx);
-  const unsigned last = POP_STACK (*stack);
+  const heap_entry last_entry = POP_STACK (*stack);
+  const unsigned last = HEAP_ENTRY_IDX (last_entry);
   unsigned *const pos = heap->pos;
   pos[last] = DISCONTAIN;
   if (last == idx)
     return idx;
   pos[idx] = DISCONTAIN;
-  *begin = last;
+  *begin = last_entry;
   pos[last] = 0;
   kissat_bubble_down (solver, heap, last);
 #ifdef CHECK_HEAP
@@ -164,6 +257,9 @@ static inline void kissat_update_heap (kissat *solver, heap *heap,
   }
   if (!kissat_heap_contains (heap, idx))
     return;
+#ifdef QUATERNARY_HEAP
+  PEEK_STACK (heap->stack, heap->pos[idx]).score = new_score;
+#endif
   if (new_score > old_score)
     kissat_bubble_up (solver, heap, idx);
   else
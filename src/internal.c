@@ -3,6 +3,7 @@
 #include "binindex.h"
 #include "error.h"
 #include "import.h"
+#include "incremental.h"
 #include "inline.h"
 #include "inlineframes.h"
 #include "print.h"
@@ -44,14 +45,6 @@ kissat *kissat_init (void) {
   solver->last_irredundant = INVALID_REF;
   kissat_reset_last_learned (solver);
   
-  // Initialize decision cache (Optimization #4)
-  solver->decision_cache_size = 0;
-  solver->decision_cache_hits = 0;
-  solver->decision_cache_misses = 0;
-  solver->decision_cache_valid = false;
-  for (unsigned i = 0; i < DECISION_CACHE_SIZE; i++)
-    solver->decision_cache[i] = INVALID_IDX;
-  
   // Initialize binary implication index (will be built before search)
   solver->bin_index = NULL;
   
@@ -92,7 +85,9 @@ void kissat_set_prefix (kissat *solver, const char *prefix) {
 
 void kissat_release (kissat *solver) {
   kissat_require_initialized (solver);
+  kissat_release_pool (solver);
   kissat_release_heap (solver, SCORES);
+  kissat_release_buckets (solver, &solver->buckets);
   kissat_release_heap (solver, &solver->schedule);
   kissat_release_vectors (solver);
   kissat_release_phases (solver);
@@ -114,6 +109,11 @@ void kissat_release (kissat *solver) {
   RELEASE_STACK (solver->witness);
   RELEASE_STACK (solver->etrail);
 
+  RELEASE_STACK (solver->assumptions);
+  RELEASE_STACK (solver->failed);
+  RELEASE_STACK (solver->frozen);
+  RELEASE_STACK (solver->learner.clause);
+
   RELEASE_STACK (solver->delayed);
 
   RELEASE_STACK (solver->clause);
@@ -123,12 +123,14 @@ void kissat_release (kissat *solver) {
 #endif
 
   RELEASE_STACK (solver->arena);
+  kissat_release_recycled_clauses (solver);
 
   RELEASE_STACK (solver->units);
   RELEASE_STACK (solver->frames);
   RELEASE_STACK (solver->sorter);
 
   RELEASE_ARRAY (solver->trail, solver->size);
+  kissat_release_saved_trail (solver);
 
   RELEASE_STACK (solver->analyzed);
   RELEASE_STACK (solver->levels);
@@ -153,6 +155,9 @@ void kissat_release (kissat *solver) {
   // Release binary implication index
   kissat_release_bin_index (solver);
 
+  kissat_dealloc (solver, solver->vivify_activity,
+                  solver->vivify_activity_size, sizeof (double));
+
 #if !defined(NDEBUG) || !defined(NPROOFS)
   RELEASE_STACK (solver->added);
   RELEASE_STACK (solver->removed);
@@ -280,9 +285,93 @@ void kissat_print_statistics (kissat *solver) {
   (void) solver;
 }
 
+static void add_internal_literal (kissat *solver, unsigned ilit,
+                                  int elit) {
+#ifndef LOGGING
+  (void) elit;
+#endif
+  const mark mark = MARK (ilit);
+  if (!mark) {
+    const value value = kissat_fixed (solver, ilit);
+    if (value > 0) {
+      if (!solver->clause_satisfied) {
+        LOG ("adding root level satisfied literal %u(%d)@0=1", ilit,
+             elit);
+        solver->clause_satisfied = true;
+      }
+    } else if (value < 0) {
+      LOG ("adding root level falsified literal %u(%d)@0=-1", ilit, elit);
+      if (!solver->clause_shrink) {
+        solver->clause_shrink = true;
+        LOG ("thus original clause needs shrinking");
+      }
+    } else {
+      MARK (ilit) = 1;
+      MARK (NOT (ilit)) = -1;
+      assert (SIZE_STACK (solver->clause) < UINT_MAX);
+      PUSH_STACK (solver->clause, ilit);
+    }
+  } else if (mark < 0) {
+    assert (mark < 0);
+    if (!solver->clause_trivial) {
+      LOG ("adding dual literal %u(%d) and %u(%d)", NOT (ilit), -elit,
+           ilit, elit);
+      solver->clause_trivial = true;
+    }
+  } else {
+    assert (mark > 0);
+    LOG ("adding duplicated literal %u(%d)", ilit, elit);
+    if (!solver->clause_shrink) {
+      solver->clause_shrink = true;
+      LOG ("thus original clause needs shrinking");
+    }
+  }
+}
+
+// Restoring eliminated variables adds clauses, thus the partially added
+// current clause has to be saved and added again afterwards.
+
+static void restore_eliminated_while_adding (kissat *solver) {
+  unsigneds partial;
+  INIT_STACK (partial);
+  for (all_stack (unsigned, lit, solver->clause)) {
+    MARK (lit) = MARK (NOT (lit)) = 0;
+    PUSH_STACK (partial, lit);
+  }
+  CLEAR_STACK (solver->clause);
+  const bool satisfied = solver->clause_satisfied;
+  const bool trivial = solver->clause_trivial;
+  const bool shrink = solver->clause_shrink;
+  solver->clause_satisfied = false;
+  solver->clause_trivial = false;
+  solver->clause_shrink = false;
+#if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
+  ints original;
+  INIT_STACK (original);
+  const size_t offset = solver->offset_of_last_original_clause;
+  const int *const begin_original = BEGIN_STACK (solver->original);
+  const int *const end_original = END_STACK (solver->original);
+  for (const int *p = begin_original + offset; p != end_original; p++)
+    PUSH_STACK (original, *p);
+  RESIZE_STACK (solver->original, offset);
+#endif
+  kissat_restore_eliminated (solver);
+#if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
+  for (all_stack (int, elit, original))
+    PUSH_STACK (solver->original, elit);
+  RELEASE_STACK (original);
+#endif
+  solver->clause_satisfied = satisfied;
+  solver->clause_trivial = trivial;
+  solver->clause_shrink = shrink;
+  for (all_stack (unsigned, ilit, partial))
+    add_internal_literal (solver, ilit, kissat_export_literal (solver, ilit));
+  RELEASE_STACK (partial);
+}
+
 void kissat_add (kissat *solver, int elit) {
   kissat_require_initialized (solver);
-  kissat_require (!GET (searches), "incremental solving not supported");
+  kissat_prepare_incremental (solver);
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
   const int checking = kissat_checking (solver);
   const bool logging = kissat_logging (solver);
@@ -290,48 +379,14 @@ void kissat_add (kissat *solver, int elit) {
 #endif
   if (elit) {
     kissat_require_valid_external_internal (elit);
+    if (kissat_eliminated_external (solver, elit))
+      restore_eliminated_while_adding (solver);
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
     if (checking || logging || proving)
       PUSH_STACK (solver->original, elit);
 #endif
     unsigned ilit = kissat_import_literal (solver, elit);
-
-    const mark mark = MARK (ilit);
-    if (!mark) {
-      const value value = kissat_fixed (solver, ilit);
-      if (value > 0) {
-        if (!solver->clause_satisfied) {
-          LOG ("adding root level satisfied literal %u(%d)@0=1", ilit,
-               elit);
-          solver->clause_satisfied = true;
-        }
-      } else if (value < 0) {
-        LOG ("adding root level falsified literal %u(%d)@0=-1", ilit, elit);
-        if (!solver->clause_shrink) {
-          solver->clause_shrink = true;
-          LOG ("thus original clause needs shrinking");
-        }
-      } else {
-        MARK (ilit) = 1;
-        MARK (NOT (ilit)) = -1;
-        assert (SIZE_STACK (solver->clause) < UINT_MAX);
-        PUSH_STACK (solver->clause, ilit);
-      }
-    } else if (mark < 0) {
-      assert (mark < 0);
-      if (!solver->clause_trivial) {
-        LOG ("adding dual literal %u(%d) and %u(%d)", NOT (ilit), -elit,
-             ilit, elit);
-        solver->clause_trivial = true;
-      }
-    } else {
-      assert (mark > 0);
-      LOG ("adding duplicated literal %u(%d)", ilit, elit);
-      if (!solver->clause_shrink) {
-        solver->clause_shrink = true;
-        LOG ("thus original clause needs shrinking");
-      }
-    }
+    add_internal_literal (solver, ilit, elit);
   } else {
 #if !defined(NDEBUG) || !defined(NPROOFS) || defined(LOGGING)
     const size_t offset = solver->offset_of_last_original_clause;
@@ -340,6 +395,10 @@ void kissat_add (kissat *solver, int elit) {
     assert (esize <= UINT_MAX);
 #endif
     ADD_UNCHECKED_EXTERNAL (esize, elits);
+#ifndef NPROOFS
+    if (proving)
+      kissat_add_original_to_proof (solver, esize, elits);
+#endif
     const size_t isize = SIZE_STACK (solver->clause);
     unsigned *ilits = BEGIN_STACK (solver->clause);
     assert (isize < (unsigned) INT_MAX);
@@ -493,8 +552,10 @@ int kissat_solve (kissat *solver) {
   kissat_require_initialized (solver);
   kissat_require (EMPTY_STACK (solver->clause),
                   "incomplete clause (terminating zero not added)");
-  kissat_require (!GET (searches), "incremental solving not supported");
-  return kissat_search (solver);
+  kissat_prepare_incremental (solver);
+  const int res = kissat_search (solver);
+  kissat_reset_assumptions (solver);
+  return res;
 }
 
 void kissat_terminate (kissat *solver) {
@@ -510,6 +571,28 @@ void kissat_set_terminate (kissat *solver, void *state,
   solver->termination.terminate = terminate;
 }
 
+void kissat_set_learn (kissat *solver, void *state, int max_length,
+                       void (*learn) (void *, int *)) {
+  kissat_require_initialized (solver);
+  kissat_require (max_length >= 0, "negative maximum length '%d'",
+                  max_length);
+  learner *learner = &solver->learner;
+  learner->state = state;
+  learner->max_length = (unsigned) max_length;
+  learner->units = 0;
+  learner->learn = learn;
+}
+
+void kissat_set_import (kissat *solver, void *state,
+                        const int *(*import) (void *, int *)) {
+  kissat_require_initialized (solver);
+  kissat_require (!import || !kissat_proving (solver),
+                  "can not import clauses while tracing or checking proofs");
+  importer *importer = &solver->importer;
+  importer->state = state;
+  importer->import = import;
+}
+
 int kissat_value (kissat *solver, int elit) {
   kissat_require_initialized (solver);
   kissat_require_valid_external_internal (elit);
@@ -5,6 +5,7 @@
 #include "array.h"
 #include "assign.h"
 #include "averages.h"
+#include "buckets.h"
 #include "check.h"
 #include "classify.h"
 #include "clause.h"
@@ -19,16 +20,20 @@
 #include "literal.h"
 #include "mode.h"
 #include "options.h"
+#include "parallel.h"
+#include "payoff.h"
 #include "phases.h"
 #include "profile.h"
 #include "proof.h"
 #include "queue.h"
 #include "random.h"
+#include "recycle.h"
 #include "reluctant.h"
 #include "rephase.h"
 #include "smooth.h"
 #include "stack.h"
 #include "statistics.h"
+#include "trailsave.h"
 #include "value.h"
 #include "vector.h"
 #include "watch.h"
@@ -65,6 +70,22 @@ struct termination {
   int (*volatile terminate) (void *);
 };
 
+typedef struct learner learner;
+typedef struct importer importer;
+
+struct learner {
+  void *state;
+  unsigned max_length;
+  size_t units;
+  ints clause;
+  void (*learn) (void *, int *);
+};
+
+struct importer {
+  void *state;
+  const int *(*import) (void *, int *);
+};
+
 // clang-format off
 
 typedef STACK (value) eliminated;
@@ -87,6 +108,7 @@ struct kissat {
   bool extended;
   bool inconsistent;
   bool iterating;
+  bool preprocessed;
   bool preprocessing;
   bool probing;
 #ifndef QUIET
@@ -103,6 +125,10 @@ struct kissat {
   bool large_clauses_watched_after_binary_clauses;
 
   termination termination;
+  learner learner;
+  importer importer;
+
+  const char *snapshot;
 
   unsigned vars;
   unsigned size;
@@ -115,6 +141,10 @@ struct kissat {
   extensions extend;
   unsigneds witness;
 
+  ints assumptions;
+  ints failed;
+  unsigneds frozen;
+
   assigned *assigned;
   flags *flags;
 
@@ -130,6 +160,7 @@ struct kissat {
   queue queue;
 
   heap scores;
+  scorebuckets buckets;
   double scinc;
 
   heap schedule;
@@ -140,6 +171,7 @@ struct kissat {
 
   unsigned_array trail;
   unsigned *propagate;
+  saved_trail saved_trail;
 
   unsigned best_assigned;
   unsigned target_assigned;
@@ -177,6 +209,8 @@ struct kissat {
   vectors vectors;
   reference first_reducible;
   reference last_irredundant;
+  recycler recycler;
+  pool *pool;
   watches *watches;
 
   reference last_learned[4];
@@ -194,7 +228,9 @@ struct kissat {
   enabled enabled;
   limited limited;
   limits limits;
+  payoffs payoffs;
   remember last;
+  unsigned pressure;
   unsigned walked;
 
   mode mode;
@@ -245,19 +281,19 @@ struct kissat {
   proof *proof;
 #endif
 
-  // Variable Decision Cache (Optimization #4)
-  // Cache top-N decision candidates to avoid expensive heap traversals
-#define DECISION_CACHE_SIZE 64  // Optimal: 64 entries gives best performance
-  unsigned decision_cache[DECISION_CACHE_SIZE];  // Cached variable indices
-  unsigned decision_cache_size;                   // Current cache entries
-  unsigned decision_cache_hits;                   // Statistics
-  unsigned decision_cache_misses;                 // Statistics
-  bool decision_cache_valid;                      // Cache validity flag
-
   // Binary Implication Index (Optimization #6)
   // Flat array storage for O(1) access to binary clause implications
   bin_impl_list *bin_index;
 
+  // Conflict activity of clauses indexed by arena reference, used to
+  // select vivification candidates (see 'vivify.c').
+  double *vivify_activity;
+  unsigned vivify_activity_size;
+
+  // Connection to the shared clause pool in portfolio mode (see
+  // 'share.c' and 'portfolio.c') and 'NULL' otherwise.
+  struct sharer *sharer;
+
   statistics statistics;
 };
 
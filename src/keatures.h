@@ -9,6 +9,7 @@
 #define KISSAT_HAS_COMPRESSION
 #define KISSAT_HAS_COLORS
 #define KISSAT_HAS_FILENO
+#define KISSAT_HAS_MMAP
 #endif
 
 #if defined(_POSIX_C_SOURCE)
@@ -45,7 +45,7 @@ struct limits {
 
   struct {
     uint64_t conflicts;
-  } probe, randec, reduce, reorder, rephase, restart;
+  } memory, probe, randec, reduce, reorder, rephase, restart, share;
 
   struct {
     uint64_t conflicts;
@@ -85,6 +85,9 @@ struct remember {
   struct {
     uint64_t reduce;
   } conflicts;
+  struct {
+    uint64_t reduce;
+  } arena;
   struct {
     uint64_t start_conflicts;       // conflicts when current reduce started
     uint64_t prev_start_conflicts;  // conflicts when previous reduce started
@@ -141,6 +144,9 @@ double kissat_logn (uint64_t);
 #include <inttypes.h>
 
 #define SET_EFFORT_LIMIT(LIMIT, NAME, START) \
+  SET_SCALED_EFFORT_LIMIT (LIMIT, NAME, START, 1)
+
+#define SET_SCALED_EFFORT_LIMIT(LIMIT, NAME, START, SCALE) \
   uint64_t LIMIT; \
   do { \
     const uint64_t OLD_LIMIT = solver->statistics.START; \
@@ -160,7 +166,8 @@ double kissat_logn (uint64_t);
           FORMAT_COUNT (REFERENCE), FORMAT_COUNT (TICKS), \
           FORMAT_COUNT (LAST)); \
     } \
-    const double EFFORT = (double) GET_OPTION (NAME##effort) * 1e-3; \
+    const double EFFORT = \
+        (double) GET_OPTION (NAME##effort) * 1e-3 * (SCALE); \
     const uint64_t DELTA = EFFORT * REFERENCE; \
 \
     kissat_extremely_verbose ( \
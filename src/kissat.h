@@ -3,17 +3,42 @@
 
 typedef struct kissat kissat;
 
-// Default (partial) IPASIR interface.
+// Default IPASIR interface.
 
 const char *kissat_signature (void);
 kissat *kissat_init (void);
 void kissat_add (kissat *solver, int lit);
+void kissat_assume (kissat *solver, int lit);
 int kissat_solve (kissat *solver);
 int kissat_value (kissat *solver, int lit);
+int kissat_failed (kissat *solver, int lit);
 void kissat_release (kissat *solver);
 
 void kissat_set_terminate (kissat *solver, void *state,
                            int (*terminate) (void *state));
+void kissat_set_learn (kissat *solver, void *state, int max_length,
+                       void (*learn) (void *state, int *clause));
+
+// Frozen variables are kept by variable elimination and substitution.
+// Assumptions are frozen implicitly until the next call to 'kissat_solve'
+// returns.  Using a variable which was eliminated before again requires
+// the 'incremental' option to be set, which should be done before adding
+// clauses (alternatively freeze variables to be used later).
+
+void kissat_freeze (kissat *solver, int lit);
+void kissat_melt (kissat *solver, int lit);
+int kissat_frozen (kissat *solver, int lit);
+
+// Clauses learned by other solvers are pulled through the 'import'
+// callback at restart points.  It returns a zero terminated clause and
+// sets its glue or returns 'NULL' if there are no more clauses.  The
+// clauses have to be implied by the formula and are added as redundant.
+// As they can not be justified importing is not allowed with proofs.
+// The maximum glue of clauses passed to the 'learn' callback is set with
+// the 'learnglue' option.
+
+void kissat_set_import (kissat *solver, void *state,
+                        const int *(*import) (void *state, int *glue));
 
 // Additional API functions.
 
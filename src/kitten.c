@@ -116,7 +116,22 @@ static inline void *kitten_calloc (size_t n, size_t size) {
 #include "internal.h"  // Also use 'kissat' statistics if embedded.
 #include "terminate.h" // For macros defining termination macro.
 
-#define KITTEN_TICKS (solver->statistics.kitten_ticks)
+// Embedded statistics counters and termination checks go through the
+// 'statistics' and 'parent' fields, which differ from 'solver' for
+// detached kittens (see 'kitten_detached' below).
+
+#undef INC
+#undef ADD
+#undef TERMINATED
+
+#define INC(NAME) kissat_inc_##NAME (kitten->statistics)
+#define ADD(NAME, DELTA) kissat_add_##NAME (kitten->statistics, (DELTA))
+
+#define TERMINATED(BIT) \
+  kissat_terminated (kitten->parent, BIT, #BIT, __FILE__, __LINE__, \
+                     __func__)
+
+#define KITTEN_TICKS (kitten->statistics->kitten_ticks)
 
 /*------------------------------------------------------------------------*/
 #endif // STAND_ALONE_KITTEN
@@ -207,6 +222,8 @@ struct kitten {
 #ifndef STAND_ALONE_KITTEN
   struct kissat *kissat;
 #define solver (kitten->kissat)
+  struct kissat *parent;
+  statistics *statistics;
 #endif
 
   // First zero initialized field in 'clear_kitten' is 'status'.
@@ -352,7 +369,7 @@ static inline unsigned reference_klause (kitten *kitten, const klause *c) {
 #ifdef STAND_ALONE_KITTEN
 #define logging (kitten->logging)
 #else
-#define logging GET_OPTION (log)
+#define logging (solver && GET_OPTION (log))
 #endif
 
 static void log_basic (kitten *, const char *, ...)
@@ -669,6 +686,27 @@ kitten *kitten_embedded (struct kissat *kissat) {
   kitten = &dummy;
   CALLOC (kitten, 1);
   kitten->kissat = kissat;
+  kitten->parent = kissat;
+  kitten->statistics = &kissat->statistics;
+  initialize_kitten (kitten);
+  return kitten;
+}
+
+kitten *kitten_detached (struct kissat *kissat,
+                         struct statistics *statistics) {
+  if (!kissat)
+    INVALID_API_USAGE ("'kissat' argument zero");
+  if (!statistics)
+    INVALID_API_USAGE ("'statistics' argument zero");
+
+  kitten *kitten;
+  struct kitten dummy;
+  dummy.kissat = 0;
+  kitten = &dummy;
+  CALLOC (kitten, 1);
+  kitten->kissat = 0;
+  kitten->parent = kissat;
+  kitten->statistics = statistics;
   initialize_kitten (kitten);
   return kitten;
 }
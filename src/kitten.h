@@ -51,4 +51,12 @@ void kitten_traverse_core_clauses (kitten *, void *state,
 struct kissat;
 kitten *kitten_embedded (struct kissat *);
 
+// A detached kitten can run on a helper thread concurrently to other
+// detached kittens of the same solver.  It only reads the termination flag
+// of the solver, does not account its memory, and updates the given
+// statistics instead of those of the solver.
+
+struct statistics;
+kitten *kitten_detached (struct kissat *, struct statistics *);
+
 #endif
@@ -2,6 +2,7 @@
 #include "backtrack.h"
 #include "inline.h"
 #include "reluctant.h"
+#include "share.h"
 
 #include <inttypes.h>
 
@@ -209,6 +210,8 @@ void kissat_learn_clause (kissat *solver) {
   
   if (!solver->probing)
     kissat_update_learned (solver, glue, size);
+  if (solver->sharer || solver->learner.learn)
+    kissat_export_learned_clause (solver, glue);
   assert (size > 0);
   reference ref = INVALID_REF;
   if (size == 1)
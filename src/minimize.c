@@ -1,6 +1,5 @@
 #include "minimize.h"
 #include "inline.h"
-#include "simdscan.h"
 
 static inline int minimized_index (kissat *solver, bool minimizing,
                                    assigned *a, unsigned lit, unsigned idx,
@@ -30,12 +29,17 @@ static inline int minimized_index (kissat *solver, bool minimizing,
     LOG2 ("can not remove poisoned literal %s", LOGLIT (lit));
     return -1;
   }
+  const unsigned level = a->level;
+  frame *frame = &FRAME (level);
   if (minimizing || !depth) {
-    frame *frame = &FRAME (a->level);
     if (frame->used <= 1) {
       LOG2 ("can not remove singleton frame literal %s", LOGLIT (lit));
       return -1;
     }
+  } else if (!frame->used) {
+    LOG2 ("can not remove literal %s on level %u not in clause",
+          LOGLIT (lit), level);
+    return -1;
   }
   return 0;
 }
@@ -153,48 +157,23 @@ void kissat_reset_poisoned (kissat *solver) {
   CLEAR_STACK (solver->poisoned);
 }
 
-/*
- * Fast-path for binary-reason literals
- * 
- * If a literal's reason is binary and the other literal in that reason
- * is also in the learned clause, then this literal is redundant.
- * Uses SIMD-accelerated membership test for large clauses.
- */
+// All literals of the learned clause are marked removable before
+// minimizing it.  Thus a literal with a binary reason is redundant if the
+// other literal of its reason is marked removable, which is checked
+// before trying recursive minimization.
+
 static bool fast_binary_minimize_check (kissat *solver, assigned *assigned,
-                                        unsigned lit, unsigned *lits, 
-                                        unsigned size) {
+                                        unsigned lit) {
+#ifdef NDEBUG
+  (void) solver;
+#endif
   const unsigned idx = IDX (lit);
   struct assigned *a = assigned + idx;
-  
-  // Only for binary reasons
-  if (!a->binary) return false;
-  if (a->reason == DECISION_REASON) return false;
-  if (!a->level) return true;  // Root level - can always remove
-  
+  if (!a->binary)
+    return false;
+  assert (a->level);
   const unsigned other = a->reason;
-  const unsigned other_idx = IDX (other);
-  
-  // For larger clauses, use SIMD-accelerated search
-  // This checks if other_idx appears in the clause's literal indices
-  if (size >= 8 && size <= 256) {
-    // Use stack buffer for small/medium clauses
-    unsigned idx_array[256];
-    for (unsigned i = 0; i < size; i++)
-      idx_array[i] = IDX (lits[i]);
-    
-    size_t pos = kissat_simd_find_literal_idx (other_idx, idx_array, size);
-    
-    if (pos < size)
-      return true;  // Other literal is in clause, so this one is redundant
-  }
-  
-  // Scalar fallback for small clauses or allocation failure
-  for (unsigned i = 0; i < size; i++) {
-    if (IDX (lits[i]) == other_idx)
-      return true;  // Other literal is in clause, so this one is redundant
-  }
-  
-  return false;
+  return assigned[IDX (other)].removable;
 }
 
 void kissat_minimize_clause (kissat *solver) {
@@ -207,7 +186,6 @@ void kissat_minimize_clause (kissat *solver) {
 
   unsigned *lits = BEGIN_STACK (solver->clause);
   unsigned *end = END_STACK (solver->clause);
-  unsigned size = end - lits;
 
   assigned *assigned = solver->assigned;
 #ifndef NDEBUG
@@ -232,7 +210,7 @@ void kissat_minimize_clause (kissat *solver) {
 #endif
     
     // Fast check for binary-redundant literals
-    if (fast_binary_minimize_check (solver, assigned, lit, lits, size)) {
+    if (fast_binary_minimize_check (solver, assigned, lit)) {
       LOG ("fast-minimized literal %s (binary reason)", LOGLIT (lit));
       *p = INVALID_LIT;
       minimized++;
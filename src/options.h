@@ -12,7 +12,9 @@
   OPTION (backboneeffort, 20, 0, 1e5, "effort in per mille") \
   OPTION (backbonemaxrounds, 1e3, 1, INT_MAX, "maximum backbone rounds") \
   OPTION (backbonerounds, 100, 1, INT_MAX, "backbone rounds limit") \
+  OPTION (backbonethreads, 1, 1, 64, "parallel backbone probing threads") \
   OPTION (bigbigfraction, 990, 0, 1000, "big binary clause fraction per mille") \
+  OPTION (buckets, 0, 0, 1, "bucketed score queue for stable decisions") \
   OPTION (bump, 1, 0, 1, "enable variable bumping") \
   OPTION (bumpreasons, 1, 0, 1, "bump reason side literals too") \
   OPTION (bumpreasonslimit, 10, 1, INT_MAX, "relative reason literals limit") \
@@ -28,6 +30,7 @@
   OPTION (congruencebinaries, 1, 0, 1, "extract certain binary clauses") \
   OPTION (congruenceites, 1, 0, 1, "extract ITE gates for congruence closure") \
   OPTION (congruenceonce, 0, 0, 1, "congruence closure only initially") \
+  OPTION (congruencethreads, 1, 1, 64, "AND gate extraction threads") \
   OPTION (congruencexorarity, 4, 2, 20, "congruence XOR gate arity limit") \
   OPTION (congruencexorcounts, 2, 1, INT_MAX, "XOR counting rounds") \
   OPTION (congruencexors, 1, 0, 1, "extract XOR gates for congruence closure") \
@@ -46,6 +49,7 @@
   OPTION (eliminateint, 500, 10, INT_MAX, "base elimination interval") \
   OPTION (eliminateocclim, 2e3, 0, INT_MAX, "elimination occurrence limit") \
   OPTION (eliminaterounds, 2, 1, 1e4, "elimination rounds limit") \
+  OPTION (eliminatethreads, 1, 1, 64, "parallel elimination threads") \
   OPTION (emafast, 33, 10, 1e6, "fast exponential moving average window") \
   OPTION (emaslow, 1e5, 100, 1e6, "slow exponential moving average window") \
   EMBOPT (embedded, 1, 0, 1, "parse and apply embedded options") \
@@ -70,13 +74,18 @@
   OPTION (forcephase, 0, 0, 1, "force initial phase") \
   OPTION (forward, 1, 0, 1, "forward subsumption in BVE") \
   OPTION (forwardeffort, 100, 0, 1e6, "effort in per mille") \
+  OPTION (frat, 0, 0, 1, "FRAT proof with clause identifiers and hints") \
   OPTION (ifthenelse, 1, 0, 1, "extract and eliminate if-then-else gates") \
   OPTION (incremental, 0, 0, 1, "enable incremental solving") \
   OPTION (jumpreasons, 1, 0, 1, "jump binary reasons") \
+  OPTION (learnglue, 0, 0, INT_MAX, "learn callback glue limit (0=unlimited)") \
   LOGOPT (log, 0, 0, 5, "logging level (1=on,2=more,3=check,4/5=mem)") \
   OPTION (lucky, 1, 0, 1, "try some lucky assignments") \
   OPTION (luckyearly, 1, 0, 1, "lucky assignments before preprocessing") \
   OPTION (luckylate, 1, 0, 1, "lucky assignments after preprocessing") \
+  OPTION (memoryint, 1e3, 1, 1e6, "memory usage check interval") \
+  OPTION (memorylimit, 0, 0, INT_MAX, "memory limit in MB (0=unlimited)") \
+  OPTION (memorysoft, 80, 10, 100, "memory pressure in percent of limit") \
   OPTION (mineffort, 10, 0, INT_MAX, "minimum absolute effort in millions") \
   OPTION (minimize, 1, 0, 1, "learned clause minimization") \
   OPTION (minimizedepth, 1e3, 1, 1e6, "minimization depth") \
@@ -84,6 +93,10 @@
   OPTION (modeinit, 1e3, 10, 1e8, "initial focused conflicts limit") \
   OPTION (modeint, 1e3, 10, 1e8, "focused conflicts interval") \
   OPTION (otfs, 1, 0, 1, "on-the-fly strengthening") \
+  OPTION (parsethreads, 1, 1, 64, "parallel DIMACS parsing threads") \
+  OPTION (payoff, 0, 0, 1, "payoff driven simplification efforts") \
+  OPTION (payoffmax, 8, 1, 1e3, "maximum payoff effort scale") \
+  OPTION (payoffwindow, 4, 2, 1e3, "payoff rate average window") \
   OPTION (phase, 1, 0, 1, "initial decision phase") \
   OPTION (phasesaving, 1, 0, 1, "enable phase saving") \
   OPTION (preprocess, 1, 0, 1, "initial preprocessing") \
@@ -99,6 +112,8 @@
   OPTION (proberounds, 2, 1, INT_MAX, "probing rounds") \
   NQTOPT (profile, 2, 0, 4, "profile level") \
   OPTION (promote, 1, 0, 1, "promote clauses") \
+  OPTION (proofcheck, 0, 0, 1, "check proof in background thread") \
+  OPTION (proofthread, 1, 0, 1, "write proof in background thread") \
   NQTOPT (quiet, 0, 0, 1, "disable all messages") \
   OPTION (randec, 1, 0, 1, "random decisions") \
   OPTION (randecfocused, 1, 0, 1, "random decisions in focused mode") \
@@ -106,6 +121,8 @@
   OPTION (randecint, 500, 0, INT_MAX, "initial random decisions interval") \
   OPTION (randeclength, 10, 1, INT_MAX, "random conflicts length") \
   OPTION (randecstable, 0, 0, 1, "random decisions in stable mode") \
+  OPTION (recycle, 0, 0, 1, "recycle garbage clause slots after reduce") \
+  OPTION (recycleint, 4, 1, 1e3, "full arena collection interval") \
   OPTION (reduce, 1, 0, 1, "learned clause reduction") \
   OPTION (reduceadaptive, 1, 0, 1, "adaptive reduce intervals based on efficiency") \
   OPTION (reducefactor, 100, 50, 200, "adaptive reduce scaling factor (%)") \
@@ -129,6 +146,10 @@
   OPTION (restartmargin, 10, 0, 25, "fast/slow margin in percent") \
   OPTION (restartreusetrail, 1, 0, 1, "restarts tries to reuse trail") \
   OPTION (seed, 0, 0, INT_MAX, "random seed") \
+  OPTION (share, 1, 0, 1, "share clauses in portfolio mode") \
+  OPTION (shareglue, 2, 1, 100, "maximum glue of shared clauses") \
+  OPTION (shareint, 500, 1, 1e5, "interval of importing shared clauses") \
+  OPTION (sharesize, 8, 2, 64, "maximum size of shared clauses") \
   OPTION (shrink, 3, 0, 3, "learned clauses (1=bin,2=lrg,3=rec)") \
   OPTION (simplify, 1, 0, 1, "enable probing and elimination") \
   OPTION (smallclauses, 1e5, 0, INT_MAX, "small clauses limit") \
@@ -149,12 +170,14 @@
   OPTION (sweepmaxdepth, 3, 1, INT_MAX, "maximum environment depth") \
   OPTION (sweepmaxvars, 8192, 2, INT_MAX, "maximum environment variables") \
   OPTION (sweeprand, 0, 0, 1, "randomize sweeping environment") \
+  OPTION (sweepthreads, 1, 1, 64, "parallel sweeping threads") \
   OPTION (sweepvars, 256, 0, INT_MAX, "environment variables") \
   OPTION (target, TARGET_DEFAULT, 0, 2, "target phases (1=stable,2=focused)") \
   OPTION (tier1, 2, 1, 100, "learned clause tier one glue limit") \
   OPTION (tier1relative, 500, 0, 1000, "relative tier one glue limit") \
   OPTION (tier2, 6, 1, 1e3, "learned clause tier two glue limit") \
   OPTION (tier2relative, 900, 0, 1000, "relative tier two glue limit") \
+  OPTION (trailsave, 0, 0, 2, "save trail (1=replay,2=skip restart)") \
   OPTION (transitive, 1, 0, 1, "transitive reduction of binary clauses") \
   OPTION (transitiveeffort, 20, 0, 2e3, "effort in per mille") \
   OPTION (transitivekeep, 1, 0, 1, "keep transitivity candidates") \
@@ -166,11 +189,13 @@
   OPTION (vivifyfocusedtiers, 1, 0, 1, "use focused tier limits") \
   OPTION (vivifyirr, 3, 0, 100, "relative irredundant effort") \
   OPTION (vivifysort, 1, 0, 1, "sort vivification candidates") \
+  OPTION (vivifythreads, 1, 1, 64, "parallel vivification threads") \
   OPTION (vivifytier1, 3, 0, 100, "relative tier1 effort") \
   OPTION (vivifytier2, 3, 0, 100, "relative tier2 effort") \
   OPTION (vivifytier3, 1, 0, 100, "relative tier3 effort") \
   OPTION (walkeffort, 50, 0, 1e6, "effort in per mille") \
   OPTION (walkinitially, 0, 0, 1, "initial local search") \
+  OPTION (walkthreads, 1, 1, 64, "parallel local search walkers") \
   OPTION (warmup, 1, 0, 1, "initialize phases by unit propagation")
 
 // clang-format on
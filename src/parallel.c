@@ -0,0 +1,165 @@
+#include "parallel.h"
+#include "allocate.h"
+#include "internal.h"
+#include "logging.h"
+#include "print.h"
+
+#include <assert.h>
+#include <pthread.h>
+
+typedef struct parallel parallel;
+typedef struct helper helper;
+
+struct parallel {
+  parallel_function function;
+  void *state;
+  unsigned tasks;
+  unsigned next;
+};
+
+struct helper {
+  pool *pool;
+  pthread_t thread;
+  uint64_t round;
+  unsigned id;
+};
+
+// The helper threads of a pool are started lazily by the first parallel
+// loop needing them and then wait on 'start' for the next round until the
+// pool is released.  In each round only the helpers with an identifier
+// below 'threads' take part and 'running' counts those still busy.
+
+struct pool {
+  pthread_mutex_t lock;
+  pthread_cond_t start;
+  pthread_cond_t done;
+  parallel *parallel;
+  uint64_t round;
+  unsigned threads;
+  unsigned running;
+  unsigned helpers;
+  bool failed;
+  bool stop;
+  helper helper[MAX_PARALLEL_THREADS];
+};
+
+static void run_tasks (parallel *parallel, unsigned thread) {
+  for (;;) {
+    const unsigned task =
+        __atomic_fetch_add (&parallel->next, 1, __ATOMIC_RELAXED);
+    if (task >= parallel->tasks)
+      break;
+    parallel->function (parallel->state, task, thread);
+  }
+}
+
+static void *run_helper (void *ptr) {
+  helper *helper = ptr;
+  pool *pool = helper->pool;
+  const unsigned id = helper->id;
+  uint64_t round = helper->round;
+  pthread_mutex_lock (&pool->lock);
+  for (;;) {
+    while (!pool->stop && pool->round == round)
+      pthread_cond_wait (&pool->start, &pool->lock);
+    if (pool->stop)
+      break;
+    round = pool->round;
+    if (id >= pool->threads)
+      continue;
+    parallel *parallel = pool->parallel;
+    pthread_mutex_unlock (&pool->lock);
+    run_tasks (parallel, id);
+    pthread_mutex_lock (&pool->lock);
+    assert (pool->running);
+    if (!--pool->running)
+      pthread_cond_signal (&pool->done);
+  }
+  pthread_mutex_unlock (&pool->lock);
+  return 0;
+}
+
+static pool *new_pool (kissat *solver) {
+  pool *pool = kissat_calloc (solver, 1, sizeof (struct pool));
+  pthread_mutex_init (&pool->lock, 0);
+  pthread_cond_init (&pool->start, 0);
+  pthread_cond_init (&pool->done, 0);
+  pool->helpers = 1;
+  return pool;
+}
+
+static unsigned start_helpers (kissat *solver, pool *pool,
+                               unsigned threads) {
+  if (pool->failed)
+    return MIN (threads, pool->helpers);
+  while (pool->helpers < threads) {
+    const unsigned id = pool->helpers;
+    helper *helper = pool->helper + id;
+    helper->pool = pool;
+    helper->round = pool->round;
+    helper->id = id;
+    if (pthread_create (&helper->thread, 0, run_helper, helper)) {
+      kissat_warning (solver,
+                      "failed to start parallel helper thread %u "
+                      "(continuing with %u thread%s)",
+                      id, id, id > 1 ? "s" : "");
+      pool->failed = true;
+      return id;
+    }
+    LOG ("started parallel helper thread %u", id);
+    pool->helpers++;
+  }
+  return threads;
+}
+
+void kissat_parallel_for (kissat *solver, unsigned threads, unsigned tasks,
+                          parallel_function function, void *state) {
+  if (threads > tasks)
+    threads = tasks;
+  if (threads > MAX_PARALLEL_THREADS)
+    threads = MAX_PARALLEL_THREADS;
+  parallel parallel = {function, state, tasks, 0};
+  if (threads > 1) {
+    if (!solver->pool)
+      solver->pool = new_pool (solver);
+    threads = start_helpers (solver, solver->pool, threads);
+  }
+  if (threads < 2) {
+    run_tasks (&parallel, 0);
+    return;
+  }
+  pool *pool = solver->pool;
+  pthread_mutex_lock (&pool->lock);
+  assert (!pool->running);
+  pool->parallel = &parallel;
+  pool->threads = threads;
+  pool->running = threads - 1;
+  pool->round++;
+  pthread_cond_broadcast (&pool->start);
+  pthread_mutex_unlock (&pool->lock);
+  run_tasks (&parallel, 0);
+  pthread_mutex_lock (&pool->lock);
+  while (pool->running)
+    pthread_cond_wait (&pool->done, &pool->lock);
+  pool->parallel = 0;
+  pthread_mutex_unlock (&pool->lock);
+  assert (parallel.next >= tasks);
+}
+
+void kissat_release_pool (kissat *solver) {
+  pool *pool = solver->pool;
+  if (!pool)
+    return;
+  pthread_mutex_lock (&pool->lock);
+  pool->stop = true;
+  pthread_cond_broadcast (&pool->start);
+  pthread_mutex_unlock (&pool->lock);
+  for (unsigned id = 1; id != pool->helpers; id++)
+    pthread_join (pool->helper[id].thread, 0);
+  LOG ("stopped %u parallel helper threads", pool->helpers - 1);
+  pthread_cond_destroy (&pool->done);
+  pthread_cond_destroy (&pool->start);
+  pthread_mutex_destroy (&pool->lock);
+  kissat_free (solver, pool, sizeof (struct pool));
+  solver->pool = 0;
+}
@@ -0,0 +1,31 @@
+#ifndef _parallel_h_INCLUDED
+#define _parallel_h_INCLUDED
+
+// Minimal fork-join helper for parallel inprocessing.  It calls
+// 'function (state, task, thread)' for all 'tasks' on at most 'threads'
+// threads (including the calling thread) and returns after all tasks are
+// completed.  Tasks are handed out dynamically, so results must only
+// depend on the task and never on the thread executing it.  The helper
+// threads are kept in a pool of the solver and reused by later loops.  If
+// a helper thread can not be started the loop continues with the threads
+// already available (in the worst case only the calling thread).
+//
+// Callers therefore store the results of each task separately and merge
+// them after the loop on the calling thread in task order.  Then neither
+// the solver state nor the proof depend on the number of threads or on
+// how tasks were scheduled, i.e., runs stay deterministic.
+
+#define MAX_PARALLEL_THREADS 64
+
+typedef struct pool pool;
+
+typedef void (*parallel_function) (void *state, unsigned task,
+                                   unsigned thread);
+
+struct kissat;
+
+void kissat_parallel_for (struct kissat *, unsigned threads, unsigned tasks,
+                          parallel_function, void *state);
+void kissat_release_pool (struct kissat *);
+
+#endif
@@ -1,25 +1,36 @@
 #include "parse.h"
 #include "collect.h"
 #include "internal.h"
+#include "parallel.h"
 #include "print.h"
 #include "profile.h"
 #include "resize.h"
 
 #include <ctype.h>
 #include <inttypes.h>
+#include <string.h>
 
 #define size_buffer (1u << 20)
 
+// If the input file can be mapped into memory, then 'chars' points to the
+// whole mapped file and it is parsed without copying.  Otherwise 'chars'
+// points to 'storage' which is refilled by reading from the file.
+
 struct read_buffer {
-  unsigned char chars[size_buffer];
+  const unsigned char *chars;
   size_t pos, end;
+  bool mapped;
+  unsigned char storage[size_buffer];
 };
 
 typedef struct read_buffer read_buffer;
 
 static size_t fill_buffer (read_buffer *buffer, file *file) {
+  if (buffer->mapped)
+    return 0;
   buffer->pos = 0;
-  buffer->end = kissat_read (file, buffer->chars, size_buffer);
+  buffer->chars = buffer->storage;
+  buffer->end = kissat_read (file, buffer->storage, size_buffer);
   return buffer->end;
 }
 
@@ -43,7 +54,7 @@ next (read_buffer * buffer, file * file, uint64_t * lineno_ptr)
   return ch;
 }
 
-#define NEXT() next (&buffer, file, &lineno)
+#define NEXT() next (buffer, file, &lineno)
 
 #define NONL(STR) \
 do { \
@@ -66,12 +77,200 @@ faster_is_digit (int ch)
 
 #define ISDIGIT(CH) faster_is_digit (CH)
 
+// clang-format on
+
+// Parallel parsing of the clauses of a memory mapped file.  The remaining
+// input is split into chunks at line boundaries, which are tokenized
+// concurrently into per-chunk literal buffers.  Those are then added in
+// the original order.  Chunks only accept plain clauses and comments.
+// Anything else (carriage-returns, invalid characters, too many clauses,
+// end-of-file corner cases, etc.) stops parallel parsing at the start of
+// the first such chunk, and the rest of the file is parsed sequentially,
+// which gives exactly the same error messages and line numbers.
+
+#define size_chunk (1u << 24)
+#define min_size_chunk (1u << 12)
+
+typedef struct chunk chunk;
+typedef struct chunks chunks;
+
+struct chunk {
+  const unsigned char *begin, *end;
+  uint64_t lines;
+  uint64_t clauses;
+  bool last;
+  bool failed;
+  ints lits;
+};
+
+struct chunks {
+  chunk *chunks;
+  unsigned threads;
+  strictness strict;
+  int variables;
+};
+
+// Literal buffers are filled concurrently and thus not accounted in the
+// statistics of the solver ('solver' is zero).
+
+static inline void push_chunk_literal (ints *lits, int lit) {
+  struct kissat *const solver = 0;
+  PUSH_STACK (*lits, lit);
+}
+
+static void release_chunk_literals (ints *lits) {
+  struct kissat *const solver = 0;
+  RELEASE_STACK (*lits);
+}
+
+static bool tokenize_chunk (chunk *chunk, strictness strict,
+                            int variables) {
+  const unsigned char *p = chunk->begin;
+  const unsigned char *const end = chunk->end;
+  ints *const lits = &chunk->lits;
+  uint64_t lines = 0, clauses = 0;
+  while (p != end) {
+    int ch = *p++;
+    if (ch == ' ' || ch == '\t')
+      continue;
+    if (ch == '\n') {
+      lines++;
+      continue;
+    }
+    if (ch == 'c') {
+      const unsigned char *nl = memchr (p, '\n', end - p);
+      if (!nl)
+        return false;
+      p = nl + 1;
+      lines++;
+      continue;
+    }
+    int sign = 1;
+    if (ch == '-') {
+      if (p == end)
+        return false;
+      ch = *p++;
+      if (ch == '0')
+        return false;
+      sign = -1;
+    }
+    if (!ISDIGIT (ch))
+      return false;
+    int idx = ch - '0';
+    while (p != end && ISDIGIT (ch = *p)) {
+      p++;
+      if (EXTERNAL_MAX_VAR / 10 < idx)
+        return false;
+      idx *= 10;
+      const int digit = ch - '0';
+      if (EXTERNAL_MAX_VAR - digit < idx)
+        return false;
+      idx += digit;
+    }
+    if (p == end) {
+      assert (chunk->last);
+      if (strict == PEDANTIC_PARSING)
+        return false;
+    } else if (ch != ' ' && ch != '\t' && ch != '\n')
+      return false;
+    if (strict != RELAXED_PARSING && idx > variables)
+      return false;
+    if (!idx)
+      clauses++;
+    push_chunk_literal (lits, sign * idx);
+  }
+  chunk->lines = lines;
+  chunk->clauses = clauses;
+  return true;
+}
+
+static void tokenize_chunk_task (void *state, unsigned task,
+                                 unsigned thread) {
+  chunks *chunks = state;
+  chunk *chunk = chunks->chunks + task;
+  CLEAR_STACK (chunk->lits);
+  chunk->failed =
+      !tokenize_chunk (chunk, chunks->strict, chunks->variables);
+  (void) thread;
+}
+
+static unsigned split_chunks (chunks *chunks, read_buffer *buffer) {
+  const unsigned char *p = buffer->chars + buffer->pos;
+  const unsigned char *const end = buffer->chars + buffer->end;
+  size_t size = (end - p) / chunks->threads + 1;
+  if (size < min_size_chunk)
+    size = min_size_chunk;
+  if (size > size_chunk)
+    size = size_chunk;
+  unsigned res = 0;
+  while (res < chunks->threads && p != end) {
+    chunk *chunk = chunks->chunks + res++;
+    chunk->begin = p;
+    if ((size_t) (end - p) > size) {
+      const unsigned char *nl = memchr (p + size, '\n', end - p - size);
+      p = nl ? nl + 1 : end;
+    } else
+      p = end;
+    chunk->end = p;
+    chunk->last = (p == end);
+  }
+  return res;
+}
+
+static void parse_chunks (kissat *solver, read_buffer *buffer,
+                          strictness strict, int variables,
+                          uint64_t clauses, uint64_t *lineno_ptr,
+                          uint64_t *parsed_ptr, int *lit_ptr) {
+  assert (buffer->mapped);
+  const unsigned threads = GET_OPTION (parsethreads);
+  if (threads < 2)
+    return;
+  chunks chunks;
+  chunks.threads = threads;
+  chunks.strict = strict;
+  chunks.variables = variables;
+  chunks.chunks = kissat_calloc (solver, threads, sizeof *chunks.chunks);
+  uint64_t lineno = *lineno_ptr, parsed = *parsed_ptr;
+  int lit = *lit_ptr;
+  bool failed = false;
+  while (!failed && buffer->pos != buffer->end) {
+    const unsigned size = split_chunks (&chunks, buffer);
+    kissat_parallel_for (solver, threads, size, tokenize_chunk_task,
+                         &chunks);
+    for (unsigned i = 0; !failed && i != size; i++) {
+      chunk *chunk = chunks.chunks + i;
+      if (chunk->failed ||
+          (strict != RELAXED_PARSING && parsed + chunk->clauses > clauses))
+        failed = true;
+      else {
+        for (all_stack (int, other, chunk->lits))
+          kissat_add (solver, other);
+        if (!EMPTY_STACK (chunk->lits))
+          lit = TOP_STACK (chunk->lits);
+        lineno += chunk->lines;
+        parsed += chunk->clauses;
+        buffer->pos = chunk->end - buffer->chars;
+      }
+    }
+  }
+  if (failed)
+    kissat_extremely_verbose (solver,
+                              "parallel parsing stopped at line %" PRIu64,
+                              lineno);
+  for (unsigned i = 0; i != threads; i++)
+    release_chunk_literals (&chunks.chunks[i].lits);
+  kissat_dealloc (solver, chunks.chunks, threads, sizeof *chunks.chunks);
+  *lineno_ptr = lineno;
+  *parsed_ptr = parsed;
+  *lit_ptr = lit;
+}
+
+// clang-format off
+
 static const char *
-parse_dimacs (kissat * solver, file * file,
+parse_dimacs (kissat * solver, read_buffer * buffer, file * file,
               strictness strict, uint64_t * lineno_ptr, int * max_var_ptr)
 {
-  read_buffer buffer;
-  buffer.pos = buffer.end = 0;
   uint64_t lineno = *lineno_ptr = 1;
   bool first = true;
   int ch;
@@ -310,6 +509,9 @@ parse_dimacs (kissat * solver, file * file,
   kissat_reserve (solver, variables);
   uint64_t parsed = 0;
   int lit = 0;
+  if (buffer->mapped)
+    parse_chunks (solver, buffer, strict, variables, clauses,
+		  &lineno, &parsed, &lit);
   for (;;)
     {
       ch = NEXT ();
@@ -436,8 +638,20 @@ kissat_parse_dimacs (kissat * solver,
 		     file * file, uint64_t * lineno_ptr, int *max_var_ptr)
 {
   START (parse);
+  read_buffer buffer;
+  buffer.chars = kissat_map_file (file, &buffer.end);
+  buffer.mapped = buffer.chars;
+  if (!buffer.mapped)
+    buffer.end = 0;
+  buffer.pos = 0;
   const char *res;
-  res = parse_dimacs (solver, file, strict, lineno_ptr, max_var_ptr);
+  res = parse_dimacs (solver, &buffer, file,
+		      strict, lineno_ptr, max_var_ptr);
+  if (buffer.mapped)
+    {
+      file->bytes = buffer.pos;
+      kissat_unmap_file (buffer.chars, buffer.end);
+    }
   if (!solver->inconsistent)
     kissat_defrag_watches (solver);
   STOP (parse);
@@ -0,0 +1,102 @@
+#include "payoff.h"
+#include "internal.h"
+#include "print.h"
+
+#include <inttypes.h>
+
+// Everything counted here makes the formula smaller or stronger.  Removed
+// irredundant clauses are counted separately by comparing clause counts.
+
+static uint64_t simplified (kissat *solver) {
+  const statistics *const s = &solver->statistics;
+  return s->units + s->eliminated + s->substituted + s->sweep_equivalences +
+         s->strengthened + s->vivified;
+}
+
+static double normalized_scale (kissat *solver, payoff *payoff) {
+  const payoffs *const payoffs = &solver->payoffs;
+  double efforts = 0, scaled = 0;
+#define PAYOFF(NAME) \
+  if (payoffs->NAME.rounds) { \
+    const double effort = GET_OPTION (NAME##effort); \
+    efforts += effort; \
+    scaled += effort * payoffs->NAME.scale; \
+  }
+  PAYOFFS
+#undef PAYOFF
+  if (!payoff->rounds || !scaled)
+    return 1;
+  double res = payoff->scale * efforts / scaled;
+  const double max_scale = GET_OPTION (payoffmax);
+  if (res > max_scale)
+    res = max_scale;
+  if (res < 1 / max_scale)
+    res = 1 / max_scale;
+  return res;
+}
+
+double kissat_start_payoff (kissat *solver, payoff *payoff,
+                            const char *name, uint64_t ticks) {
+  if (!GET_OPTION (payoff))
+    return 1;
+  if (!payoff->scale) {
+    payoff->scale = 1;
+    kissat_init_smooth (solver, &payoff->rate, GET_OPTION (payoffwindow),
+                        name);
+  }
+  payoff->running = true;
+  payoff->ticks = ticks;
+  payoff->progress = simplified (solver);
+  payoff->clauses = BINIRR_CLAUSES;
+  const double res = normalized_scale (solver, payoff);
+  kissat_very_verbose (solver,
+                       "%s payoff scale %.3f normalized to effort scale "
+                       "%.3f after %" PRIu64 " rounds",
+                       name, payoff->scale, res, payoff->rounds);
+  (void) name;
+  return res;
+}
+
+void kissat_stop_payoff (kissat *solver, payoff *payoff, const char *name,
+                         uint64_t ticks) {
+  if (!payoff->running)
+    return;
+  payoff->running = false;
+  assert (payoff->ticks <= ticks);
+  if (payoff->ticks == ticks)
+    return;
+  uint64_t gain = simplified (solver) - payoff->progress;
+  const uint64_t clauses = BINIRR_CLAUSES;
+  if (clauses < payoff->clauses)
+    gain += payoff->clauses - clauses;
+  const double rate = 1e6 * gain / (double) (ticks - payoff->ticks);
+  const double average = payoff->rate.value;
+  double factor;
+  if (!payoff->rounds)
+    factor = gain ? 1 : 0.5;
+  else if (!average)
+    factor = gain ? 2 : 0.5;
+  else {
+    factor = rate / average;
+    if (factor > 2)
+      factor = 2;
+    if (factor < 0.5)
+      factor = 0.5;
+  }
+  const double max_scale = GET_OPTION (payoffmax);
+  double scale = payoff->scale * factor;
+  if (scale > max_scale)
+    scale = max_scale;
+  if (scale < 1 / max_scale)
+    scale = 1 / max_scale;
+  payoff->scale = scale;
+  kissat_update_smooth (solver, &payoff->rate, rate);
+  payoff->rounds++;
+  kissat_very_verbose (solver,
+                       "%s round %" PRIu64 " simplified %" PRIu64
+                       " in %" PRIu64 " ticks with payoff rate %.3f "
+                       "(average %.3f) yields scale %.3f",
+                       name, payoff->rounds, gain, ticks - payoff->ticks,
+                       rate, average, scale);
+  (void) name;
+}
@@ -0,0 +1,66 @@
+#ifndef _payoff_h_INCLUDED
+#define _payoff_h_INCLUDED
+
+#include "kimits.h"
+#include "smooth.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Payoff driven effort scheduling (option 'payoff').  The inprocessing
+// techniques listed below are limited by an effort given in per-mille of
+// search ticks.  For each of them we measure in every round how much the
+// formula was simplified (units, eliminated and substituted variables,
+// strengthened and removed clauses) per tick of the technique and keep an
+// exponential moving average of this payoff rate.  A round paying off more
+// than the average increases the effort scale of the technique and a
+// round paying off less decreases it.  The scales are then normalized such
+// that the sum of all (default) efforts stays the same.  Thus the overall
+// simplification budget does not change but is shifted from techniques
+// which stopped paying off to those which still do.
+
+#define PAYOFFS \
+  PAYOFF (backbone) \
+  PAYOFF (eliminate) \
+  PAYOFF (factor) \
+  PAYOFF (sweep) \
+  PAYOFF (transitive) \
+  PAYOFF (vivify)
+
+typedef struct payoff payoff;
+typedef struct payoffs payoffs;
+
+struct payoff {
+  bool running;
+  uint64_t rounds;
+  uint64_t ticks;
+  uint64_t progress;
+  uint64_t clauses;
+  double scale;
+  smooth rate;
+};
+
+struct payoffs {
+#define PAYOFF(NAME) payoff NAME;
+  PAYOFFS
+#undef PAYOFF
+};
+
+struct kissat;
+
+double kissat_start_payoff (struct kissat *, payoff *, const char *name,
+                            uint64_t ticks);
+void kissat_stop_payoff (struct kissat *, payoff *, const char *name,
+                         uint64_t ticks);
+
+#define SET_SCHEDULED_EFFORT_LIMIT(LIMIT, NAME, START) \
+  SET_SCALED_EFFORT_LIMIT (LIMIT, NAME, START, \
+                           kissat_start_payoff ( \
+                               solver, &solver->payoffs.NAME, #NAME, \
+                               solver->statistics.START))
+
+#define STOP_PAYOFF(NAME, START) \
+  kissat_stop_payoff (solver, &solver->payoffs.NAME, #NAME, \
+                      solver->statistics.START)
+
+#endif
@@ -0,0 +1,219 @@
+#include "portfolio.h"
+#include "allocate.h"
+#include "error.h"
+#include "import.h"
+#include "inline.h"
+#include "internal.h"
+#include "print.h"
+#include "resize.h"
+#include "share.h"
+
+#include <pthread.h>
+#include <stdio.h>
+
+// Portfolio mode runs several diversified solvers on the same formula in
+// parallel.  The given solver is solved in the calling thread.  All other
+// solvers ('workers') are initialized in their own thread by copying the
+// root-level units and irredundant clauses of the given solver before it
+// starts to search.  Short learned clauses and units are exchanged through
+// a lock-free shared clause pool (see 'share.c') and the first solver
+// which finishes terminates all the others.
+
+typedef struct portfolio portfolio;
+typedef struct worker worker;
+
+struct worker {
+  portfolio *portfolio;
+  kissat *solver;
+  pthread_t thread;
+  unsigned id;
+  int res;
+};
+
+struct portfolio {
+  kissat *solver;
+  shared_pool *pool;
+  worker *workers;
+  unsigned size;
+  unsigned copied;
+  int winner;
+  pthread_mutex_t lock;
+  pthread_cond_t copied_all;
+};
+
+static void copy_literal (kissat *worker, kissat *solver, unsigned ilit) {
+  const int elit = kissat_export_literal (solver, ilit);
+  assert (elit);
+  kissat_add (worker, elit);
+}
+
+// A solver restored from a preprocessed snapshot might already have
+// eliminated variables and extension variables.  Then the import map, the
+// values of eliminated variables and the extension stack have to be copied
+// too, in order to allow the worker to extend its solution.
+
+static void copy_variables (kissat *solver, kissat *source) {
+  kissat_increase_size (solver, source->vars);
+  for (all_stack (value, value, source->eliminated))
+    PUSH_STACK (solver->eliminated, value);
+  const size_t imported = SIZE_STACK (source->import);
+  for (unsigned eidx = 1; eidx < imported; eidx++) {
+    const import *const import = &PEEK_STACK (source->import, eidx);
+    if (!import->imported)
+      continue;
+    if (import->eliminated)
+      kissat_import_eliminated (solver, eidx, import->lit);
+    else
+      kissat_import_variable (solver, eidx, import->extension);
+  }
+  for (all_stack (extension, ext, source->extend))
+    PUSH_STACK (solver->extend, ext);
+  solver->preprocessed = true;
+}
+
+static void copy_formula (kissat *worker, kissat *solver) {
+  assert (!solver->level);
+  assert (solver->watching);
+  const size_t imported = SIZE_STACK (solver->import);
+  if (solver->preprocessed)
+    copy_variables (worker, solver);
+  else
+    kissat_reserve (worker, imported ? (int) imported - 1 : 0);
+  const value *const values = solver->values;
+  for (all_literals (lit))
+    if (values[lit] > 0) {
+      copy_literal (worker, solver, lit);
+      kissat_add (worker, 0);
+    }
+  for (all_literals (lit)) {
+    watches *watches = &WATCHES (lit);
+    for (all_binary_blocking_watches (watch, *watches)) {
+      if (!watch.type.binary)
+        continue;
+      const unsigned other = watch.binary.lit;
+      if (lit > other)
+        continue;
+      copy_literal (worker, solver, lit);
+      copy_literal (worker, solver, other);
+      kissat_add (worker, 0);
+    }
+  }
+  for (all_clauses (c)) {
+    if (c->garbage || c->redundant)
+      continue;
+    for (all_literals_in_clause (lit, c))
+      copy_literal (worker, solver, lit);
+    kissat_add (worker, 0);
+  }
+}
+
+static void configure_worker (kissat *worker, kissat *solver, unsigned id) {
+  assert (id);
+#ifndef NOPTIONS
+  worker->options = solver->options;
+  kissat_set_option (worker, "seed", GET_OPTION (seed) + (int) id);
+  if (id & 1)
+    kissat_set_option (worker, "phase", !GET_OPTION (phase));
+  if (GET_OPTION (stable) == 1 && id % 3)
+    kissat_set_option (worker, "stable", id % 3 == 1 ? 0 : 2);
+  kissat_set_option (worker, "restartint",
+                     GET_OPTION (restartint) * (1 + (int) (id % 4)));
+#ifndef QUIET
+  kissat_set_option (worker, "quiet", 1);
+  kissat_set_option (worker, "statistics", 0);
+  kissat_set_option (worker, "verbose", 0);
+#endif
+#endif
+  char prefix[32];
+  sprintf (prefix, "c %u ", id);
+  kissat_set_prefix (worker, prefix);
+  worker->limited = solver->limited;
+  worker->limits.conflicts = solver->limits.conflicts;
+  worker->limits.decisions = solver->limits.decisions;
+}
+
+static void finish (worker *worker, int res) {
+  portfolio *portfolio = worker->portfolio;
+  worker->res = res;
+  if (res) {
+    int none = -1;
+    (void) __atomic_compare_exchange_n (&portfolio->winner, &none,
+                                        (int) worker->id, false,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+  }
+  for (unsigned i = 0; i != portfolio->size; i++)
+    if (i != worker->id)
+      kissat_terminate (portfolio->workers[i].solver);
+}
+
+static void *solve_worker (void *ptr) {
+  worker *worker = ptr;
+  portfolio *portfolio = worker->portfolio;
+  kissat *solver = worker->solver;
+  copy_formula (solver, portfolio->solver);
+  pthread_mutex_lock (&portfolio->lock);
+  if (++portfolio->copied + 1 == portfolio->size)
+    pthread_cond_signal (&portfolio->copied_all);
+  pthread_mutex_unlock (&portfolio->lock);
+  finish (worker, kissat_solve (solver));
+  return 0;
+}
+
+int kissat_portfolio_solve (kissat *solver, unsigned threads,
+                            kissat **winner_ptr) {
+  assert (threads > 1);
+  assert (!solver->inconsistent);
+  portfolio portfolio;
+  portfolio.solver = solver;
+  portfolio.size = threads;
+  portfolio.copied = 0;
+  portfolio.winner = -1;
+  portfolio.pool = GET_OPTION (share) ? kissat_new_shared_pool (threads) : 0;
+  portfolio.workers = kissat_calloc (solver, threads, sizeof (worker));
+  pthread_mutex_init (&portfolio.lock, 0);
+  pthread_cond_init (&portfolio.copied_all, 0);
+  kissat_message (solver, "portfolio solving with %u threads %s sharing",
+                  threads, portfolio.pool ? "with" : "without");
+  for (unsigned id = 0; id != threads; id++) {
+    worker *worker = portfolio.workers + id;
+    worker->portfolio = &portfolio;
+    worker->id = id;
+    worker->solver = id ? kissat_init () : solver;
+    if (id)
+      configure_worker (worker->solver, solver, id);
+    if (portfolio.pool)
+      kissat_connect_sharer (worker->solver, portfolio.pool, id);
+  }
+  for (unsigned id = 1; id != threads; id++) {
+    worker *worker = portfolio.workers + id;
+    if (pthread_create (&worker->thread, 0, solve_worker, worker))
+      kissat_fatal ("failed to create portfolio thread %u", id);
+  }
+  pthread_mutex_lock (&portfolio.lock);
+  while (portfolio.copied + 1 < threads)
+    pthread_cond_wait (&portfolio.copied_all, &portfolio.lock);
+  pthread_mutex_unlock (&portfolio.lock);
+  finish (portfolio.workers, kissat_solve (solver));
+  for (unsigned id = 1; id != threads; id++)
+    pthread_join (portfolio.workers[id].thread, 0);
+  const int winner = portfolio.winner;
+  int res = 0;
+  if (winner >= 0) {
+    res = portfolio.workers[winner].res;
+    kissat_message (solver, "portfolio solver %d won with result %d",
+                    winner, res);
+  }
+  *winner_ptr = winner > 0 ? portfolio.workers[winner].solver : solver;
+  for (unsigned id = 0; id != threads; id++) {
+    kissat *other = portfolio.workers[id].solver;
+    kissat_disconnect_sharer (other);
+    if (id && (int) id != winner)
+      kissat_release (other);
+  }
+  if (portfolio.pool)
+    kissat_delete_shared_pool (portfolio.pool);
+  pthread_cond_destroy (&portfolio.copied_all);
+  pthread_mutex_destroy (&portfolio.lock);
+  kissat_dealloc (solver, portfolio.workers, threads, sizeof (worker));
+  return res;
+}
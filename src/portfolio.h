@@ -0,0 +1,9 @@
+#ifndef _portfolio_h_INCLUDED
+#define _portfolio_h_INCLUDED
+
+struct kissat;
+
+int kissat_portfolio_solve (struct kissat *, unsigned threads,
+                            struct kissat **winner_ptr);
+
+#endif
@@ -14,6 +14,10 @@
 bool kissat_preprocessing (struct kissat *solver) {
   assert (!solver->level);
   assert (!solver->inconsistent);
+  if (solver->preprocessed)
+    return false;
+  if (GET (searches))
+    return false;
   if (!GET_OPTION (preprocess))
     return false;
   if (!GET_OPTION (probe))
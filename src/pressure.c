@@ -0,0 +1,86 @@
+#include "pressure.h"
+#include "arena.h"
+#include "collect.h"
+#include "internal.h"
+#include "logging.h"
+#include "print.h"
+#include "resources.h"
+
+#include <inttypes.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+static uint64_t memory_footprint (kissat *solver) {
+  const uint64_t arena = CAPACITY_STACK (solver->arena) * sizeof (ward);
+  const uint64_t vectors =
+      CAPACITY_STACK (solver->vectors.stack) * sizeof (unsigned);
+  return arena + vectors;
+}
+
+static unsigned pressure_level (uint64_t used, uint64_t limit,
+                                unsigned soft) {
+  const uint64_t soft_limit = limit / 100 * soft;
+  if (used < soft_limit)
+    return 0;
+  if (used >= limit)
+    return 3;
+  const uint64_t half = soft_limit + (limit - soft_limit) / 2;
+  return used < half ? 1 : 2;
+}
+
+bool kissat_pressured (kissat *solver) {
+  const unsigned limit_in_mb = GET_OPTION (memorylimit);
+  if (!limit_in_mb)
+    return false;
+  if (CONFLICTS < solver->limits.memory.conflicts)
+    return false;
+  solver->limits.memory.conflicts = CONFLICTS + GET_OPTION (memoryint);
+  const uint64_t limit = (uint64_t) limit_in_mb << 20;
+  const uint64_t rss = kissat_current_resident_set_size ();
+  const uint64_t footprint = memory_footprint (solver);
+  const uint64_t used = MAX (rss, footprint);
+  const unsigned soft = GET_OPTION (memorysoft);
+  const unsigned previous = solver->pressure;
+  const unsigned pressure = pressure_level (used, limit, soft);
+  LOG ("memory pressure level %u with resident set size %" PRIu64
+       " and arena and vectors footprint %" PRIu64 " bytes",
+       pressure, rss, footprint);
+  solver->pressure = pressure;
+  if (pressure != previous)
+    kissat_verbose (solver,
+                    "memory pressure level %u (was %u) using %s "
+                    "of %u MB limit",
+                    pressure, previous, FORMAT_BYTES (used), limit_in_mb);
+  return pressure > 0;
+}
+
+// The resident set size is shared by all solvers of a process, e.g., the
+// workers of a portfolio.  Thus pressure alone would make all of them
+// reduce at the same time, even those which just did.  A reduction is
+// only forced if the arena of this solver also grew by at least an eighth
+// since its last reduction.
+
+bool kissat_forced_by_pressure (kissat *solver) {
+  if (!kissat_pressured (solver))
+    return false;
+  const uint64_t size = SIZE_STACK (solver->arena);
+  const uint64_t last = solver->last.arena.reduce;
+  if (size > last && size - last >= last / 8)
+    return true;
+  LOG ("arena grew only from %" PRIu64 " to %" PRIu64
+       " words since last reduction",
+       last, size);
+  return false;
+}
+
+void kissat_relieve_pressure (kissat *solver) {
+  assert (solver->pressure);
+  if (solver->vectors.usable)
+    kissat_defrag_watches (solver);
+  kissat_shrink_arena (solver);
+#ifdef __GLIBC__
+  malloc_trim (0);
+#endif
+}
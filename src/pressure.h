@@ -0,0 +1,24 @@
+#ifndef _pressure_h_INCLUDED
+#define _pressure_h_INCLUDED
+
+#include <stdbool.h>
+
+// Bounded memory mode (option 'memorylimit' in MB).  Every 'memoryint'
+// conflicts the resident set size of the process (or if larger the
+// capacity of the arena and the watch vectors) is compared to the limit
+// and mapped to a pressure level.  It is zero below 'memorysoft' percent
+// of the limit, one in the lower and two in the upper half of the
+// remaining range and three if the limit is reached.  Under pressure
+// learned clauses are reduced immediately, more aggressively and with
+// tightened tier limits.  Afterwards watches are defragmented and the
+// arena is shrunken to give memory back before hitting the limit.  As the
+// resident set size is per process, an immediate reduction is only forced
+// if the arena of the solver itself grew since its last reduction.
+
+struct kissat;
+
+bool kissat_pressured (struct kissat *);
+bool kissat_forced_by_pressure (struct kissat *);
+void kissat_relieve_pressure (struct kissat *);
+
+#endif
@@ -4,6 +4,11 @@
 #include "error.h"
 #include "file.h"
 #include "inline.h"
+#include "print.h"
+#include "verify.h"
+
+#include <inttypes.h>
+#include <pthread.h>
 
 #undef NDEBUG
 
@@ -20,16 +25,86 @@ struct write_buffer {
 
 typedef struct write_buffer write_buffer;
 
+// Unless disabled by 'proofthread=0' encoded proof lines are only appended
+// to the current buffer by the solver thread, while a background thread
+// writes (and possibly compresses) full buffers.  The solver thread only
+// synchronizes with the writer thread when handing over a full buffer.
+// It only has to wait if all 'size_ring' buffers are still to be written.
+// Files not opened by us, most importantly '<stdout>', are shared with the
+// rest of the process (the solver prints its messages to '<stdout>' too)
+// and are always written synchronously by the solver thread.
+
+#define size_ring 4
+
+struct writer {
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t filled;
+  pthread_cond_t emptied;
+  file *file;
+  uint64_t published;
+  uint64_t written;
+  bool stop;
+  write_buffer buffers[size_ring];
+};
+
+typedef struct writer writer;
+
+// In FRAT mode (option 'frat') every proof line carries a clause
+// identifier.  Since clauses in the solver do not store identifiers, they
+// are found by hashing the (external) literals of a clause.  The literals
+// are kept too, in order to finalize all remaining clauses at the end.
+
+typedef struct identified identified;
+typedef struct identifiers identifiers;
+
+struct identified {
+  uint64_t id;
+  uint64_t hash[2];
+  unsigned size;
+  size_t offset;
+};
+
+struct identifiers {
+  identified *table;
+  size_t size;
+  size_t count;
+  size_t removed;
+};
+
+typedef STACK (uint64_t) uint64s;
+
+#define REMOVED_ID UINT64_MAX
+
 struct proof {
-  write_buffer buffer;
+  write_buffer *buffer;
+  writer *writer;
+  verifier *verifier;
   kissat *solver;
   bool binary;
   file *file;
   ints line;
   uint64_t added;
+  uint64_t bytes;
   uint64_t deleted;
   uint64_t lines;
   uint64_t literals;
+  bool frat;
+  bool chained;
+  uint64_t id;
+  uint64_t chains;
+  uint64_t hints;
+  uint64_t unidentified;
+  identifiers identifiers;
+  ints clauses;
+  size_t garbage;
+  uint64s chain;
+  uint64_t chain_hash[2];
+  unsigned chain_size;
+  unsigneds trace;
+  unsigneds touched;
+  unsigned char *marks;
+  unsigned size_marks;
 #ifndef NDEBUG
   bool empty;
   char *units;
@@ -51,33 +126,155 @@ struct proof {
   LOGINTS3 (SIZE_STACK (proof->line), BEGIN_STACK (proof->line), \
             __VA_ARGS__)
 
+static void write_buffer_to_file (file *file, write_buffer *buffer) {
+  const size_t bytes = buffer->pos;
+  size_t written = kissat_write (file, buffer->chars, bytes);
+  if (bytes != written)
+    kissat_fatal ("flushing %zu bytes in proof write-buffer failed", bytes);
+  buffer->pos = 0;
+}
+
+static void *write_buffers (void *ptr) {
+  writer *writer = ptr;
+  pthread_mutex_lock (&writer->lock);
+  for (;;) {
+    while (writer->written == writer->published && !writer->stop)
+      pthread_cond_wait (&writer->filled, &writer->lock);
+    if (writer->written == writer->published)
+      break;
+    const size_t pos = writer->written % size_ring;
+    write_buffer *buffer = writer->buffers + pos;
+    pthread_mutex_unlock (&writer->lock);
+    write_buffer_to_file (writer->file, buffer);
+    pthread_mutex_lock (&writer->lock);
+    writer->written++;
+    pthread_cond_signal (&writer->emptied);
+  }
+  pthread_mutex_unlock (&writer->lock);
+  return 0;
+}
+
+static writer *start_writer (kissat *solver, file *file) {
+  writer *writer = kissat_malloc (solver, sizeof (struct writer));
+  writer->file = file;
+  writer->published = writer->written = 0;
+  writer->stop = false;
+  writer->buffers[0].pos = 0;
+  pthread_mutex_init (&writer->lock, 0);
+  pthread_cond_init (&writer->filled, 0);
+  pthread_cond_init (&writer->emptied, 0);
+  if (!pthread_create (&writer->thread, 0, write_buffers, writer))
+    return writer;
+  pthread_cond_destroy (&writer->emptied);
+  pthread_cond_destroy (&writer->filled);
+  pthread_mutex_destroy (&writer->lock);
+  kissat_free (solver, writer, sizeof (struct writer));
+  return 0;
+}
+
+static void stop_writer (kissat *solver, writer *writer) {
+  pthread_mutex_lock (&writer->lock);
+  writer->stop = true;
+  pthread_cond_signal (&writer->filled);
+  pthread_mutex_unlock (&writer->lock);
+  pthread_join (writer->thread, 0);
+  assert (writer->written == writer->published);
+  pthread_cond_destroy (&writer->emptied);
+  pthread_cond_destroy (&writer->filled);
+  pthread_mutex_destroy (&writer->lock);
+  kissat_free (solver, writer, sizeof (struct writer));
+}
+
+static void hand_over_buffer (proof *proof) {
+  writer *writer = proof->writer;
+  assert (proof->buffer == writer->buffers + writer->published % size_ring);
+  pthread_mutex_lock (&writer->lock);
+  writer->published++;
+  pthread_cond_signal (&writer->filled);
+  while (writer->published - writer->written == size_ring)
+    pthread_cond_wait (&writer->emptied, &writer->lock);
+  pthread_mutex_unlock (&writer->lock);
+  write_buffer *buffer = writer->buffers + writer->published % size_ring;
+  buffer->pos = 0;
+  proof->buffer = buffer;
+}
+
+static void wait_for_writer (writer *writer) {
+  pthread_mutex_lock (&writer->lock);
+  while (writer->written != writer->published)
+    pthread_cond_wait (&writer->emptied, &writer->lock);
+  pthread_mutex_unlock (&writer->lock);
+}
+
 void kissat_init_proof (kissat *solver, file *file, bool binary) {
-  assert (file);
+  assert (file || GET_OPTION (proofcheck));
   assert (!solver->proof);
+  assert (!solver->importer.import);
   proof *proof = kissat_calloc (solver, 1, sizeof (struct proof));
   proof->binary = binary;
   proof->file = file;
   proof->solver = solver;
+  proof->frat = file && GET_OPTION (frat);
+  if (GET_OPTION (proofcheck))
+    proof->verifier = kissat_start_verifier (solver);
+  if (file && file->close && GET_OPTION (proofthread))
+    proof->writer = start_writer (solver, file);
+  if (proof->writer)
+    proof->buffer = proof->writer->buffers;
+  else
+    proof->buffer = kissat_calloc (solver, 1, sizeof (write_buffer));
   solver->proof = proof;
-  LOG ("starting to trace %s proof", binary ? "binary" : "non-binary");
+  LOG ("starting to trace %s %s proof%s%s",
+       binary ? "binary" : "non-binary", proof->frat ? "FRAT" : "DRAT",
+       proof->writer ? " in background thread" : "",
+       proof->verifier ? " and check it concurrently" : "");
 }
 
 static void flush_buffer (proof *proof) {
-  size_t bytes = proof->buffer.pos;
+  const size_t bytes = proof->buffer->pos;
   if (!bytes)
     return;
-  size_t written = kissat_write (proof->file, proof->buffer.chars, bytes);
-  if (bytes != written)
-    kissat_fatal ("flushing %zu bytes in proof write-buffer failed", bytes);
-  proof->buffer.pos = 0;
+  proof->bytes += bytes;
+  if (proof->writer)
+    hand_over_buffer (proof);
+  else
+    write_buffer_to_file (proof->file, proof->buffer);
 }
 
+static void flush_proof (proof *proof) {
+  if (!proof->file)
+    return;
+  flush_buffer (proof);
+  if (proof->writer)
+    wait_for_writer (proof->writer);
+  kissat_flush (proof->file);
+}
+
+static void finalize_frat_proof (proof *);
+static void release_frat_proof (proof *);
+
 void kissat_release_proof (kissat *solver) {
   proof *proof = solver->proof;
   assert (proof);
   LOG ("stopping to trace proof");
+  if (proof->verifier)
+    kissat_stop_verifier (solver, proof->verifier);
+  if (proof->frat) {
+    finalize_frat_proof (proof);
+    release_frat_proof (proof);
+    if (proof->unidentified)
+      kissat_warning (solver,
+                      "skipped %" PRIu64 " deletions of unidentified "
+                      "clauses in FRAT proof",
+                      proof->unidentified);
+  }
   flush_buffer (proof);
-  kissat_flush (proof->file);
+  if (proof->writer)
+    stop_writer (solver, proof->writer);
+  else
+    kissat_free (solver, proof->buffer, sizeof (write_buffer));
+  if (proof->file)
+    kissat_flush (proof->file);
   RELEASE_STACK (proof->line);
 #ifndef NDEBUG
   kissat_free (solver, proof->units, proof->size_units);
@@ -91,18 +288,23 @@ void kissat_release_proof (kissat *solver) {
 
 #ifndef QUIET
 
-#include <inttypes.h>
-
 #define PERCENT_LINES(NAME) kissat_percent (proof->NAME, proof->lines)
 
 void kissat_print_proof_statistics (kissat *solver, bool verbose) {
   proof *proof = solver->proof;
   PRINT_STAT ("proof_added", proof->added, PERCENT_LINES (added), "%",
               "per line");
-  PRINT_STAT ("proof_bytes", proof->file->bytes,
-              proof->file->bytes / (double) (1 << 20), "MB", "");
+  PRINT_STAT ("proof_bytes", proof->bytes,
+              proof->bytes / (double) (1 << 20), "MB", "");
   PRINT_STAT ("proof_deleted", proof->deleted, PERCENT_LINES (deleted), "%",
               "per line");
+  if (proof->frat) {
+    PRINT_STAT ("proof_chained", proof->chains,
+                kissat_percent (proof->chains, proof->added), "%", "added");
+    PRINT_STAT ("proof_hints", proof->hints,
+                kissat_average (proof->hints, proof->chains), "",
+                "per chain");
+  }
   if (verbose)
     PRINT_STAT ("proof_lines", proof->lines, 100, "%", "");
   if (verbose)
@@ -128,9 +330,11 @@ import_internal_proof_literal (kissat *, proof *, unsigned)
 // clang-format on
 
 static inline void write_char (proof *proof, unsigned char ch) {
-  write_buffer *buffer = &proof->buffer;
-  if (buffer->pos == size_buffer)
+  write_buffer *buffer = proof->buffer;
+  if (buffer->pos == size_buffer) {
     flush_buffer (proof);
+    buffer = proof->buffer;
+  }
   buffer->chars[buffer->pos++] = ch;
 }
 
@@ -226,12 +430,8 @@ static void print_non_binary_proof_line (proof *proof) {
   write_char (proof, '\n');
 }
 
-static void print_proof_line (proof *proof) {
+static void end_proof_line (proof *proof) {
   proof->lines++;
-  if (proof->binary)
-    print_binary_proof_line (proof);
-  else
-    print_non_binary_proof_line (proof);
   CLEAR_STACK (proof->line);
 #if !defined(NDEBUG) || defined(LOGGING)
   CLEAR_STACK (proof->imported);
@@ -239,10 +439,309 @@ static void print_proof_line (proof *proof) {
 #ifndef NOPTIONS
   kissat *solver = proof->solver;
 #endif
-  if (GET_OPTION (flushproof)) {
-    flush_buffer (proof);
-    kissat_flush (proof->file);
+  if (GET_OPTION (flushproof))
+    flush_proof (proof);
+}
+
+static void print_proof_line (proof *proof) {
+  if (proof->binary)
+    print_binary_proof_line (proof);
+  else
+    print_non_binary_proof_line (proof);
+  end_proof_line (proof);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Binary FRAT uses the variable-length encoding of binary DRAT for all
+// numbers, where clause identifiers are encoded like positive literals.
+
+static void write_binary_number (proof *proof, uint64_t x) {
+  while (x & ~(uint64_t) 0x7f) {
+    write_char (proof, (x & 0x7f) | 0x80);
+    x >>= 7;
+  }
+  write_char (proof, x);
+}
+
+static void write_decimal_number (proof *proof, uint64_t x) {
+  char buffer[24];
+  char *p = buffer + sizeof buffer;
+  do
+    *--p = '0' + (x % 10);
+  while (x /= 10);
+  while (p != buffer + sizeof buffer)
+    write_char (proof, *p++);
+}
+
+static void write_frat_literals (proof *proof, size_t size,
+                                 const int *elits) {
+  const int *const end = elits + size;
+  if (proof->binary) {
+    for (const int *p = elits; p != end; p++) {
+      const int elit = *p;
+      write_binary_number (proof, 2u * ABS (elit) + (elit < 0));
+    }
+    write_char (proof, 0);
+  } else {
+    for (const int *p = elits; p != end; p++) {
+      const int elit = *p;
+      if (elit < 0)
+        write_char (proof, '-');
+      write_decimal_number (proof, ABS (elit));
+      write_char (proof, ' ');
+    }
+    write_char (proof, '0');
+  }
+}
+
+static void write_frat_hints (proof *proof) {
+  if (proof->binary) {
+    write_char (proof, 'l');
+    for (all_stack (uint64_t, id, proof->chain))
+      write_binary_number (proof, 2 * id);
+    write_char (proof, 0);
+  } else {
+    write_char (proof, ' ');
+    write_char (proof, 'l');
+    for (all_stack (uint64_t, id, proof->chain)) {
+      write_char (proof, ' ');
+      write_decimal_number (proof, id);
+    }
+    write_char (proof, ' ');
+    write_char (proof, '0');
+  }
+}
+
+static void print_frat_line (proof *proof, char type, uint64_t id,
+                             size_t size, const int *elits, bool hints) {
+  write_char (proof, type);
+  if (proof->binary)
+    write_binary_number (proof, 2 * id);
+  else {
+    write_char (proof, ' ');
+    write_decimal_number (proof, id);
+    write_char (proof, ' ');
+  }
+  write_frat_literals (proof, size, elits);
+  if (hints)
+    write_frat_hints (proof);
+  if (!proof->binary)
+    write_char (proof, '\n');
+}
+
+/*------------------------------------------------------------------------*/
+
+static inline uint64_t mix_literal (uint64_t x) {
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+// The hash of a clause is the sum of independent hashes of its literals,
+// thus does not depend on the order of literals.  Two such 64-bit hashes
+// together with the size are used to identify clauses.
+
+static inline void hash_external_literal (uint64_t hash[2], int elit) {
+  const uint64_t plit = 2u * ABS (elit) + (elit < 0);
+  hash[0] += mix_literal (plit);
+  hash[1] += mix_literal (plit ^ 0x5851f42d4c957f2dull);
+}
+
+static void hash_external_literals (uint64_t hash[2], size_t size,
+                                    const int *elits) {
+  hash[0] = hash[1] = 0;
+  for (size_t i = 0; i != size; i++)
+    hash_external_literal (hash, elits[i]);
+}
+
+static void hash_internal_literals (kissat *solver, uint64_t hash[2],
+                                    size_t size, const unsigned *ilits) {
+  hash[0] = hash[1] = 0;
+  for (size_t i = 0; i != size; i++)
+    hash_external_literal (hash, kissat_export_literal (solver, ilits[i]));
+}
+
+static size_t find_identified (proof *proof, const uint64_t hash[2],
+                               size_t size) {
+  identifiers *identifiers = &proof->identifiers;
+  if (!identifiers->size)
+    return SIZE_MAX;
+  const size_t mask = identifiers->size - 1;
+  identified *const table = identifiers->table;
+  for (size_t pos = hash[0] & mask;; pos = (pos + 1) & mask) {
+    identified *entry = table + pos;
+    if (!entry->id)
+      return SIZE_MAX;
+    if (entry->id != REMOVED_ID && entry->hash[0] == hash[0] &&
+        entry->hash[1] == hash[1] && entry->size == size)
+      return pos;
+  }
+}
+
+static void compact_identified_literals (proof *proof) {
+  kissat *solver = proof->solver;
+  identifiers *identifiers = &proof->identifiers;
+  ints clauses;
+  INIT_STACK (clauses);
+  const identified *const end = identifiers->table + identifiers->size;
+  for (identified *entry = identifiers->table; entry != end; entry++) {
+    if (!entry->id || entry->id == REMOVED_ID)
+      continue;
+    const size_t offset = SIZE_STACK (clauses);
+    const int *elits = BEGIN_STACK (proof->clauses) + entry->offset;
+    for (unsigned i = 0; i != entry->size; i++)
+      PUSH_STACK (clauses, elits[i]);
+    entry->offset = offset;
+  }
+  RELEASE_STACK (proof->clauses);
+  proof->clauses = clauses;
+  proof->garbage = 0;
+}
+
+static void resize_identifiers (proof *proof) {
+  kissat *solver = proof->solver;
+  identifiers *identifiers = &proof->identifiers;
+  const size_t old_size = identifiers->size;
+  size_t new_size = old_size ? old_size : 1024;
+  while (4 * identifiers->count > new_size)
+    new_size *= 2;
+  identified *old_table = identifiers->table;
+  identified *new_table =
+      kissat_calloc (solver, new_size, sizeof *new_table);
+  const size_t mask = new_size - 1;
+  for (size_t i = 0; i != old_size; i++) {
+    const identified *entry = old_table + i;
+    if (!entry->id || entry->id == REMOVED_ID)
+      continue;
+    size_t pos = entry->hash[0] & mask;
+    while (new_table[pos].id)
+      pos = (pos + 1) & mask;
+    new_table[pos] = *entry;
+  }
+  kissat_dealloc (solver, old_table, old_size, sizeof *old_table);
+  identifiers->table = new_table;
+  identifiers->size = new_size;
+  identifiers->removed = 0;
+  LOG ("resized clause identifier table to %zu entries", new_size);
+}
+
+static void insert_identified (proof *proof, uint64_t id,
+                               const uint64_t hash[2], size_t size,
+                               const int *elits) {
+  kissat *solver = proof->solver;
+  identifiers *identifiers = &proof->identifiers;
+  if (2 * (identifiers->count + identifiers->removed + 1) >
+      identifiers->size)
+    resize_identifiers (proof);
+  const size_t mask = identifiers->size - 1;
+  size_t pos = hash[0] & mask;
+  while (identifiers->table[pos].id &&
+         identifiers->table[pos].id != REMOVED_ID)
+    pos = (pos + 1) & mask;
+  identified *entry = identifiers->table + pos;
+  if (entry->id == REMOVED_ID)
+    identifiers->removed--;
+  identifiers->count++;
+  entry->id = id;
+  entry->hash[0] = hash[0];
+  entry->hash[1] = hash[1];
+  assert (size <= UINT_MAX);
+  entry->size = size;
+  entry->offset = SIZE_STACK (proof->clauses);
+  for (size_t i = 0; i != size; i++)
+    PUSH_STACK (proof->clauses, elits[i]);
+}
+
+static void remove_identified (proof *proof, size_t pos) {
+  identifiers *identifiers = &proof->identifiers;
+  identified *entry = identifiers->table + pos;
+  assert (entry->id && entry->id != REMOVED_ID);
+  entry->id = REMOVED_ID;
+  assert (identifiers->count);
+  identifiers->count--;
+  identifiers->removed++;
+  proof->garbage += entry->size;
+  if (proof->garbage > SIZE_STACK (proof->clauses) / 2 &&
+      proof->garbage > (1u << 20))
+    compact_identified_literals (proof);
+}
+
+static uint64_t identify_internal_clause (proof *proof, size_t size,
+                                          const unsigned *ilits) {
+  uint64_t hash[2];
+  hash_internal_literals (proof->solver, hash, size, ilits);
+  const size_t pos = find_identified (proof, hash, size);
+  return pos == SIZE_MAX ? 0 : proof->identifiers.table[pos].id;
+}
+
+static void print_added_frat_line (proof *proof, char type) {
+  const uint64_t id = ++proof->id;
+  const size_t size = SIZE_STACK (proof->line);
+  const int *elits = BEGIN_STACK (proof->line);
+  uint64_t hash[2];
+  hash_external_literals (hash, size, elits);
+  insert_identified (proof, id, hash, size, elits);
+  const bool hints = proof->chained && proof->chain_size == size &&
+                     proof->chain_hash[0] == hash[0] &&
+                     proof->chain_hash[1] == hash[1];
+  if (hints) {
+    proof->chains++;
+    proof->hints += SIZE_STACK (proof->chain);
+  }
+  proof->chained = false;
+  print_frat_line (proof, type, id, size, elits, hints);
+  end_proof_line (proof);
+}
+
+static void print_deleted_frat_line (proof *proof) {
+  const size_t size = SIZE_STACK (proof->line);
+  const int *elits = BEGIN_STACK (proof->line);
+  uint64_t hash[2];
+  hash_external_literals (hash, size, elits);
+  const size_t pos = find_identified (proof, hash, size);
+  if (pos == SIZE_MAX) {
+#ifdef LOGGING
+    kissat *solver = proof->solver;
+    LOGLINE3 ("skipping deletion of unidentified");
+#endif
+    assert (!"deleting unidentified clause in FRAT proof");
+    proof->unidentified++;
+    CLEAR_STACK (proof->line);
+#if !defined(NDEBUG) || defined(LOGGING)
+    CLEAR_STACK (proof->imported);
+#endif
+    return;
   }
+  const uint64_t id = proof->identifiers.table[pos].id;
+  remove_identified (proof, pos);
+  print_frat_line (proof, 'd', id, size, elits, false);
+  end_proof_line (proof);
+}
+
+static void finalize_frat_proof (proof *proof) {
+  identifiers *identifiers = &proof->identifiers;
+  const identified *const end = identifiers->table + identifiers->size;
+  for (identified *entry = identifiers->table; entry != end; entry++) {
+    if (!entry->id || entry->id == REMOVED_ID)
+      continue;
+    const int *elits = BEGIN_STACK (proof->clauses) + entry->offset;
+    print_frat_line (proof, 'f', entry->id, entry->size, elits, false);
+    proof->lines++;
+  }
+}
+
+static void release_frat_proof (proof *proof) {
+  kissat *solver = proof->solver;
+  identifiers *identifiers = &proof->identifiers;
+  kissat_dealloc (solver, identifiers->table, identifiers->size,
+                  sizeof (identified));
+  RELEASE_STACK (proof->clauses);
+  RELEASE_STACK (proof->chain);
+  RELEASE_STACK (proof->trace);
+  RELEASE_STACK (proof->touched);
+  kissat_free (solver, proof->marks, proof->size_marks);
 }
 
 #ifndef NDEBUG
@@ -295,9 +794,18 @@ static void print_added_proof_line (proof *proof) {
 #ifndef NDEBUG
   check_repeated_proof_lines (proof);
 #endif
-  if (proof->binary)
-    write_char (proof, 'a');
-  print_proof_line (proof);
+  if (proof->verifier)
+    kissat_verify_added (proof->verifier, SIZE_STACK (proof->line),
+                         BEGIN_STACK (proof->line));
+  if (!proof->file)
+    end_proof_line (proof);
+  else if (proof->frat)
+    print_added_frat_line (proof, 'a');
+  else {
+    if (proof->binary)
+      write_char (proof, 'a');
+    print_proof_line (proof);
+  }
 }
 
 static void print_delete_proof_line (proof *proof) {
@@ -308,10 +816,19 @@ static void print_delete_proof_line (proof *proof) {
     LOGIMPORTED3 ("deleted internal proof line");
   LOGLINE3 ("deleted external proof line");
 #endif
-  write_char (proof, 'd');
-  if (!proof->binary)
-    write_char (proof, ' ');
-  print_proof_line (proof);
+  if (proof->verifier)
+    kissat_verify_deleted (proof->verifier, SIZE_STACK (proof->line),
+                           BEGIN_STACK (proof->line));
+  if (!proof->file)
+    end_proof_line (proof);
+  else if (proof->frat)
+    print_deleted_frat_line (proof);
+  else {
+    write_char (proof, 'd');
+    if (!proof->binary)
+      write_char (proof, ' ');
+    print_proof_line (proof);
+  }
 }
 
 void kissat_add_binary_to_proof (kissat *solver, unsigned a, unsigned b) {
@@ -403,6 +920,212 @@ void kissat_delete_internal_from_proof (kissat *solver, size_t size,
   print_delete_proof_line (proof);
 }
 
+void kissat_add_original_to_proof (kissat *solver, size_t size,
+                                   const int *elits) {
+  proof *proof = solver->proof;
+  assert (proof);
+  if (proof->verifier)
+    kissat_verify_original (proof->verifier, size, elits);
+  if (!proof->frat)
+    return;
+  LOGINTS3 (size, elits, "original");
+  import_external_proof_literals (solver, proof, size, elits);
+  proof->chained = false;
+  print_added_frat_line (proof, 'o');
+}
+
+/*------------------------------------------------------------------------*/
+
+// Antecedent chains (hints) for FRAT proofs are collected from the
+// implication graph.  The chain of a learned clause lists the reasons of
+// all literals implied by the negation of the clause in the order they
+// are propagated (post-order of a depth-first search starting at the
+// conflict), followed by the conflict.  Root-level literals are justified
+// by their unit clauses.  If any of these clauses can not be identified
+// (for instance due to jumped binary reasons) the clause is added without
+// chain, which FRAT allows and is completed by the elaborator.
+
+enum chain_mark {
+  CHAIN_UNMARKED = 0,
+  CHAIN_CLAUSE = 1,
+  CHAIN_VISITED = 2,
+};
+
+static void mark_chain_variable (proof *proof, unsigned idx,
+                                 unsigned char mark) {
+  kissat *solver = proof->solver;
+  if (idx >= proof->size_marks) {
+    unsigned new_size = proof->size_marks ? proof->size_marks : 1;
+    while (new_size <= idx)
+      new_size *= 2;
+    proof->marks = kissat_realloc (solver, proof->marks, proof->size_marks,
+                                   new_size);
+    memset (proof->marks + proof->size_marks, 0,
+            new_size - proof->size_marks);
+    proof->size_marks = new_size;
+  }
+  assert (!proof->marks[idx]);
+  proof->marks[idx] = mark;
+  PUSH_STACK (proof->touched, idx);
+}
+
+static inline unsigned char chain_mark (proof *proof, unsigned idx) {
+  return idx < proof->size_marks ? proof->marks[idx] : CHAIN_UNMARKED;
+}
+
+static void start_chain (proof *proof) {
+  proof->chained = false;
+  CLEAR_STACK (proof->chain);
+  assert (EMPTY_STACK (proof->touched));
+  assert (EMPTY_STACK (proof->trace));
+}
+
+static void end_chain (proof *proof, bool chained, size_t size,
+                       const unsigned *ilits) {
+  kissat *solver = proof->solver;
+  for (all_stack (unsigned, idx, proof->touched))
+    proof->marks[idx] = CHAIN_UNMARKED;
+  CLEAR_STACK (proof->touched);
+  CLEAR_STACK (proof->trace);
+  if (!chained)
+    return;
+  hash_internal_literals (solver, proof->chain_hash, size, ilits);
+  proof->chain_size = size;
+  proof->chained = true;
+}
+
+static bool push_unit_hint (proof *proof, unsigned lit) {
+  kissat *solver = proof->solver;
+  const uint64_t id = identify_internal_clause (proof, 1, &lit);
+  if (!id)
+    return false;
+  PUSH_STACK (proof->chain, id);
+  return true;
+}
+
+static bool push_reason_hint (proof *proof, unsigned lit,
+                              const assigned *a) {
+  kissat *solver = proof->solver;
+  uint64_t id;
+  if (a->binary) {
+    const unsigned lits[2] = {lit, a->reason};
+    id = identify_internal_clause (proof, 2, lits);
+  } else {
+    clause *reason = kissat_dereference_clause (solver, a->reason);
+    id = identify_internal_clause (proof, reason->size, reason->lits);
+  }
+  if (!id)
+    return false;
+  PUSH_STACK (proof->chain, id);
+  return true;
+}
+
+// The trace stack holds true literals to be justified and twice the
+// literal plus one for literals whose reason hint is pending.
+
+static bool chain_false_literal (proof *proof, unsigned false_lit) {
+  kissat *solver = proof->solver;
+  const assigned *const all_assigned = solver->assigned;
+  unsigneds *trace = &proof->trace;
+  assert (EMPTY_STACK (*trace));
+  PUSH_STACK (*trace, 2 * NOT (false_lit));
+  while (!EMPTY_STACK (*trace)) {
+    const unsigned top = POP_STACK (*trace);
+    const unsigned lit = top / 2;
+    const unsigned idx = IDX (lit);
+    const assigned *const a = all_assigned + idx;
+    if (top & 1) {
+      if (!push_reason_hint (proof, lit, a))
+        return false;
+      continue;
+    }
+    if (chain_mark (proof, idx))
+      continue;
+    mark_chain_variable (proof, idx, CHAIN_VISITED);
+    if (!a->level) {
+      if (!push_unit_hint (proof, lit))
+        return false;
+      continue;
+    }
+    if (a->reason == DECISION_REASON || a->reason == UNIT_REASON)
+      return false;
+    PUSH_STACK (*trace, 2 * lit + 1);
+    if (a->binary) {
+      const unsigned other = a->reason;
+      if (!chain_mark (proof, IDX (other)))
+        PUSH_STACK (*trace, 2 * NOT (other));
+    } else {
+      clause *reason = kissat_dereference_clause (solver, a->reason);
+      for (all_literals_in_clause (other, reason))
+        if (other != lit && !chain_mark (proof, IDX (other)))
+          PUSH_STACK (*trace, 2 * NOT (other));
+    }
+  }
+  return true;
+}
+
+void kissat_chain_learned_in_proof (kissat *solver,
+                                    const clause *conflict) {
+  proof *proof = solver->proof;
+  assert (proof);
+  if (!proof->frat)
+    return;
+  start_chain (proof);
+  for (all_stack (unsigned, lit, solver->clause))
+    mark_chain_variable (proof, IDX (lit), CHAIN_CLAUSE);
+  bool chained = true;
+  const unsigned *const end = conflict->lits + conflict->size;
+  for (const unsigned *p = conflict->lits; p != end; p++) {
+    const unsigned lit = *p;
+    if (chain_mark (proof, IDX (lit)))
+      continue;
+    if (!chain_false_literal (proof, lit)) {
+      chained = false;
+      break;
+    }
+  }
+  if (chained) {
+    const uint64_t id =
+        identify_internal_clause (proof, conflict->size, conflict->lits);
+    if (id)
+      PUSH_STACK (proof->chain, id);
+    else
+      chained = false;
+  }
+  end_chain (proof, chained, SIZE_STACK (solver->clause),
+             BEGIN_STACK (solver->clause));
+}
+
+void kissat_chain_unit_in_proof (kissat *solver, unsigned unit,
+                                 bool binary, unsigned reason) {
+  proof *proof = solver->proof;
+  assert (proof);
+  if (!proof->frat)
+    return;
+  start_chain (proof);
+  bool chained = true;
+  if (binary) {
+    const unsigned lits[2] = {unit, reason};
+    uint64_t id = identify_internal_clause (proof, 2, lits);
+    chained = id && push_unit_hint (proof, NOT (reason));
+    if (chained)
+      PUSH_STACK (proof->chain, id);
+  } else {
+    clause *c = kissat_dereference_clause (solver, reason);
+    for (all_literals_in_clause (other, c))
+      if (other != unit && !(chained = push_unit_hint (proof, NOT (other))))
+        break;
+    if (chained) {
+      const uint64_t id = identify_internal_clause (proof, c->size, c->lits);
+      if (id)
+        PUSH_STACK (proof->chain, id);
+      else
+        chained = false;
+    }
+  }
+  end_chain (proof, chained, 1, &unit);
+}
+
 #else
 int kissat_proof_dummy_to_avoid_warning;
 #endif
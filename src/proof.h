@@ -24,6 +24,13 @@ void kissat_add_empty_to_proof (struct kissat *);
 void kissat_add_lits_to_proof (struct kissat *, size_t, const unsigned *);
 void kissat_add_unit_to_proof (struct kissat *, unsigned);
 
+void kissat_add_original_to_proof (struct kissat *, size_t, const int *);
+
+void kissat_chain_learned_in_proof (struct kissat *,
+                                    const struct clause *conflict);
+void kissat_chain_unit_in_proof (struct kissat *, unsigned unit,
+                                 bool binary, unsigned reason);
+
 void kissat_shrink_clause_in_proof (struct kissat *, const struct clause *,
                                     unsigned remove, unsigned keep);
 
@@ -76,6 +83,18 @@ void kissat_delete_internal_from_proof (struct kissat *, size_t,
       kissat_add_unit_to_proof (solver, (A)); \
   } while (0)
 
+#define CHAIN_LEARNED_IN_PROOF(CONFLICT) \
+  do { \
+    if (solver->proof) \
+      kissat_chain_learned_in_proof (solver, (CONFLICT)); \
+  } while (0)
+
+#define CHAIN_UNIT_IN_PROOF(LIT, BINARY, REASON) \
+  do { \
+    if (solver->proof) \
+      kissat_chain_unit_in_proof (solver, (LIT), (BINARY), (REASON)); \
+  } while (0)
+
 #define SHRINK_CLAUSE_IN_PROOF(C, REMOVE, KEEP) \
   do { \
     if (solver->proof) \
@@ -139,6 +158,13 @@ void kissat_delete_internal_from_proof (struct kissat *, size_t,
   do { \
   } while (0)
 
+#define CHAIN_LEARNED_IN_PROOF(...) \
+  do { \
+  } while (0)
+#define CHAIN_UNIT_IN_PROOF(...) \
+  do { \
+  } while (0)
+
 #define SHRINK_CLAUSE_IN_PROOF(...) \
   do { \
   } while (0)
@@ -32,6 +32,14 @@ update_search_propagation_statistics (kissat *solver,
   }
 }
 
+static inline bool replaying_saved_trail (kissat *solver) {
+  const saved_trail *const saved = &solver->saved_trail;
+  const saved_literals *const literals = &saved->literals;
+  if (saved->next == SIZE_STACK (*literals))
+    return false;
+  return PEEK_STACK (*literals, saved->next).level == solver->level;
+}
+
 static clause *search_propagate (kissat *solver) {
   clause *res = 0;
   unsigned *propagate = solver->propagate;
@@ -49,8 +57,12 @@ clause *kissat_search_propagate (kissat *solver) {
   START (propagate);
 
   solver->ticks = 0;
+  clause *conflict = 0;
+  if (replaying_saved_trail (solver))
+    conflict = kissat_replay_saved_trail (solver);
   const unsigned *saved_propagate = solver->propagate;
-  clause *conflict = search_propagate (solver);
+  if (!conflict)
+    conflict = search_propagate (solver);
   update_search_propagation_statistics (solver, saved_propagate);
   kissat_update_conflicts_and_trail (solver, conflict, true);
   if (conflict && solver->randec) {
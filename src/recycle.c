@@ -0,0 +1,137 @@
+#include "recycle.h"
+#include "allocate.h"
+#include "inline.h"
+#include "internal.h"
+#include "logging.h"
+#include "print.h"
+
+#include <inttypes.h>
+
+bool kissat_recycling (kissat *solver, bool compact) {
+  if (!GET_OPTION (recycle))
+    return false;
+  if (compact)
+    return false;
+  if (solver->unflushed)
+    return false;
+  const uint64_t reductions = GET (reductions);
+  const unsigned interval = GET_OPTION (recycleint);
+  return reductions % interval;
+}
+
+void kissat_clear_recycled_clauses (kissat *solver) {
+  recycler *recycler = &solver->recycler;
+  if (!recycler->slots)
+    return;
+  LOG ("clearing %zu recycled clause slots", recycler->slots);
+  SUB (clauses_deleted, recycler->slots);
+  ADD (arena_garbage, recycler->bytes);
+  for (unsigned i = 0; i != RECYCLE_CLASSES; i++)
+    CLEAR_STACK (recycler->classes[i]);
+  recycler->slots = 0;
+  recycler->bytes = 0;
+}
+
+void kissat_release_recycled_clauses (kissat *solver) {
+  recycler *recycler = &solver->recycler;
+  for (unsigned i = 0; i != RECYCLE_CLASSES; i++)
+    RELEASE_STACK (recycler->classes[i]);
+  recycler->slots = 0;
+  recycler->bytes = 0;
+}
+
+static bool recyclable (clause *c) {
+  return c->garbage && c->redundant && !c->reason;
+}
+
+static void flush_garbage_watches (kissat *solver, unsigned lit,
+                                   reference start) {
+  ward *const arena = BEGIN_STACK (solver->arena);
+  watches *lit_watches = &WATCHES (lit);
+  watch *begin = BEGIN_WATCHES (*lit_watches), *q = begin;
+  const watch *const end = END_WATCHES (*lit_watches), *p = q;
+  while (p != end) {
+    const watch head = *q++ = *p++;
+    if (head.type.binary)
+      continue;
+    const watch tail = *q++ = *p++;
+    const reference ref = tail.large.ref;
+    if (ref < start)
+      continue;
+    clause *c = (clause *) (arena + ref);
+    if (c->garbage)
+      q -= 2;
+  }
+  SET_END_OF_WATCHES (*lit_watches, q);
+}
+
+void kissat_recycle_garbage_clauses (kissat *solver, reference start) {
+  assert (solver->watching);
+  assert (start != INVALID_REF);
+  INC (recycles);
+  kissat_clear_recycled_clauses (solver);
+  recycler *recycler = &solver->recycler;
+  mark *const marks = solver->marks;
+  unsigneds flush;
+  INIT_STACK (flush);
+  ward *const arena = BEGIN_STACK (solver->arena);
+  const clause *const end = (clause *) END_STACK (solver->arena);
+  for (clause *c = (clause *) (arena + start), *next; c != end; c = next) {
+    next = kissat_next_clause (c);
+    if (!c->garbage)
+      continue;
+    for (all_literals_in_clause (lit, c))
+      if (!marks[lit]) {
+        marks[lit] = 1;
+        PUSH_STACK (flush, lit);
+      }
+    if (!recyclable (c))
+      continue;
+    const size_t wards = (ward *) next - (ward *) c;
+    if (wards >= RECYCLE_CLASSES)
+      continue;
+    const reference ref = (ward *) c - arena;
+    PUSH_STACK (recycler->classes[wards], ref);
+    (void) kissat_delete_clause (solver, c);
+    recycler->slots++;
+    recycler->bytes += wards * sizeof (ward);
+  }
+  for (all_stack (unsigned, lit, flush)) {
+    assert (marks[lit]);
+    marks[lit] = 0;
+    flush_garbage_watches (solver, lit, start);
+  }
+  RELEASE_STACK (flush);
+  kissat_reset_last_learned (solver);
+  kissat_phase (solver, "recycle", GET (recycles),
+                "recycling %zu garbage clause slots %s", recycler->slots,
+                FORMAT_BYTES (recycler->bytes));
+}
+
+reference kissat_allocate_recycled_clause (kissat *solver, size_t size) {
+  recycler *recycler = &solver->recycler;
+  if (!recycler->slots)
+    return INVALID_REF;
+  const size_t bytes = kissat_bytes_of_clause (size);
+  const size_t wards = bytes / sizeof (ward);
+  if (wards >= RECYCLE_CLASSES)
+    return INVALID_REF;
+  references *slots = recycler->classes + wards;
+  if (EMPTY_STACK (*slots))
+    return INVALID_REF;
+  const reference res = POP_STACK (*slots);
+  recycler->slots--;
+  recycler->bytes -= bytes;
+#ifndef NDEBUG
+  clause *c = (clause *) (BEGIN_STACK (solver->arena) + res);
+  assert (kissat_clause_in_arena (solver, c));
+  assert (recyclable (c));
+  assert (kissat_actual_bytes_of_clause (c) == bytes);
+#endif
+  if (res < solver->vivify_activity_size)
+    solver->vivify_activity[res] = 0;
+  INC (recycled_clauses);
+  LOG ("recycled clause[%" REFERENCE_FORMAT "] of size %zu bytes %s", res,
+       size, FORMAT_BYTES (bytes));
+  return res;
+}
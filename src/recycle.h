@@ -0,0 +1,38 @@
+#ifndef _recycle_h_INCLUDED
+#define _recycle_h_INCLUDED
+
+#include "reference.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Instead of compacting the arena after every reduction the slots of
+// garbage redundant clauses can be kept on free lists segregated by their
+// size in arena words.  New redundant clauses are then placed into a slot
+// of exactly the same size (if there is one, otherwise they are appended
+// to the arena) and only every 'recycleint' reduction a full sparse
+// garbage collection is triggered.  The watches of all garbage clauses
+// behind the reduce start are flushed right away and recycled slots are
+// accounted as deleted when they are put on the free lists.  Slots which
+// are still unused when the lists are cleared before the next collection
+// are accounted as garbage again, since the collection deletes them.
+
+#define RECYCLE_CLASSES 32
+
+typedef struct recycler recycler;
+
+struct recycler {
+  size_t slots;
+  size_t bytes;
+  references classes[RECYCLE_CLASSES];
+};
+
+struct kissat;
+
+bool kissat_recycling (struct kissat *, bool compact);
+void kissat_recycle_garbage_clauses (struct kissat *, reference start);
+reference kissat_allocate_recycled_clause (struct kissat *, size_t size);
+void kissat_clear_recycled_clauses (struct kissat *);
+void kissat_release_recycled_clauses (struct kissat *);
+
+#endif
@@ -3,8 +3,10 @@
 #include "collect.h"
 #include "inline.h"
 #include "kimits.h"
+#include "pressure.h"
 #include "print.h"
 #include "rank.h"
+#include "recycle.h"
 #include "report.h"
 #include "resources.h"
 #include "tiers.h"
@@ -18,6 +20,8 @@ bool kissat_reducing (kissat *solver) {
     return false;
   if (!solver->statistics.clauses_redundant)
     return false;
+  if (kissat_forced_by_pressure (solver))
+    return true;
   if (CONFLICTS < solver->limits.reduce.conflicts)
     return false;
   return true;
@@ -61,8 +65,8 @@ static bool collect_reducibles (kissat *solver, reducibles *reds,
          (size_t) solver->first_reducible);
 #endif
   solver->first_reducible = redundant;
-  const unsigned tier1 = TIER1;
-  const unsigned tier2 = MAX (tier1, TIER2);
+  unsigned tier1, tier2;
+  kissat_get_reduce_tier_limits (solver, &tier1, &tier2);
   assert (tier1 <= tier2);
   for (clause *c = start; c != end; c = kissat_next_clause (c)) {
     if (!c->redundant)
@@ -112,6 +116,9 @@ static void mark_less_useful_clauses_as_garbage (kissat *solver,
     percent = high - delta / log10 (statistics->reductions + 9);
   } else
     percent = low;
+  const unsigned pressure = solver->pressure;
+  if (pressure)
+    percent += (100 - percent) * pressure / 4.0;
   const double fraction = percent / 100.0;
   const size_t size = SIZE_STACK (*reds);
   size_t target = size * fraction;
@@ -245,13 +252,21 @@ int kissat_reduce (kissat *solver) {
   
   START (reduce);
   INC (reductions);
+  kissat_clear_saved_trail (solver);
   kissat_phase (solver, "reduce", GET (reductions),
                 "reduce limit %" PRIu64 " hit after %" PRIu64 " conflicts",
                 solver->limits.reduce.conflicts, CONFLICTS);
+  if (solver->pressure) {
+    INC (memory_reductions);
+    kissat_phase (solver, "reduce", GET (reductions),
+                  "forced by memory pressure level %u", solver->pressure);
+  }
   kissat_compute_and_set_tier_limits (solver);
   bool compact = kissat_compacting (solver);
   reference start = compact ? 0 : solver->first_reducible;
   if (start != INVALID_REF) {
+    const bool recycle =
+        !solver->pressure && kissat_recycling (solver, compact);
 #ifndef QUIET
     size_t arena_size = SIZE_STACK (solver->arena);
     size_t words_to_sweep = arena_size - start;
@@ -272,7 +287,11 @@ int kissat_reduce (kissat *solver) {
         sort_reducibles (solver, &reds);
         mark_less_useful_clauses_as_garbage (solver, &reds);
         RELEASE_STACK (reds);
-        kissat_sparse_collect (solver, compact, start);
+        if (recycle) {
+          kissat_recycle_garbage_clauses (solver, start);
+          kissat_unmark_reason_clauses (solver, start);
+        } else
+          kissat_sparse_collect (solver, compact, start);
       } else if (compact)
         kissat_sparse_collect (solver, compact, start);
       else
@@ -281,6 +300,9 @@ int kissat_reduce (kissat *solver) {
       assert (solver->inconsistent);
   } else
     kissat_phase (solver, "reduce", GET (reductions), "nothing to reduce");
+  if (solver->pressure)
+    kissat_relieve_pressure (solver);
+  solver->last.arena.reduce = SIZE_STACK (solver->arena);
   kissat_classify (solver);
   
   // Calculate duration of this reduction
@@ -2,6 +2,7 @@
 #include "backtrack.h"
 #include "bump.h"
 #include "inline.h"
+#include "inlinebuckets.h"
 #include "inlineheap.h"
 #include "inlinequeue.h"
 #include "inlinevector.h"
@@ -190,6 +191,7 @@ static void reorder_stable (kissat *solver) {
     LOG ("updating score of %s to %g = %g (old score) + %g (weight)",
          LOGVAR (idx), new_score, old_score, weight);
     kissat_update_heap (solver, scores, idx, new_score);
+    kissat_update_bucket (solver, &solver->buckets, idx, new_score);
   }
   kissat_dealloc (solver, weights, LITS, sizeof *weights);
   RELEASE_STACK (sorted);
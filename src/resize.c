@@ -67,6 +67,7 @@ void kissat_increase_size (kissat *solver, unsigned new_size) {
 
   reallocate_trail (solver, old_size, new_size);
   kissat_resize_heap (solver, SCORES, new_size);
+  kissat_resize_buckets (solver, &solver->buckets, new_size);
   kissat_increase_phases (solver, new_size);
 
   solver->size = new_size;
@@ -96,6 +97,7 @@ void kissat_decrease_size (kissat *solver) {
 
   reallocate_trail (solver, old_size, new_size);
   kissat_resize_heap (solver, SCORES, new_size);
+  kissat_resize_buckets (solver, &solver->buckets, new_size);
   kissat_decrease_phases (solver, new_size);
 
   solver->size = new_size;
@@ -368,3 +368,178 @@ bool kissat_generate_resolvents (kissat *solver, unsigned idx,
 
   return !failed;
 }
+
+/*------------------------------------------------------------------------*/
+
+// The resolvent buffers of concurrent resolvers are allocated without
+// accounting them in the statistics of the solver ('solver' is zero).
+
+static inline void push_resolvent_literal (unsigneds *resolvents,
+                                           unsigned lit) {
+  struct kissat *const solver = 0;
+  PUSH_STACK (*resolvents, lit);
+}
+
+void kissat_release_resolver (resolver *resolver) {
+  struct kissat *const solver = 0;
+  RELEASE_STACK (resolver->resolvents);
+}
+
+static unsigned count_occurrences (kissat *solver, unsigned lit,
+                                   unsigned clslim) {
+  watches *const watches = &WATCHES (lit);
+  const value *const values = solver->values;
+  ward *const arena = BEGIN_STACK (solver->arena);
+  unsigned res = 0;
+  for (all_binary_large_watches (watch, *watches)) {
+    if (watch.type.binary) {
+      const unsigned other = watch.binary.lit;
+      if (values[other] <= 0)
+        res++;
+    } else {
+      const reference ref = watch.large.ref;
+      assert (ref < SIZE_STACK (solver->arena));
+      clause *const c = (struct clause *) (arena + ref);
+      if (c->garbage)
+        continue;
+      if (c->size > clslim)
+        return UINT_MAX;
+      res++;
+    }
+  }
+  return res;
+}
+
+static int resolve_occurrences (kissat *solver, value *const marks,
+                                resolver *resolver, uint64_t limit) {
+  const unsigned lit = resolver->lit;
+  const unsigned not_lit = NOT (lit);
+
+  clause tmp0, tmp1;
+  memset (&tmp0, 0, sizeof tmp0);
+  memset (&tmp1, 0, sizeof tmp1);
+  tmp0.size = tmp1.size = 2;
+
+  ward *const arena = BEGIN_STACK (solver->arena);
+  const value *const values = solver->values;
+  const unsigned clslim = GET_OPTION (eliminateclslim);
+
+  watches *const watches0 = &WATCHES (lit);
+  watches *const watches1 = &WATCHES (not_lit);
+  unsigneds *const resolvents = &resolver->resolvents;
+
+  uint64_t resolved = 0;
+  int status = RESOLVER_RESOLVED;
+
+  for (all_binary_large_watches (watch0, *watches0)) {
+    clause *const c = watch_to_clause (solver, arena, &tmp0, lit, watch0);
+    if (c->garbage)
+      continue;
+
+    bool first_antecedent_satisfied = false;
+    for (all_literals_in_clause (other, c))
+      if (other != lit && values[other] > 0) {
+        first_antecedent_satisfied = true;
+        break;
+      }
+    if (first_antecedent_satisfied)
+      continue;
+
+    for (all_literals_in_clause (other, c))
+      if (other != lit)
+        marks[other] = 1;
+
+    for (all_binary_large_watches (watch1, *watches1)) {
+      clause *const d =
+          watch_to_clause (solver, arena, &tmp1, not_lit, watch1);
+      if (d->garbage)
+        continue;
+
+      resolver->resolutions++;
+
+      bool resolvent_satisfied_or_tautological = false;
+      const size_t saved = SIZE_STACK (*resolvents);
+
+      for (all_literals_in_clause (other, d)) {
+        if (other == not_lit)
+          continue;
+        const value value = values[other];
+        if (value < 0)
+          continue;
+        if (value > 0 || marks[NOT (other)]) {
+          resolvent_satisfied_or_tautological = true;
+          break;
+        }
+        if (marks[other])
+          continue;
+        push_resolvent_literal (resolvents, other);
+      }
+
+      if (resolvent_satisfied_or_tautological) {
+        RESIZE_STACK (*resolvents, saved);
+        continue;
+      }
+
+      if (++resolved > limit) {
+        status = RESOLVER_SEQUENTIAL;
+        break;
+      }
+
+      for (all_literals_in_clause (other, c))
+        if (other != lit && !values[other])
+          push_resolvent_literal (resolvents, other);
+
+      // Units and the empty clause have immediate side effects on the
+      // formula and thus are left to sequential elimination.
+
+      const size_t size_resolvent = SIZE_STACK (*resolvents) - saved;
+      if (size_resolvent < 2 || size_resolvent > clslim) {
+        status = RESOLVER_SEQUENTIAL;
+        break;
+      }
+
+      push_resolvent_literal (resolvents, INVALID_LIT);
+    }
+
+    for (all_literals_in_clause (other, c))
+      if (other != lit)
+        marks[other] = 0;
+
+    if (status != RESOLVER_RESOLVED)
+      break;
+  }
+
+  return status;
+}
+
+void kissat_resolve_concurrently (kissat *solver, value *marks,
+                                  resolver *resolver) {
+  CLEAR_STACK (resolver->resolvents);
+  resolver->resolutions = 0;
+
+  const unsigned clslim = GET_OPTION (eliminateclslim);
+  unsigned lit = LIT (resolver->idx);
+  unsigned not_lit = NOT (lit);
+  unsigned pos_count = count_occurrences (solver, lit, clslim);
+  unsigned neg_count = count_occurrences (solver, not_lit, clslim);
+  if (pos_count > neg_count) {
+    SWAP (unsigned, lit, not_lit);
+    SWAP (unsigned, pos_count, neg_count);
+  }
+  resolver->lit = lit;
+
+  const unsigned occlim = GET_OPTION (eliminateocclim);
+  uint64_t limit = pos_count + (uint64_t) neg_count;
+  if (pos_count && limit > occlim) {
+    resolver->status = RESOLVER_FAILED;
+    return;
+  }
+  if (!pos_count) {
+    resolver->status = RESOLVER_RESOLVED;
+    return;
+  }
+  limit += solver->bounds.eliminate.additional_clauses;
+  resolver->status = resolve_occurrences (solver, marks, resolver, limit);
+  if (resolver->status != RESOLVER_RESOLVED)
+    CLEAR_STACK (resolver->resolvents);
+}
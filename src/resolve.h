@@ -1,11 +1,39 @@
 #ifndef _resolve_h_INCLUDED
 #define _resolve_h_INCLUDED
 
+#include "stack.h"
+#include "value.h"
+
 #include <stdbool.h>
+#include <stdint.h>
 
 struct kissat;
 
 bool kissat_generate_resolvents (struct kissat *, unsigned idx,
                                  unsigned *lit_ptr);
 
+// Read-only variant of resolvent generation without gate extraction,
+// which is safe to run concurrently for candidates that do not occur
+// together in any clause.  Resolvents are separated by 'INVALID_LIT'.
+
+typedef struct resolver resolver;
+
+enum resolver_status {
+  RESOLVER_FAILED = 0,
+  RESOLVER_RESOLVED = 1,
+  RESOLVER_SEQUENTIAL = 2,
+};
+
+struct resolver {
+  unsigned idx;
+  unsigned lit;
+  int status;
+  uint64_t resolutions;
+  unsigneds resolvents;
+};
+
+void kissat_resolve_concurrently (struct kissat *, value *marks,
+                                  resolver *);
+void kissat_release_resolver (resolver *);
+
 #endif
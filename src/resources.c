@@ -1,6 +1,11 @@
 #include "resources.h"
 
+#include <inttypes.h>
+#include <stdio.h>
+#include <sys/resource.h>
 #include <sys/time.h>
+#include <sys/types.h>
+#include <unistd.h>
 
 double kissat_wall_clock_time (void) {
   struct timeval tv;
@@ -9,19 +14,6 @@ double kissat_wall_clock_time (void) {
   return 1e-6 * tv.tv_usec + tv.tv_sec;
 }
 
-#ifndef QUIET
-
-#include "internal.h"
-#include "statistics.h"
-#include "utilities.h"
-
-#include <inttypes.h>
-#include <stdio.h>
-#include <string.h>
-#include <sys/resource.h>
-#include <sys/types.h>
-#include <unistd.h>
-
 double kissat_process_time (void) {
   struct rusage u;
   double res;
@@ -32,13 +24,6 @@ double kissat_process_time (void) {
   return res;
 }
 
-uint64_t kissat_maximum_resident_set_size (void) {
-  struct rusage u;
-  if (getrusage (RUSAGE_SELF, &u))
-    return 0;
-  return ((uint64_t) u.ru_maxrss) << 10;
-}
-
 #ifdef __APPLE__
 
 #include <mach/task.h>
@@ -69,6 +54,21 @@ uint64_t kissat_current_resident_set_size (void) {
 
 #endif
 
+#ifndef QUIET
+
+#include "internal.h"
+#include "statistics.h"
+#include "utilities.h"
+
+#include <string.h>
+
+uint64_t kissat_maximum_resident_set_size (void) {
+  struct rusage u;
+  if (getrusage (RUSAGE_SELF, &u))
+    return 0;
+  return ((uint64_t) u.ru_maxrss) << 10;
+}
+
 void kissat_print_resources (kissat *solver) {
   uint64_t rss = kissat_maximum_resident_set_size ();
   double t = kissat_time (solver);
@@ -213,11 +213,16 @@ void kissat_restart (kissat *solver) {
   else
     INC (focused_restarts);
   unsigned level = reuse_trail (solver);
+  const unsigned assumed = SIZE_STACK (solver->assumptions);
+  if (level < assumed)
+    level = MIN (assumed, solver->level);
   kissat_extremely_verbose (solver,
                             "restarting after %" PRIu64 " conflicts"
                             " (limit %" PRIu64 ")",
                             CONFLICTS, solver->limits.restart.conflicts);
   LOG ("restarting to level %u", level);
+  if (level < solver->level)
+    kissat_save_trail (solver, level, true);
   kissat_backtrack_in_consistent_state (solver, level);
   if (!solver->stable)
     kissat_update_focused_restart_limit (solver);
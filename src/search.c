@@ -5,6 +5,7 @@
 #include "classify.h"
 #include "decide.h"
 #include "eliminate.h"
+#include "incremental.h"
 #include "inline.h"
 #include "internal.h"
 #include "logging.h"
@@ -19,6 +20,8 @@
 #include "rephase.h"
 #include "report.h"
 #include "restart.h"
+#include "share.h"
+#include "snapshot.h"
 #include "terminate.h"
 #include "trail.h"
 #include "walk.h"
@@ -65,7 +68,8 @@ static void start_search (kissat *solver) {
   if (solver->stable) {
     kissat_init_reluctant (solver);
     kissat_update_scores (solver);
-  }
+  } else if (GET (searches) > 1 && solver->active)
+    kissat_reset_search_of_queue (solver);
 
   init_tiers (solver);
 
@@ -190,6 +194,8 @@ int kissat_search (kissat *solver) {
     res = kissat_lucky (solver);
   if (!res && kissat_preprocessing (solver))
     res = kissat_preprocess (solver);
+  if (res != 10 && solver->snapshot)
+    kissat_write_preprocessed_snapshot (solver);
   if (!res && GET_OPTION (luckylate))
     res = kissat_lucky (solver);
   if (!res)
@@ -202,6 +208,8 @@ int kissat_search (kissat *solver) {
         res = kissat_analyze (solver, conflict);
       else if (solver->iterating)
         iterate (solver);
+      else if (kissat_assuming (solver))
+        res = kissat_decide_assumption (solver);
       else if (!solver->unassigned)
         res = 10;
       else if (TERMINATED (search_terminated_1))
@@ -210,6 +218,8 @@ int kissat_search (kissat *solver) {
         res = kissat_reduce (solver);
       else if (kissat_switching_search_mode (solver))
         kissat_switch_search_mode (solver);
+      else if (kissat_importing (solver))
+        res = kissat_import_shared (solver);
       else if (kissat_restarting (solver))
         kissat_restart (solver);
       else if (kissat_reordering (solver))
@@ -0,0 +1,360 @@
+#include "share.h"
+#include "allocate.h"
+#include "backtrack.h"
+#include "inline.h"
+#include "internal.h"
+#include "logging.h"
+#include "require.h"
+
+#include <string.h>
+
+shared_pool *kissat_new_shared_pool (unsigned size) {
+  assert (size);
+  shared_pool *pool = kissat_calloc (0, 1, sizeof *pool);
+  pool->rings = kissat_calloc (0, size, sizeof *pool->rings);
+  pool->size = size;
+  return pool;
+}
+
+void kissat_delete_shared_pool (shared_pool *pool) {
+  kissat_dealloc (0, pool->rings, pool->size, sizeof *pool->rings);
+  kissat_free (0, pool, sizeof *pool);
+}
+
+void kissat_connect_sharer (kissat *solver, shared_pool *pool,
+                            unsigned id) {
+  assert (!solver->sharer);
+  assert (id < pool->size);
+  sharer *sharer = kissat_calloc (solver, 1, sizeof *sharer);
+  sharer->pool = pool;
+  sharer->id = id;
+  sharer->positions =
+      kissat_calloc (solver, pool->size, sizeof *sharer->positions);
+  solver->sharer = sharer;
+  solver->limits.share.conflicts = GET_OPTION (shareint);
+}
+
+void kissat_disconnect_sharer (kissat *solver) {
+  sharer *sharer = solver->sharer;
+  if (!sharer)
+    return;
+  kissat_dealloc (solver, sharer->positions, sharer->pool->size,
+                  sizeof *sharer->positions);
+  kissat_free (solver, sharer, sizeof *sharer);
+  solver->sharer = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Only the owning solver thread writes to its ring.  It first announces
+// the end of the record it is about to write in 'reserved', then writes
+// the literals and finally publishes the record by moving 'head'.  The
+// release fence orders 'reserved' before any of the overwritten words.
+
+static inline void write_word (shared_ring *ring, uint64_t pos, int word) {
+  int *p = ring->lits + (pos & (SHARE_RING_SIZE - 1));
+  __atomic_store_n (p, word, __ATOMIC_RELAXED);
+}
+
+static inline int read_word (shared_ring *ring, uint64_t pos) {
+  int *p = ring->lits + (pos & (SHARE_RING_SIZE - 1));
+  return __atomic_load_n (p, __ATOMIC_RELAXED);
+}
+
+static void publish (shared_ring *ring, unsigned size, unsigned glue,
+                     const int *elits) {
+  assert (size <= SHARE_MAX_SIZE);
+  const uint64_t head = __atomic_load_n (&ring->head, __ATOMIC_RELAXED);
+  const uint64_t end = head + size + 2;
+  __atomic_store_n (&ring->reserved, end, __ATOMIC_RELAXED);
+  __atomic_thread_fence (__ATOMIC_RELEASE);
+  uint64_t pos = head;
+  write_word (ring, pos++, (int) size);
+  write_word (ring, pos++, (int) glue);
+  for (unsigned i = 0; i != size; i++)
+    write_word (ring, pos++, elits[i]);
+  assert (pos == end);
+  __atomic_store_n (&ring->head, end, __ATOMIC_RELEASE);
+}
+
+static shared_ring *own_ring (sharer *sharer) {
+  return sharer->pool->rings + sharer->id;
+}
+
+static bool exportable_literal (kissat *solver, unsigned ilit, int *elit) {
+  const int res = kissat_export_literal (solver, ilit);
+  if (!res)
+    return false;
+  const unsigned eidx = ABS (res);
+  const import *const import = &PEEK_STACK (solver->import, eidx);
+  if (import->extension)
+    return false;
+  *elit = res;
+  return true;
+}
+
+static void share_learned_clause (kissat *solver, sharer *sharer,
+                                  unsigned size, unsigned glue) {
+  if (size > (unsigned) GET_OPTION (sharesize))
+    return;
+  if (glue > (unsigned) GET_OPTION (shareglue))
+    return;
+  assert (size <= SHARE_MAX_SIZE);
+  int elits[SHARE_MAX_SIZE];
+  int *q = elits;
+  for (all_stack (unsigned, ilit, solver->clause))
+    if (!exportable_literal (solver, ilit, q++))
+      return;
+  publish (own_ring (sharer), size, glue, elits);
+  INC (shared_exported);
+}
+
+// The 'learn' callback of 'kissat_set_learn' gets zero terminated clauses
+// of external literals, which are collected on a stack kept in 'learner'.
+
+static void learn_learned_clause (kissat *solver, learner *learner,
+                                  unsigned size, unsigned glue) {
+  if (size > learner->max_length)
+    return;
+  const unsigned max_glue = GET_OPTION (learnglue);
+  if (max_glue && glue > max_glue)
+    return;
+  ints *elits = &learner->clause;
+  assert (EMPTY_STACK (*elits));
+  for (all_stack (unsigned, ilit, solver->clause)) {
+    int elit;
+    if (!exportable_literal (solver, ilit, &elit)) {
+      CLEAR_STACK (*elits);
+      return;
+    }
+    PUSH_STACK (*elits, elit);
+  }
+  PUSH_STACK (*elits, 0);
+  learner->learn (learner->state, BEGIN_STACK (*elits));
+  CLEAR_STACK (*elits);
+  INC (shared_exported);
+}
+
+void kissat_export_learned_clause (kissat *solver, unsigned glue) {
+  const unsigned size = SIZE_STACK (solver->clause);
+  if (size < 2)
+    return;
+  sharer *sharer = solver->sharer;
+  if (sharer)
+    share_learned_clause (solver, sharer, size, glue);
+  learner *learner = &solver->learner;
+  if (learner->learn)
+    learn_learned_clause (solver, learner, size, glue);
+}
+
+static void export_units (kissat *solver, sharer *sharer) {
+  shared_ring *ring = own_ring (sharer);
+  const size_t size = SIZE_STACK (solver->units);
+  while (sharer->units < size) {
+    const int elit = PEEK_STACK (solver->units, sharer->units);
+    sharer->units++;
+    const unsigned eidx = ABS (elit);
+    const import *const import = &PEEK_STACK (solver->import, eidx);
+    if (import->extension)
+      continue;
+    publish (ring, 1, 0, &elit);
+    INC (shared_exported);
+  }
+}
+
+static void learn_units (kissat *solver, learner *learner) {
+  const size_t size = SIZE_STACK (solver->units);
+  while (learner->units < size) {
+    const int elit = PEEK_STACK (solver->units, learner->units);
+    learner->units++;
+    if (!learner->max_length)
+      continue;
+    const unsigned eidx = ABS (elit);
+    const import *const import = &PEEK_STACK (solver->import, eidx);
+    if (import->extension)
+      continue;
+    int unit[2] = {elit, 0};
+    learner->learn (learner->state, unit);
+    INC (shared_exported);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+bool kissat_importing (kissat *solver) {
+  if (!solver->sharer && !solver->learner.learn &&
+      !solver->importer.import)
+    return false;
+  return CONFLICTS >= solver->limits.share.conflicts;
+}
+
+static bool pending (sharer *sharer) {
+  shared_pool *pool = sharer->pool;
+  for (unsigned id = 0; id != pool->size; id++) {
+    if (id == sharer->id)
+      continue;
+    shared_ring *ring = pool->rings + id;
+    const uint64_t head = __atomic_load_n (&ring->head, __ATOMIC_ACQUIRE);
+    if (head != sharer->positions[id])
+      return true;
+  }
+  return false;
+}
+
+static void import_clause (kissat *solver, unsigned size, unsigned glue,
+                           const int *elits) {
+  assert (!solver->level);
+  assert (EMPTY_STACK (solver->clause));
+  const size_t imported = SIZE_STACK (solver->import);
+  const value *const values = solver->values;
+  const flags *const all_flags = solver->flags;
+  value *const marks = solver->marks;
+  bool skip = false;
+  for (unsigned i = 0; !skip && i != size; i++) {
+    const int elit = elits[i];
+    const unsigned eidx = ABS (elit);
+    if (!eidx || eidx >= imported) {
+      skip = true;
+      continue;
+    }
+    const import *const import = &PEEK_STACK (solver->import, eidx);
+    if (!import->imported || import->eliminated || import->extension) {
+      skip = true;
+      continue;
+    }
+    unsigned ilit = import->lit;
+    if (elit < 0)
+      ilit = NOT (ilit);
+    const value value = values[ilit];
+    if (value > 0)
+      skip = true;
+    else if (value < 0)
+      continue;
+    else if (!all_flags[IDX (ilit)].active)
+      skip = true;
+    else if (marks[NOT (ilit)])
+      skip = true;
+    else if (!marks[ilit]) {
+      marks[ilit] = 1;
+      PUSH_STACK (solver->clause, ilit);
+    }
+  }
+  for (all_stack (unsigned, ilit, solver->clause))
+    marks[ilit] = 0;
+  if (!skip) {
+    ADD_UNCHECKED_EXTERNAL (size, elits);
+    const unsigned simplified = SIZE_STACK (solver->clause);
+    if (!simplified) {
+      LOG ("imported shared clause falsified at the root level");
+      solver->inconsistent = true;
+      CHECK_AND_ADD_EMPTY ();
+      ADD_EMPTY_TO_PROOF ();
+    } else if (simplified == 1) {
+      const unsigned unit = PEEK_STACK (solver->clause, 0);
+      LOG ("importing shared unit %s", LOGLIT (unit));
+      kissat_learned_unit (solver, unit);
+      INC (shared_imported_units);
+    } else {
+      if (glue >= simplified)
+        glue = simplified - 1;
+      if (!glue)
+        glue = 1;
+      const reference ref = kissat_new_redundant_clause (solver, glue);
+      if (ref != INVALID_REF) {
+        clause *c = kissat_dereference_clause (solver, ref);
+        c->used = 1;
+      }
+      INC (shared_imported);
+    }
+  }
+  CLEAR_STACK (solver->clause);
+}
+
+// Readers copy a record and then check whether the writer meanwhile
+// reserved space overlapping with it.  If so the copy is discarded and the
+// reader continues at the (always record aligned) reserved position.
+
+static uint64_t resync (shared_ring *ring) {
+  __atomic_thread_fence (__ATOMIC_ACQUIRE);
+  return __atomic_load_n (&ring->reserved, __ATOMIC_RELAXED);
+}
+
+static void import_ring (kissat *solver, shared_ring *ring,
+                         uint64_t *position) {
+  const uint64_t head = __atomic_load_n (&ring->head, __ATOMIC_ACQUIRE);
+  uint64_t pos = *position;
+  if (head - pos > SHARE_RING_SIZE)
+    pos = resync (ring);
+  int elits[SHARE_MAX_SIZE];
+  while (!solver->inconsistent && pos < head) {
+    const int size = read_word (ring, pos);
+    const int glue = read_word (ring, pos + 1);
+    const uint64_t end = pos + 2 + (unsigned) size;
+    if (size < 1 || size > SHARE_MAX_SIZE || end > head) {
+      pos = resync (ring);
+      break;
+    }
+    for (int i = 0; i != size; i++)
+      elits[i] = read_word (ring, pos + 2 + i);
+    if (resync (ring) > pos + SHARE_RING_SIZE) {
+      pos = resync (ring);
+      break;
+    }
+    import_clause (solver, (unsigned) size, (unsigned) glue, elits);
+    pos = end;
+  }
+  *position = pos;
+}
+
+static void import_pool (kissat *solver, sharer *sharer) {
+  export_units (solver, sharer);
+  if (!pending (sharer))
+    return;
+  INC (shared_imports);
+  if (solver->level)
+    kissat_backtrack_in_consistent_state (solver, 0);
+  shared_pool *pool = sharer->pool;
+  for (unsigned id = 0; !solver->inconsistent && id != pool->size; id++)
+    if (id != sharer->id)
+      import_ring (solver, pool->rings + id, sharer->positions + id);
+  sharer->units = SIZE_STACK (solver->units);
+}
+
+// Clauses are pulled from the 'import' callback of 'kissat_set_import'
+// until it returns 'NULL'.  We only backtrack if there is a clause.  The
+// imported clauses come without justification and thus importing is
+// rejected while tracing or checking proofs.
+
+static void import_external (kissat *solver, importer *importer) {
+  const int *elits;
+  int glue = 0;
+  bool imported = false;
+  assert (!kissat_proving (solver));
+  while (!solver->inconsistent &&
+         (elits = importer->import (importer->state, &glue))) {
+    if (!imported) {
+      INC (shared_imports);
+      if (solver->level)
+        kissat_backtrack_in_consistent_state (solver, 0);
+      imported = true;
+    }
+    unsigned size = 0;
+    for (int elit; (elit = elits[size]); size++)
+      kissat_require_valid_external_internal (elit);
+    import_clause (solver, size, glue < 1 ? 1 : (unsigned) glue, elits);
+  }
+}
+
+int kissat_import_shared (kissat *solver) {
+  sharer *sharer = solver->sharer;
+  if (sharer)
+    import_pool (solver, sharer);
+  learner *learner = &solver->learner;
+  if (learner->learn)
+    learn_units (solver, learner);
+  importer *importer = &solver->importer;
+  if (!solver->inconsistent && importer->import)
+    import_external (solver, importer);
+  solver->limits.share.conflicts = CONFLICTS + GET_OPTION (shareint);
+  return solver->inconsistent ? 20 : 0;
+}
@@ -0,0 +1,60 @@
+#ifndef _share_h_INCLUDED
+#define _share_h_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Lock-free pool of short learned clauses and units exchanged between
+// the solvers of a portfolio (see 'portfolio.c').  Every solver owns one
+// ring buffer of external literals into which only its own thread writes.
+// All other solvers read from it optimistically without taking a lock and
+// afterwards check (seqlock style) that the writer did not wrap around
+// and overwrite the record they just copied.  In that case the reader
+// simply skips ahead, since losing shared clauses is harmless.  A record
+// consists of '<size> <glue> <lit_1> ... <lit_size>'.  For sharing with
+// external solvers learned clauses are also passed to the 'learn' callback
+// of 'kissat_set_learn' (units at import points) and at import points
+// clauses are pulled from the 'import' callback of 'kissat_set_import'.
+
+#define SHARE_RING_LOG2 16
+#define SHARE_RING_SIZE (1u << SHARE_RING_LOG2)
+#define SHARE_MAX_SIZE 64
+
+typedef struct shared_pool shared_pool;
+typedef struct shared_ring shared_ring;
+typedef struct sharer sharer;
+
+struct shared_ring {
+  uint64_t reserved;
+  uint64_t head;
+  char padding[64 - 2 * sizeof (uint64_t)];
+  int lits[SHARE_RING_SIZE];
+};
+
+struct shared_pool {
+  unsigned size;
+  shared_ring *rings;
+};
+
+struct sharer {
+  shared_pool *pool;
+  unsigned id;
+  size_t units;
+  uint64_t *positions;
+};
+
+struct kissat;
+
+shared_pool *kissat_new_shared_pool (unsigned size);
+void kissat_delete_shared_pool (shared_pool *);
+
+void kissat_connect_sharer (struct kissat *, shared_pool *, unsigned id);
+void kissat_disconnect_sharer (struct kissat *);
+
+void kissat_export_learned_clause (struct kissat *, unsigned glue);
+
+bool kissat_importing (struct kissat *);
+int kissat_import_shared (struct kissat *);
+
+#endif
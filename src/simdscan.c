@@ -912,3 +912,47 @@ bool kissat_simd_analyze_conflict_literals (kissat *solver,
   *out_analyzed_count = count;
   return false;
 }
+
+// ============================================================
+// LOCAL SEARCH BREAK VALUES
+// Count clause indices 'ref' with counts[ref] == 1
+// ============================================================
+
+unsigned kissat_simd_count_critical (const unsigned *counts,
+                                     const unsigned *refs,
+                                     size_t size) {
+  unsigned count = 0;
+  size_t i = 0;
+
+#if KISSAT_HAS_AVX512
+  if (size >= 16 && cpu_features.avx512f) {
+    const __m512i ones = _mm512_set1_epi32 (1);
+    for (; i + 16 <= size; i += 16) {
+      __m512i indices = _mm512_loadu_si512 ((__m512i *)(refs + i));
+      __m512i gathered = _mm512_i32gather_epi32 (indices, counts, 4);
+      __mmask16 critical = _mm512_cmpeq_epi32_mask (gathered, ones);
+      count += __builtin_popcount (critical);
+    }
+  }
+#endif
+
+#if KISSAT_HAS_AVX2
+  if (size - i >= 8 && cpu_features.avx2) {
+    const __m256i ones = _mm256_set1_epi32 (1);
+    for (; i + 8 <= size; i += 8) {
+      __m256i indices = _mm256_loadu_si256 ((__m256i *)(refs + i));
+      __m256i gathered =
+          _mm256_i32gather_epi32 ((const int *)counts, indices, 4);
+      __m256i critical = _mm256_cmpeq_epi32 (gathered, ones);
+      count += __builtin_popcount (
+          _mm256_movemask_ps (_mm256_castsi256_ps (critical)));
+    }
+  }
+#endif
+
+  // Scalar remainder (and fallback)
+  for (; i < size; i++)
+    count += (counts[refs[i]] == 1);
+
+  return count;
+}
@@ -83,6 +83,19 @@ size_t kissat_simd_count_false (const value *values,
                                  const unsigned *lits,
                                  size_t size);
 
+/*
+ * Count critical clauses for local search break values
+ * Gathers the number of true literals of each referenced clause
+ *
+ * @param counts - number of true literals per clause
+ * @param refs - array of clause indices (occurrences of a literal)
+ * @param size - number of clause indices
+ * @return count of clause indices where counts[ref] == 1
+ */
+unsigned kissat_simd_count_critical (const unsigned *counts,
+                                     const unsigned *refs,
+                                     size_t size);
+
 /*
  * Check if all literals in a range are false (for subsumption checking)
  * Uses AVX-512 VPTEST for parallel comparison
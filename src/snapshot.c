@@ -0,0 +1,431 @@
+#include "snapshot.h"
+#include "allocate.h"
+#include "error.h"
+#include "file.h"
+#include "import.h"
+#include "inline.h"
+#include "internal.h"
+#include "preprocess.h"
+#include "print.h"
+#include "resize.h"
+
+#include <limits.h>
+#include <string.h>
+
+// A snapshot consists of a fixed size header followed by sections of
+// 32-bit words in the order of the counts in the header: the encoded
+// import map, the values of eliminated variables, root-level units, pairs
+// of binary clause literals, zero terminated large clauses and finally
+// the encoded extension stack.  Literals are external literals, such that
+// restoring a snapshot does not depend on the internal variable order nor
+// on the memory layout of the arena and watches of the writing solver.
+
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_ENDIANNESS 0x01020304u
+
+#define IMPORT_NONE 0
+#define IMPORT_ORIGINAL 1
+#define IMPORT_EXTENSION 2
+#define IMPORT_ELIMINATED 3
+
+static const char snapshot_magic[8] = "KISSNAP";
+
+typedef struct snapshot_header snapshot_header;
+typedef struct snapshot_writer snapshot_writer;
+
+struct snapshot_header {
+  char magic[8];
+  uint32_t version;
+  uint32_t endianness;
+  uint32_t preprocessed;
+  uint32_t max_var;
+  uint32_t variables;
+  uint32_t eliminated;
+  uint64_t units;
+  uint64_t binaries;
+  uint64_t literals;
+  uint64_t extend;
+};
+
+#define SIZE_WRITER (1u << 12)
+
+struct snapshot_writer {
+  file *file;
+  bool ok;
+  unsigned size;
+  uint32_t words[SIZE_WRITER];
+};
+
+static void flush_words (snapshot_writer *writer) {
+  const size_t bytes = writer->size * sizeof (uint32_t);
+  if (kissat_write (writer->file, writer->words, bytes) != bytes)
+    writer->ok = false;
+  writer->size = 0;
+}
+
+static inline void write_word (snapshot_writer *writer, uint32_t word) {
+  if (writer->size == SIZE_WRITER)
+    flush_words (writer);
+  writer->words[writer->size++] = word;
+}
+
+static inline void write_literal (snapshot_writer *writer, int elit) {
+  write_word (writer, (uint32_t) elit);
+}
+
+static uint32_t encode_import (const import *import) {
+  if (!import->imported)
+    return IMPORT_NONE;
+  if (import->eliminated)
+    return (import->lit << 2) | IMPORT_ELIMINATED;
+  return import->extension ? IMPORT_EXTENSION : IMPORT_ORIGINAL;
+}
+
+static uint32_t encode_extension (extension ext) {
+  return (uint32_t) (2 * ext.lit + ext.blocking);
+}
+
+static unsigned max_original_variable (kissat *solver) {
+  unsigned res = SIZE_STACK (solver->import);
+  while (res > 1 && PEEK_STACK (solver->import, res - 1).extension)
+    res--;
+  return res ? res - 1 : 0;
+}
+
+static uint64_t export_units (kissat *solver, snapshot_writer *writer) {
+  const value *const values = solver->values;
+  const import *const begin = BEGIN_STACK (solver->import);
+  const import *const end = END_STACK (solver->import);
+  uint64_t units = 0;
+  for (const import *p = begin; p != end; p++) {
+    if (!p->imported || p->eliminated)
+      continue;
+    const value value = values[p->lit];
+    if (!value)
+      continue;
+    units++;
+    if (writer) {
+      const int eidx = p - begin;
+      write_literal (writer, value < 0 ? -eidx : eidx);
+    }
+  }
+  return units;
+}
+
+static inline void export_binary (kissat *solver, snapshot_writer *writer,
+                                  unsigned ilit, unsigned iother) {
+  write_literal (writer, kissat_export_literal (solver, ilit));
+  write_literal (writer, kissat_export_literal (solver, iother));
+}
+
+static uint64_t export_binaries (kissat *solver, snapshot_writer *writer) {
+  uint64_t binaries = 0;
+  if (solver->watching) {
+    for (all_literals (ilit))
+      for (all_binary_blocking_watches (watch, WATCHES (ilit)))
+        if (watch.type.binary) {
+          const unsigned iother = watch.binary.lit;
+          if (iother < ilit)
+            continue;
+          if (writer)
+            export_binary (solver, writer, ilit, iother);
+          binaries++;
+        }
+  } else {
+    for (all_literals (ilit))
+      for (all_binary_large_watches (watch, WATCHES (ilit)))
+        if (watch.type.binary) {
+          const unsigned iother = watch.binary.lit;
+          if (iother < ilit)
+            continue;
+          if (writer)
+            export_binary (solver, writer, ilit, iother);
+          binaries++;
+        }
+  }
+  return binaries;
+}
+
+static uint64_t export_clauses (kissat *solver, snapshot_writer *writer) {
+  uint64_t literals = 0;
+  for (all_clauses (c)) {
+    if (c->garbage || c->redundant)
+      continue;
+    if (writer) {
+      for (all_literals_in_clause (ilit, c))
+        write_literal (writer, kissat_export_literal (solver, ilit));
+      write_literal (writer, 0);
+    }
+    literals += c->size + 1;
+  }
+  return literals;
+}
+
+bool kissat_write_snapshot (kissat *solver, file *file,
+                            bool preprocessed) {
+  assert (!solver->level);
+  snapshot_header header;
+  memset (&header, 0, sizeof header);
+  memcpy (header.magic, snapshot_magic, sizeof header.magic);
+  header.version = SNAPSHOT_VERSION;
+  header.endianness = SNAPSHOT_ENDIANNESS;
+  header.preprocessed = preprocessed;
+  header.max_var = max_original_variable (solver);
+  header.variables = SIZE_STACK (solver->import);
+  header.eliminated = SIZE_STACK (solver->eliminated);
+  if (solver->inconsistent)
+    header.literals = 1;
+  else {
+    header.units = export_units (solver, 0);
+    header.binaries = export_binaries (solver, 0);
+    header.literals = export_clauses (solver, 0);
+  }
+  header.extend = SIZE_STACK (solver->extend);
+  if (kissat_write (file, &header, sizeof header) != sizeof header)
+    return false;
+  snapshot_writer writer;
+  writer.file = file;
+  writer.ok = true;
+  writer.size = 0;
+  for (all_stack (import, import, solver->import))
+    write_word (&writer, encode_import (&import));
+  for (all_stack (value, value, solver->eliminated))
+    write_literal (&writer, value);
+  if (solver->inconsistent)
+    write_literal (&writer, 0);
+  else {
+    export_units (solver, &writer);
+    export_binaries (solver, &writer);
+    export_clauses (solver, &writer);
+  }
+  for (all_stack (extension, ext, solver->extend))
+    write_word (&writer, encode_extension (ext));
+  flush_words (&writer);
+  kissat_flush (file);
+  return writer.ok;
+}
+
+void kissat_write_preprocessed_snapshot (kissat *solver) {
+  const char *path = solver->snapshot;
+  assert (path);
+  solver->snapshot = 0;
+  const bool preprocessed =
+      solver->inconsistent || kissat_preprocessing (solver);
+  file file;
+  if (!kissat_open_to_write_file (&file, path))
+    kissat_fatal ("failed to open snapshot '%s' for writing", path);
+  if (!kissat_write_snapshot (solver, &file, preprocessed))
+    kissat_fatal ("failed to write snapshot '%s'", path);
+#ifndef QUIET
+  kissat_message (solver, "wrote %s snapshot of %s to '%s'",
+                  preprocessed ? "preprocessed" : "unpreprocessed",
+                  FORMAT_BYTES (file.bytes), path);
+#endif
+  kissat_close_file (&file);
+}
+
+static bool valid_literal (const uint32_t *imports, uint32_t variables,
+                           int elit, bool eliminated) {
+  if (!elit || elit == INT_MIN)
+    return false;
+  const unsigned eidx = ABS (elit);
+  if (eidx >= variables)
+    return false;
+  const unsigned tag = imports[eidx] & 3;
+  if (tag == IMPORT_NONE)
+    return false;
+  if (tag == IMPORT_ELIMINATED)
+    return eliminated;
+  return !eliminated;
+}
+
+static const char *check_snapshot (kissat *solver,
+                                   const snapshot_header *header,
+                                   const uint32_t *words) {
+  const uint32_t variables = header->variables;
+  const uint32_t *const imports = words;
+  if (variables && imports[0] != IMPORT_NONE)
+    return "invalid import of variable zero";
+  const uint32_t eliminated = header->eliminated;
+  bool *used = kissat_calloc (solver, eliminated, sizeof *used);
+  const char *error = 0;
+  for (uint32_t eidx = 1; !error && eidx < variables; eidx++) {
+    const uint32_t code = imports[eidx];
+    if ((code & 3) == IMPORT_ELIMINATED) {
+      const uint32_t pos = code >> 2;
+      if (pos >= eliminated || used[pos])
+        error = "invalid eliminated variable";
+      else
+        used[pos] = true;
+    } else if (code > IMPORT_EXTENSION)
+      error = "invalid import code";
+  }
+  kissat_dealloc (solver, used, eliminated, sizeof *used);
+  if (error)
+    return error;
+  const int *values = (const int *) imports + variables;
+  for (uint32_t pos = 0; pos < eliminated; pos++)
+    if (values[pos] < -1 || values[pos] > 1)
+      return "invalid eliminated value";
+  const int *lits = values + eliminated;
+  const uint64_t literals = 2 * header->binaries + header->units;
+  for (uint64_t i = 0; i < literals; i++)
+    if (!valid_literal (imports, variables, lits[i], false))
+      return "invalid unit or binary clause literal";
+  lits += literals;
+  for (uint64_t i = 0; i < header->literals; i++)
+    if (lits[i] && !valid_literal (imports, variables, lits[i], false))
+      return "invalid large clause literal";
+  if (header->literals && lits[header->literals - 1])
+    return "large clause not terminated";
+  const uint32_t *extend = (const uint32_t *) lits + header->literals;
+  for (uint64_t i = 0; i < header->extend; i++) {
+    const int word = (int) extend[i];
+    const bool blocking = word & 1;
+    const int elit = (word - blocking) / 2;
+    const bool active = valid_literal (imports, variables, elit, false);
+    const bool eliminated = valid_literal (imports, variables, elit, true);
+    if (blocking ? !eliminated : !active && !eliminated)
+      return "invalid extension literal";
+    if (!i && !blocking)
+      return "extension stack does not start with blocking literal";
+  }
+  return 0;
+}
+
+static void add_literals (kissat *solver, size_t size, const int *lits) {
+  for (size_t i = 0; i < size; i++)
+    kissat_add (solver, lits[i]);
+  kissat_add (solver, 0);
+}
+
+static void restore_snapshot (kissat *solver, const snapshot_header *header,
+                              const uint32_t *words) {
+  const uint32_t variables = header->variables;
+  const uint32_t *const imports = words;
+  unsigned active = 0;
+  for (uint32_t eidx = 1; eidx < variables; eidx++) {
+    const unsigned tag = imports[eidx] & 3;
+    if (tag == IMPORT_ORIGINAL || tag == IMPORT_EXTENSION)
+      active++;
+  }
+  kissat_increase_size (solver, active);
+  const int *values = (const int *) imports + variables;
+  for (uint32_t pos = 0; pos < header->eliminated; pos++)
+    PUSH_STACK (solver->eliminated, (value) values[pos]);
+  for (uint32_t eidx = 1; eidx < variables; eidx++) {
+    const uint32_t code = imports[eidx];
+    const unsigned tag = code & 3;
+    if (tag == IMPORT_ELIMINATED)
+      kissat_import_eliminated (solver, eidx, code >> 2);
+    else if (tag != IMPORT_NONE)
+      kissat_import_variable (solver, eidx, tag == IMPORT_EXTENSION);
+  }
+  const int *lits = values + header->eliminated;
+  for (uint64_t i = 0; i < header->units; i++)
+    add_literals (solver, 1, lits++);
+  for (uint64_t i = 0; i < header->binaries; i++, lits += 2)
+    add_literals (solver, 2, lits);
+  const int *const end_of_clauses = lits + header->literals;
+  while (lits != end_of_clauses) {
+    const int *p = lits;
+    while (*p)
+      p++;
+    add_literals (solver, p - lits, lits);
+    lits = p + 1;
+  }
+  const uint32_t *extend = (const uint32_t *) end_of_clauses;
+  for (uint64_t i = 0; i < header->extend; i++) {
+    const int word = (int) extend[i];
+    const bool blocking = word & 1;
+    const int elit = (word - blocking) / 2;
+    PUSH_STACK (solver->extend, kissat_extension (blocking, elit));
+  }
+  solver->preprocessed = header->preprocessed;
+}
+
+static const char *parse_snapshot (kissat *solver,
+                                   const unsigned char *chars, size_t size,
+                                   int *max_var_ptr) {
+  snapshot_header header;
+  if (size < sizeof header)
+    return "truncated snapshot header";
+  memcpy (&header, chars, sizeof header);
+  if (memcmp (header.magic, snapshot_magic, sizeof header.magic))
+    return "invalid snapshot signature";
+  if (header.endianness != SNAPSHOT_ENDIANNESS)
+    return "snapshot written with different byte order";
+  if (header.version != SNAPSHOT_VERSION)
+    return "unsupported snapshot version";
+  if (header.preprocessed > 1)
+    return "invalid snapshot header";
+  if (header.variables > (uint32_t) EXTERNAL_MAX_VAR + 1)
+    return "too many variables in snapshot";
+  if (header.max_var && header.max_var >= header.variables)
+    return "invalid maximum variable in snapshot";
+  if ((size - sizeof header) % sizeof (uint32_t))
+    return "invalid snapshot size";
+  uint64_t remaining = (size - sizeof header) / sizeof (uint32_t);
+#define SECTION(WORDS) \
+  do { \
+    if ((WORDS) > remaining) \
+      return "truncated snapshot"; \
+    remaining -= (WORDS); \
+  } while (0)
+  SECTION (header.variables);
+  SECTION (header.eliminated);
+  SECTION (header.units);
+  if (header.binaries > remaining / 2)
+    return "truncated snapshot";
+  SECTION (2 * header.binaries);
+  SECTION (header.literals);
+  SECTION (header.extend);
+#undef SECTION
+  if (remaining)
+    return "trailing data in snapshot";
+  const uint32_t *words = (const uint32_t *) (chars + sizeof header);
+  const char *error = check_snapshot (solver, &header, words);
+  if (error)
+    return error;
+  restore_snapshot (solver, &header, words);
+  *max_var_ptr = header.max_var;
+  return 0;
+}
+
+static unsigned char *read_snapshot (kissat *solver, file *file,
+                                     size_t *size_ptr,
+                                     size_t *capacity_ptr) {
+  size_t size = 0, capacity = 1u << 16;
+  unsigned char *res = kissat_malloc (solver, capacity);
+  for (;;) {
+    if (size == capacity) {
+      res = kissat_realloc (solver, res, capacity, 2 * capacity);
+      capacity *= 2;
+    }
+    const size_t bytes = kissat_read (file, res + size, capacity - size);
+    if (!bytes)
+      break;
+    size += bytes;
+  }
+  *size_ptr = size;
+  *capacity_ptr = capacity;
+  return res;
+}
+
+const char *kissat_read_snapshot (kissat *solver, file *file,
+                                  int *max_var_ptr) {
+  assert (EMPTY_STACK (solver->import));
+  size_t size = 0, capacity = 0;
+  unsigned char *allocated = 0;
+  const unsigned char *chars = kissat_map_file (file, &size);
+  if (!chars)
+    chars = allocated = read_snapshot (solver, file, &size, &capacity);
+  else
+    file->bytes = size;
+  const char *error = parse_snapshot (solver, chars, size, max_var_ptr);
+  if (allocated)
+    kissat_free (solver, allocated, capacity);
+  else
+    kissat_unmap_file (chars, size);
+  return error;
+}
@@ -0,0 +1,23 @@
+#ifndef _snapshot_h_INCLUDED
+#define _snapshot_h_INCLUDED
+
+#include <stdbool.h>
+
+// Snapshots are versioned binary files which capture the root-level state
+// of the solver after parsing or preprocessing, i.e., the import map, the
+// values of eliminated variables, the extension stack, root-level units as
+// well as all irredundant binary and large clauses.  All numbers are
+// stored as 32-bit words in native byte order such that a snapshot can be
+// mapped into memory and restored without any parsing.
+
+struct file;
+struct kissat;
+
+bool kissat_write_snapshot (struct kissat *, struct file *,
+                            bool preprocessed);
+void kissat_write_preprocessed_snapshot (struct kissat *);
+
+const char *kissat_read_snapshot (struct kissat *, struct file *,
+                                  int *max_var_ptr);
+
+#endif
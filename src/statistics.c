@@ -131,6 +131,9 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PER_SWEEP_VARIABLES(NAME) \
   kissat_average (statistics->NAME, statistics->sweep_variables)
 
+#define PER_TRAIL_REPLAY(NAME) \
+  RELATIVE (NAME, trail_replays)
+
 #define PER_VARIABLE(NAME) \
   kissat_average (statistics->NAME, variables)
 
@@ -269,6 +272,9 @@ kissat_statistics_print (kissat * solver, bool verbose)
 #define PCNT_SEARCHES(NAME) \
   PERCENT (NAME, searches)
 
+#define PCNT_SEARCH_TICKS(NAME) \
+  PERCENT (NAME, search_ticks)
+
 #define PCNT_STRENGTHENED(NAME) \
   PERCENT (NAME, strengthened)
 
@@ -301,6 +307,12 @@ kissat_statistics_print (kissat * solver, bool verbose)
   PERCENT (NAME, ticks)
 #endif
 
+#define PCNT_TRAIL_REPLAYED(NAME) \
+  PERCENT (NAME, trail_replayed)
+
+#define PCNT_TRAIL_REPLAYS(NAME) \
+  PERCENT (NAME, trail_replays)
+
 #define PCNT_VARIABLES(NAME) \
   kissat_percent (statistics->NAME, variables)
 
@@ -400,6 +412,9 @@ void kissat_check_statistics (kissat *solver) {
   assert (!(binary & 1));
   binary /= 2;
 
+  assert (solver->recycler.bytes <= arena_garbage);
+  arena_garbage -= solver->recycler.bytes;
+
   statistics *statistics = &solver->statistics;
   assert (statistics->clauses_binary == binary);
   assert (statistics->clauses_redundant == redundant);
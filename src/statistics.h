@@ -17,8 +17,10 @@
   METRIC (arena_garbage, 1, PCNT_RESIDENT_SET, "%", "resident set") \
   METRIC (arena_resized, 1, CONF_INT, "", "interval") \
   METRIC (arena_shrunken, 1, PCNT_ARENA_RESIZED, "%", "resize") \
+  STATISTIC (assumptions_failed, 1, PCNT_SEARCHES, "%", "searches") \
   COUNTER (backbone_computations, 2, CONF_INT, "", "interval") \
   METRIC (backbone_implied, 1, PER_BACKBONE_UNIT, 0, "per unit") \
+  STATISTIC (backbone_lifted, 1, PCNT_VARIABLES, "%", "variables") \
   METRIC (backbone_probes, 2, PER_VARIABLE, "", "per variable") \
   METRIC (backbone_propagations, 2, PCNT_PROPS, "%", "propagations") \
   METRIC (backbone_rounds, 2, PER_BACKBONE, 0, "per backbone") \
@@ -158,6 +160,7 @@
   METRIC (literals_minshrunken, 1, PCNT_LITS_SHRUNKEN, "%", "shrunken") \
   METRIC (literals_shrunken, 1, PCNT_LITS_DEDUCED, "%", "deduced") \
   STATISTIC (literals_unfactored, 2, PER_CLS_UNFACTORED, 0, "per unfactored") \
+  STATISTIC (memory_reductions, 1, PCNT_REDUCTIONS, "%", "reductions") \
   METRIC (moved, 1, PCNT_REDUCTIONS, "%", "reductions") \
   STATISTIC (on_the_fly_strengthened, 1, PCNT_CONFLICTS, "%", "of conflicts") \
   STATISTIC (on_the_fly_subsumed, 1, PCNT_CONFLICTS, "%", "of conflicts") \
@@ -168,6 +171,8 @@
   STATISTIC (queue_decisions, 1, PCNT_DECISIONS, "%", "decision") \
   STATISTIC (random_decisions, 1, PCNT_DECISIONS, "%", "decision") \
   COUNTER (random_sequences, 2, CONF_INT, "", "interval") \
+  STATISTIC (recycled_clauses, 1, PCNT_CLS_ADDED, "%", "added") \
+  STATISTIC (recycles, 1, PCNT_REDUCTIONS, "%", "reductions") \
   COUNTER (reductions, 1, CONF_INT, "", "interval") \
   COUNTER (reordered, 1, CONF_INT, "", "interval") \
   STATISTIC (reordered_focused, 1, PCNT_REORDERED, "%", "reordered") \
@@ -182,12 +187,17 @@
   STATISTIC (restarts_levels, 1, PER_RESTART, 0, "per restart") \
   STATISTIC (restarts_reused_levels, 1, PCNT_RESTARTS_LEVELS, "%", "levels") \
   STATISTIC (restarts_reused_trails, 1, PCNT_RESTARTS, "%", "restarts") \
+  STATISTIC (restored, 1, PCNT_VARIABLES, "%", "variables") \
   COUNTER (retiered, 2, CONF_INT, "", "interval") \
   METRIC (saved_decisions, 1, PCNT_DECISIONS, "%", "decisions") \
   METRIC (score_decisions, 0, PCNT_DECISIONS, "%", "decision") \
   COUNTER (searches, 2, CONF_INT, "", "interval") \
   METRIC (search_propagations, 2, PCNT_PROPS, "%", "propagations") \
   COUNTER (search_ticks, 2, PCNT_TICKS, "%", "ticks") \
+  COUNTER (shared_exported, 1, PCNT_CLS_LEARNED, "%", "learned") \
+  COUNTER (shared_imported, 1, PCNT_CLS_LEARNED, "%", "learned") \
+  COUNTER (shared_imported_units, 1, PCNT_VARIABLES, "%", "variables") \
+  COUNTER (shared_imports, 2, CONF_INT, "", "interval") \
   METRIC (sparse_gcs, 2, PCNT_COLLECTIONS, "%", "collections") \
   METRIC (stable_decisions, 1, PCNT_DECISIONS, "%", "decisions") \
   METRIC (stable_modes, 2, CONF_INT, "", "interval") \
@@ -229,6 +239,12 @@
   METRIC (target_decisions, 1, PCNT_DECISIONS, "%", "decisions") \
   METRIC (target_saved, 1, CONF_INT, "", "interval") \
   STATISTIC (ticks, 2, PER_PROPAGATION, 0, "per prop") \
+  COUNTER (trail_replay_conflicts, 1, PCNT_TRAIL_REPLAYS, "%", "replays") \
+  COUNTER (trail_replayed, 1, PER_TRAIL_REPLAY, 0, "per replay") \
+  COUNTER (trail_replays, 1, PCNT_DECISIONS, "%", "decisions") \
+  COUNTER (trail_saved, 1, CONF_INT, "", "interval") \
+  COUNTER (trail_saved_ticks, 1, PCNT_SEARCH_TICKS, "%", "search ticks") \
+  COUNTER (trail_skipped, 1, PCNT_TRAIL_REPLAYED, "%", "replayed") \
   METRIC (transitive_probes, 2, PER_VARIABLE, "", "per variable") \
   METRIC (transitive_propagations, 2, PCNT_PROPS, "%", "propagations") \
   METRIC (transitive_reduced, 1, PCNT_CLS_ADDED, "%", "added") \
@@ -264,12 +280,14 @@
   STATISTIC (vivified_tier3, 1, PCNT_VIVIFIED, "%", "vivified") \
   STATISTIC (vivified_unlearn, 1, PCNT_VIVIFIED, "%", "vivified") \
   COUNTER (vivify_checks, 2, PER_VIVIFICATION, "", "per vivify") \
+  STATISTIC (vivify_filtered, 1, PER_VIVIFICATION, 0, "per vivify") \
   COUNTER (vivify_probes, 2, PER_VIVIFY_CHECK, 0, "per check") \
   STATISTIC (vivify_propagations, 2, PCNT_PROPS, "%", "propagations") \
   COUNTER (vivify_reused, 2, PCNT_VIVIFY_PROBES, "%", "probes") \
   STATISTIC (vivify_ticks, 2, PCNT_TICKS, "%", "ticks") \
   STATISTIC (vivify_units, 1, PCNT_VARIABLES, "%", "variables") \
   METRIC (walk_decisions, 1, PCNT_WALKS, "%", "walks") \
+  STATISTIC (walk_helped, 1, PCNT_WALKS, "%", "walks") \
   STATISTIC (walk_improved, 1, PCNT_WALKS, "%", "walks") \
   METRIC (walk_previous, 1, PCNT_WALKS, "%", "walks") \
   COUNTER (walks, 1, CONF_INT, "", "interval") \
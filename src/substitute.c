@@ -215,6 +215,13 @@ static bool *add_representative_equivalences (kissat *solver,
     if (lit == other)
       continue;
     assert (other < lit);
+    if (FLAGS (idx)->frozen) {
+      LOG ("keeping frozen %s equivalent to %s", LOGVAR (idx),
+           LOGLIT (other));
+      repr[lit] = lit;
+      repr[NOT (lit)] = NOT (lit);
+      continue;
+    }
 #ifdef CHECKING_OR_PROVING
     const unsigned not_lit = NOT (lit);
     const unsigned not_other = NOT (other);
@@ -3,6 +3,7 @@
 #include "inline.h"
 #include "kitten.h"
 #include "logging.h"
+#include "parallel.h"
 #include "print.h"
 #include "promote.h"
 #include "propdense.h"
@@ -17,6 +18,11 @@
 
 struct sweeper {
   kissat *solver;
+  kitten *kitten;
+  statistics *statistics;
+  bool worker;
+  bool success;
+  bool limit_reached;
   unsigned *depths;
   unsigned *reprs;
   unsigned *next, *prev;
@@ -29,6 +35,7 @@ struct sweeper {
   unsigneds backbone;
   unsigneds partition;
   unsigneds core[2];
+  unsigneds deferred;
   struct {
     uint64_t ticks;
     unsigned clauses, depth, vars;
@@ -37,34 +44,60 @@ struct sweeper {
 
 typedef struct sweeper sweeper;
 
+// With 'sweepthreads > 1' environments of several scheduled variables are
+// encoded into separate detached kittens of worker sweepers, which then
+// search for backbones and equivalences concurrently on helper threads.
+// Workers only read the solver.  They count sub-solver statistics in their
+// own 'statistics', do not account the memory of their stacks ('solver' is
+// zero in 'push_sweeper_stack' and 'release_sweeper_stack') and 'defer'
+// their results until these are merged by the main sweeper.
+
+#define SWEEP_INC(NAME) kissat_inc_##NAME (sweeper->statistics)
+#define SWEEP_ADD(NAME, N) kissat_add_##NAME (sweeper->statistics, (N))
+
+static inline void push_sweeper_stack (sweeper *sweeper, unsigneds *stack,
+                                       unsigned element) {
+  kissat *const solver = sweeper->worker ? 0 : sweeper->solver;
+  PUSH_STACK (*stack, element);
+}
+
+static inline void release_sweeper_stack (sweeper *sweeper,
+                                          unsigneds *stack) {
+  kissat *const solver = sweeper->worker ? 0 : sweeper->solver;
+  RELEASE_STACK (*stack);
+}
+
 static int sweep_solve (sweeper *sweeper) {
-  kissat *solver = sweeper->solver;
-  kitten *kitten = solver->kitten;
+  kitten *kitten = sweeper->kitten;
   kitten_randomize_phases (kitten);
-  INC (sweep_solved);
+  SWEEP_INC (sweep_solved);
   int res = kitten_solve (kitten);
   if (res == 10)
-    INC (sweep_sat);
+    SWEEP_INC (sweep_sat);
   if (res == 20)
-    INC (sweep_unsat);
+    SWEEP_INC (sweep_unsat);
   return res;
 }
 
 static void set_kitten_ticks_limit (sweeper *sweeper) {
   uint64_t remaining = 0;
+#ifdef LOGGING
   kissat *solver = sweeper->solver;
-  if (solver->statistics.kitten_ticks < sweeper->limit.ticks)
-    remaining = sweeper->limit.ticks - solver->statistics.kitten_ticks;
+#endif
+  if (sweeper->statistics->kitten_ticks < sweeper->limit.ticks)
+    remaining = sweeper->limit.ticks - sweeper->statistics->kitten_ticks;
   LOG ("'kitten_ticks' remaining %" PRIu64, remaining);
-  kitten_set_ticks_limit (solver->kitten, remaining);
+  kitten_set_ticks_limit (sweeper->kitten, remaining);
 }
 
 static bool kitten_ticks_limit_hit (sweeper *sweeper, const char *when) {
+#ifdef LOGGING
   kissat *solver = sweeper->solver;
-  if (solver->statistics.kitten_ticks >= sweeper->limit.ticks) {
+#endif
+  if (sweeper->statistics->kitten_ticks >= sweeper->limit.ticks) {
     LOG ("'kitten_ticks' limit of %" PRIu64 " ticks hit after %" PRIu64
          " ticks during %s",
-         sweeper->limit.ticks, solver->statistics.kitten_ticks, when);
+         sweeper->limit.ticks, sweeper->statistics->kitten_ticks, when);
     return true;
   }
 #ifndef LOGGING
@@ -75,6 +108,8 @@ static bool kitten_ticks_limit_hit (sweeper *sweeper, const char *when) {
 
 static void init_sweeper (kissat *solver, sweeper *sweeper) {
   sweeper->solver = solver;
+  sweeper->statistics = &solver->statistics;
+  sweeper->worker = false;
   sweeper->encoded = 0;
   CALLOC (sweeper->depths, VARS);
   NALLOC (sweeper->reprs, LITS);
@@ -98,9 +133,10 @@ static void init_sweeper (kissat *solver, sweeper *sweeper) {
   INIT_STACK (sweeper->partition);
   INIT_STACK (sweeper->core[0]);
   INIT_STACK (sweeper->core[1]);
+  INIT_STACK (sweeper->deferred);
   assert (!solver->kitten);
-  solver->kitten = kitten_embedded (solver);
-  kitten_track_antecedents (solver->kitten);
+  sweeper->kitten = solver->kitten = kitten_embedded (solver);
+  kitten_track_antecedents (sweeper->kitten);
   kissat_enter_dense_mode (solver, 0);
   kissat_connect_irredundant_large_clauses (solver);
 
@@ -140,7 +176,7 @@ static void init_sweeper (kissat *solver, sweeper *sweeper) {
     sweeper->limit.ticks = UINT64_MAX;
     kissat_extremely_verbose (solver, "unlimited sweeper ticks limit");
   } else {
-    SET_EFFORT_LIMIT (ticks_limit, sweep, kitten_ticks);
+    SET_SCHEDULED_EFFORT_LIMIT (ticks_limit, sweep, kitten_ticks);
     sweeper->limit.ticks = ticks_limit;
   }
   set_kitten_ticks_limit (sweeper);
@@ -168,17 +204,15 @@ static unsigned release_sweeper (sweeper *sweeper) {
   RELEASE_STACK (sweeper->partition);
   RELEASE_STACK (sweeper->core[0]);
   RELEASE_STACK (sweeper->core[1]);
-  kitten_release (solver->kitten);
-  solver->kitten = 0;
+  RELEASE_STACK (sweeper->deferred);
+  kitten_release (sweeper->kitten);
+  sweeper->kitten = solver->kitten = 0;
   kissat_resume_sparse_mode (solver, false, 0);
   return merged;
 }
 
-static void clear_sweeper (sweeper *sweeper) {
+static void clear_environment (sweeper *sweeper) {
   kissat *solver = sweeper->solver;
-  LOG ("clearing sweeping environment");
-  kitten_clear (solver->kitten);
-  kitten_track_antecedents (solver->kitten);
   for (all_stack (unsigned, idx, sweeper->vars)) {
     assert (sweeper->depths[idx]);
     sweeper->depths[idx] = 0;
@@ -190,9 +224,19 @@ static void clear_sweeper (sweeper *sweeper) {
     c->swept = false;
   }
   CLEAR_STACK (sweeper->refs);
+  sweeper->encoded = 0;
+}
+
+static void clear_sweeper (sweeper *sweeper) {
+#ifdef LOGGING
+  kissat *solver = sweeper->solver;
+#endif
+  LOG ("clearing sweeping environment");
+  kitten_clear (sweeper->kitten);
+  kitten_track_antecedents (sweeper->kitten);
+  clear_environment (sweeper);
   CLEAR_STACK (sweeper->backbone);
   CLEAR_STACK (sweeper->partition);
-  sweeper->encoded = 0;
   set_kitten_ticks_limit (sweeper);
 }
 
@@ -203,7 +247,7 @@ static unsigned sweep_repr (sweeper *sweeper, unsigned lit) {
     while ((res = sweeper->reprs[prev]) != prev)
       prev = res;
   }
-  if (res == lit)
+  if (res == lit || sweeper->worker)
     return res;
 #if defined(LOGGING) || !defined(NDEBUG)
   kissat *solver = sweeper->solver;
@@ -240,11 +284,10 @@ static void add_literal_to_environment (sweeper *sweeper, unsigned depth,
 }
 
 static void sweep_clause (sweeper *sweeper, unsigned depth) {
-  kissat *solver = sweeper->solver;
   assert (SIZE_STACK (sweeper->clause) > 1);
   for (all_stack (unsigned, lit, sweeper->clause))
     add_literal_to_environment (sweeper, depth, lit);
-  kitten_clause (solver->kitten, SIZE_STACK (sweeper->clause),
+  kitten_clause (sweeper->kitten, SIZE_STACK (sweeper->clause),
                  BEGIN_STACK (sweeper->clause));
   CLEAR_STACK (sweeper->clause);
   sweeper->encoded++;
@@ -327,7 +370,7 @@ static void save_core_clause (void *state, bool learned, size_t size,
       RESIZE_STACK (*core, saved);
       return;
     }
-    PUSH_STACK (*core, lit);
+    push_sweeper_stack (sweeper, core, lit);
     if (value < 0)
       continue;
     if (!learned && ++non_false > 1) {
@@ -341,7 +384,7 @@ static void save_core_clause (void *state, bool learned, size_t size,
   size_t saved_size = SIZE_STACK (*core) - saved;
   LOGLITS (saved_size, saved_lits, "saved core[%u]", sweeper->save);
 #endif
-  PUSH_STACK (*core, INVALID_LIT);
+  push_sweeper_stack (sweeper, core, INVALID_LIT);
 }
 
 static void add_core (sweeper *sweeper, unsigned core_idx) {
@@ -423,13 +466,15 @@ static void add_core (sweeper *sweeper, unsigned core_idx) {
 }
 
 static void save_core (sweeper *sweeper, unsigned core) {
+#ifdef LOGGING
   kissat *solver = sweeper->solver;
+#endif
   LOG ("saving extracted core[%u] lemmas", core);
   assert (core == 0 || core == 1);
   assert (EMPTY_STACK (sweeper->core[core]));
   sweeper->save = core;
-  kitten_compute_clausal_core (solver->kitten, 0);
-  kitten_traverse_core_clauses (solver->kitten, sweeper, save_core_clause);
+  kitten_compute_clausal_core (sweeper->kitten, 0);
+  kitten_traverse_core_clauses (sweeper->kitten, sweeper, save_core_clause);
 }
 
 static void clear_core (sweeper *sweeper, unsigned core_idx) {
@@ -463,6 +508,39 @@ static void save_add_clear_core (sweeper *sweeper) {
   clear_core (sweeper, 0);
 }
 
+// Worker sweepers defer a derived unit 'lit' (then 'other' is invalid), an
+// empty clause (both invalid) or an equivalence 'lit = other' by moving it
+// together with the saved core lemmas to 'deferred'.  Each such record
+// consists of 'lit', 'other', the sizes of both cores and their lemmas.
+
+static void defer_cores (sweeper *sweeper, unsigned lit, unsigned other) {
+  assert (sweeper->worker);
+  unsigneds *const deferred = &sweeper->deferred;
+  push_sweeper_stack (sweeper, deferred, lit);
+  push_sweeper_stack (sweeper, deferred, other);
+  for (unsigned i = 0; i != 2; i++)
+    push_sweeper_stack (sweeper, deferred, SIZE_STACK (sweeper->core[i]));
+  for (unsigned i = 0; i != 2; i++) {
+    for (all_stack (unsigned, tmp, sweeper->core[i]))
+      push_sweeper_stack (sweeper, deferred, tmp);
+    CLEAR_STACK (sweeper->core[i]);
+  }
+}
+
+static const unsigned *undefer_cores (sweeper *worker, const unsigned *p) {
+  kissat *const solver = 0;
+  const unsigned size0 = p[2], size1 = p[3];
+  p += 4;
+  for (unsigned i = 0; i != 2; i++) {
+    unsigneds *const core = worker->core + i;
+    assert (EMPTY_STACK (*core));
+    const unsigned *const end = p + (i ? size1 : size0);
+    while (p != end)
+      PUSH_STACK (*core, *p++);
+  }
+  return p;
+}
+
 #define LOGBACKBONE(MESSAGE) \
   LOGLITSET (SIZE_STACK (sweeper->backbone), \
              BEGIN_STACK (sweeper->backbone), MESSAGE)
@@ -479,13 +557,13 @@ static void init_backbone_and_partition (sweeper *sweeper) {
       continue;
     const unsigned lit = LIT (idx);
     const unsigned not_lit = NOT (lit);
-    const signed char tmp = kitten_value (solver->kitten, lit);
+    const signed char tmp = kitten_value (sweeper->kitten, lit);
     const unsigned candidate = (tmp < 0) ? not_lit : lit;
     LOG ("sweeping candidate %s", LOGLIT (candidate));
-    PUSH_STACK (sweeper->backbone, candidate);
-    PUSH_STACK (sweeper->partition, candidate);
+    push_sweeper_stack (sweeper, &sweeper->backbone, candidate);
+    push_sweeper_stack (sweeper, &sweeper->partition, candidate);
   }
-  PUSH_STACK (sweeper->partition, INVALID_LIT);
+  push_sweeper_stack (sweeper, &sweeper->partition, INVALID_LIT);
 
   LOGBACKBONE ("initialized backbone candidates");
   LOGPARTITION ("initialized equivalence candidates");
@@ -493,6 +571,11 @@ static void init_backbone_and_partition (sweeper *sweeper) {
 
 static void sweep_empty_clause (sweeper *sweeper) {
   assert (!sweeper->solver->inconsistent);
+  if (sweeper->worker) {
+    save_core (sweeper, 0);
+    defer_cores (sweeper, INVALID_LIT, INVALID_LIT);
+    return;
+  }
   save_add_clear_core (sweeper);
   assert (sweeper->solver->inconsistent);
 }
@@ -500,7 +583,7 @@ static void sweep_empty_clause (sweeper *sweeper) {
 static void sweep_refine_partition (sweeper *sweeper) {
   kissat *solver = sweeper->solver;
   LOG ("refining partition");
-  kitten *kitten = solver->kitten;
+  kitten *kitten = sweeper->kitten;
   unsigneds old_partition = sweeper->partition;
   unsigneds new_partition;
   INIT_STACK (new_partition);
@@ -522,7 +605,7 @@ static void sweep_refine_partition (sweeper *sweeper) {
       if (!value)
         LOG ("dropping sub-solver unassigned %s", LOGLIT (other));
       else if (value > 0) {
-        PUSH_STACK (new_partition, other);
+        push_sweeper_stack (sweeper, &new_partition, other);
         assigned_true++;
       }
     }
@@ -542,7 +625,7 @@ static void sweep_refine_partition (sweeper *sweeper) {
       LOG ("dropping singleton class %s", LOGLIT (other));
     } else {
       LOG ("%u positive literal in class", assigned_true);
-      PUSH_STACK (new_partition, INVALID_LIT);
+      push_sweeper_stack (sweeper, &new_partition, INVALID_LIT);
 #ifdef LOGGING
       new_classes++;
 #endif
@@ -556,7 +639,7 @@ static void sweep_refine_partition (sweeper *sweeper) {
         continue;
       signed char value = kitten_value (kitten, other);
       if (value < 0) {
-        PUSH_STACK (new_partition, other);
+        push_sweeper_stack (sweeper, &new_partition, other);
         assigned_false++;
       }
     }
@@ -573,13 +656,13 @@ static void sweep_refine_partition (sweeper *sweeper) {
       LOG ("dropping singleton class %s", LOGLIT (other));
     } else {
       LOG ("%u negative literal in class", assigned_false);
-      PUSH_STACK (new_partition, INVALID_LIT);
+      push_sweeper_stack (sweeper, &new_partition, INVALID_LIT);
 #ifdef LOGGING
       new_classes++;
 #endif
     }
   }
-  RELEASE_STACK (old_partition);
+  release_sweeper_stack (sweeper, &old_partition);
   sweeper->partition = new_partition;
   LOG ("refined %u classes into %u", old_classes, new_classes);
   LOGPARTITION ("refined equivalence candidates");
@@ -591,7 +674,7 @@ static void sweep_refine_backbone (sweeper *sweeper) {
   const unsigned *const end = END_STACK (sweeper->backbone);
   unsigned *q = BEGIN_STACK (sweeper->backbone);
   const value *const values = solver->values;
-  kitten *kitten = solver->kitten;
+  kitten *kitten = sweeper->kitten;
   for (const unsigned *p = q; p != end; p++) {
     const unsigned lit = *p;
     if (values[lit])
@@ -626,7 +709,7 @@ static void flip_backbone_literals (struct sweeper *sweeper) {
   if (!max_rounds)
     return;
   assert (!EMPTY_STACK (sweeper->backbone));
-  struct kitten *kitten = solver->kitten;
+  struct kitten *kitten = sweeper->kitten;
   if (kitten_status (kitten) != 10)
     return;
 #ifdef LOGGING
@@ -640,13 +723,13 @@ static void flip_backbone_literals (struct sweeper *sweeper) {
     const unsigned *const end = END_STACK (sweeper->backbone), *p = q;
     while (p != end) {
       const unsigned lit = *p++;
-      INC (sweep_flip_backbone);
+      SWEEP_INC (sweep_flip_backbone);
       if (kitten_flip_literal (kitten, lit)) {
         LOG ("flipping backbone candidate %s succeeded", LOGLIT (lit));
 #ifdef LOGGING
         total_flipped++;
 #endif
-        INC (sweep_flipped_backbone);
+        SWEEP_INC (sweep_flipped_backbone);
         flipped++;
       } else {
         LOG ("flipping backbone candidate %s failed", LOGLIT (lit));
@@ -658,7 +741,7 @@ static void flip_backbone_literals (struct sweeper *sweeper) {
 
     if (TERMINATED (sweep_terminated_1))
       break;
-    if (solver->statistics.kitten_ticks > sweeper->limit.ticks)
+    if (sweeper->statistics->kitten_ticks > sweeper->limit.ticks)
       break;
   } while (flipped && round < max_rounds);
   LOG ("flipped %u backbone candidates in total in %u rounds",
@@ -666,20 +749,22 @@ static void flip_backbone_literals (struct sweeper *sweeper) {
 }
 
 static bool sweep_backbone_candidate (sweeper *sweeper, unsigned lit) {
+#ifdef LOGGING
   kissat *solver = sweeper->solver;
+#endif
   LOG ("trying backbone candidate %s", LOGLIT (lit));
-  kitten *kitten = solver->kitten;
+  kitten *kitten = sweeper->kitten;
   signed char value = kitten_fixed (kitten, lit);
   if (value) {
-    INC (sweep_fixed_backbone);
+    SWEEP_INC (sweep_fixed_backbone);
     LOG ("literal %s already fixed", LOGLIT (lit));
     assert (value > 0);
     return false;
   }
 
-  INC (sweep_flip_backbone);
+  SWEEP_INC (sweep_flip_backbone);
   if (kitten_status (kitten) == 10 && kitten_flip_literal (kitten, lit)) {
-    INC (sweep_flipped_backbone);
+    SWEEP_INC (sweep_flipped_backbone);
     LOG ("flipping %s succeeded", LOGLIT (lit));
     LOGBACKBONE ("refined backbone candidates");
     return false;
@@ -687,24 +772,28 @@ static bool sweep_backbone_candidate (sweeper *sweeper, unsigned lit) {
 
   LOG ("flipping %s failed", LOGLIT (lit));
   const unsigned not_lit = NOT (lit);
-  INC (sweep_solved_backbone);
+  SWEEP_INC (sweep_solved_backbone);
   kitten_assume (kitten, not_lit);
   int res = sweep_solve (sweeper);
   if (res == 10) {
     LOG ("sweeping backbone candidate %s failed", LOGLIT (lit));
     sweep_refine (sweeper);
-    INC (sweep_sat_backbone);
+    SWEEP_INC (sweep_sat_backbone);
     return false;
   }
 
   if (res == 20) {
     LOG ("sweep unit %s", LOGLIT (lit));
-    save_add_clear_core (sweeper);
-    INC (sweep_unsat_backbone);
+    if (sweeper->worker) {
+      save_core (sweeper, 0);
+      defer_cores (sweeper, lit, INVALID_LIT);
+    } else
+      save_add_clear_core (sweeper);
+    SWEEP_INC (sweep_unsat_backbone);
     return true;
   }
 
-  INC (sweep_unknown_backbone);
+  SWEEP_INC (sweep_unknown_backbone);
 
   LOG ("sweeping backbone candidate %s failed", LOGLIT (lit));
   return false;
@@ -1045,7 +1134,7 @@ static void substitute_connected_clauses (sweeper *sweeper, unsigned lit,
 
 static void sweep_remove (sweeper *sweeper, unsigned lit) {
   kissat *solver = sweeper->solver;
-  assert (sweeper->reprs[lit] != lit);
+  assert (sweeper->worker || sweeper->reprs[lit] != lit);
   unsigneds *partition = &sweeper->partition;
   unsigned *const begin_partition = BEGIN_STACK (*partition), *p;
   const unsigned *const end_partition = END_STACK (*partition);
@@ -1083,7 +1172,7 @@ static void flip_partition_literals (struct sweeper *sweeper) {
   if (!max_rounds)
     return;
   assert (!EMPTY_STACK (sweeper->partition));
-  struct kitten *kitten = solver->kitten;
+  struct kitten *kitten = sweeper->kitten;
   if (kitten_status (kitten) != 10)
     return;
 #ifdef LOGGING
@@ -1128,21 +1217,66 @@ static void flip_partition_literals (struct sweeper *sweeper) {
 
     if (TERMINATED (sweep_terminated_2))
       break;
-    if (solver->statistics.kitten_ticks > sweeper->limit.ticks)
+    if (sweeper->statistics->kitten_ticks > sweeper->limit.ticks)
       break;
   } while (flipped && round < max_rounds);
   LOG ("flipped %u equivalence candidates in total in %u rounds",
        total_flipped, round);
 }
 
+// Adds the equivalence 'lit = other' proven by the saved core lemmas of
+// 'prover' (which is the sweeper itself unless merging deferred results of
+// a worker) and substitutes the larger by the smaller literal.  Returns
+// the substituted literal.
+
+static unsigned merge_equivalence (sweeper *sweeper, struct sweeper *prover,
+                                   unsigned lit, unsigned other) {
+  kissat *solver = sweeper->solver;
+  const unsigned not_lit = NOT (lit);
+  const unsigned not_other = NOT (other);
+
+  LOG ("sweep equivalence %s = %s", LOGLIT (lit), LOGLIT (other));
+  INC (sweep_equivalences);
+
+  add_core (prover, 0);
+  add_binary (solver, lit, not_other);
+  clear_core (prover, 0);
+
+  add_core (prover, 1);
+  add_binary (solver, not_lit, other);
+  clear_core (prover, 1);
+
+  unsigned repr, substituted;
+  if (lit < other) {
+    repr = sweeper->reprs[other] = lit;
+    sweeper->reprs[not_other] = not_lit;
+    substitute_connected_clauses (sweeper, other, lit);
+    substitute_connected_clauses (sweeper, not_other, not_lit);
+    substituted = other;
+  } else {
+    repr = sweeper->reprs[lit] = other;
+    sweeper->reprs[not_lit] = not_other;
+    substitute_connected_clauses (sweeper, lit, other);
+    substitute_connected_clauses (sweeper, not_lit, not_other);
+    substituted = lit;
+  }
+
+  const unsigned repr_idx = IDX (repr);
+  schedule_inner (sweeper, repr_idx);
+
+  return substituted;
+}
+
 static bool sweep_equivalence_candidates (sweeper *sweeper, unsigned lit,
                                           unsigned other) {
+#ifdef LOGGING
   kissat *solver = sweeper->solver;
+#endif
   LOG ("trying equivalence candidates %s = %s", LOGLIT (lit),
        LOGLIT (other));
   const unsigned not_other = NOT (other);
   const unsigned not_lit = NOT (lit);
-  kitten *kitten = solver->kitten;
+  kitten *kitten = sweeper->kitten;
   const unsigned *const begin = BEGIN_STACK (sweeper->partition);
   unsigned *const end = END_STACK (sweeper->partition);
   assert (begin + 3 <= end);
@@ -1151,8 +1285,8 @@ static bool sweep_equivalence_candidates (sweeper *sweeper, unsigned lit,
   const unsigned third = (end - begin == 3) ? INVALID_LIT : end[-4];
   const int status = kitten_status (kitten);
   if (status == 10 && kitten_flip_literal (kitten, lit)) {
-    INC (sweep_flip_equivalences);
-    INC (sweep_flipped_equivalences);
+    SWEEP_INC (sweep_flip_equivalences);
+    SWEEP_INC (sweep_flipped_equivalences);
     LOG ("flipping %s succeeded", LOGLIT (lit));
     if (third == INVALID_LIT) {
       LOG ("squashing equivalence class of %s", LOGLIT (lit));
@@ -1167,8 +1301,8 @@ static bool sweep_equivalence_candidates (sweeper *sweeper, unsigned lit,
     LOGPARTITION ("refined equivalence candidates");
     return false;
   } else if (status == 10 && kitten_flip_literal (kitten, other)) {
-    ADD (sweep_flip_equivalences, 2);
-    INC (sweep_flipped_equivalences);
+    SWEEP_ADD (sweep_flip_equivalences, 2);
+    SWEEP_INC (sweep_flipped_equivalences);
     LOG ("flipping %s succeeded", LOGLIT (other));
     if (third == INVALID_LIT) {
       LOG ("squashing equivalence class of %s", LOGLIT (lit));
@@ -1183,19 +1317,19 @@ static bool sweep_equivalence_candidates (sweeper *sweeper, unsigned lit,
     return false;
   }
   if (status == 10)
-    ADD (sweep_flip_equivalences, 2);
+    SWEEP_ADD (sweep_flip_equivalences, 2);
   LOG ("flipping %s and %s both failed", LOGLIT (lit), LOGLIT (other));
   kitten_assume (kitten, not_lit);
   kitten_assume (kitten, other);
-  INC (sweep_solved_equivalences);
+  SWEEP_INC (sweep_solved_equivalences);
   int res = sweep_solve (sweeper);
   if (res == 10) {
-    INC (sweep_sat_equivalences);
+    SWEEP_INC (sweep_sat_equivalences);
     LOG ("first sweeping implication %s -> %s failed", LOGLIT (other),
          LOGLIT (lit));
     sweep_refine (sweeper);
   } else if (!res) {
-    INC (sweep_unknown_equivalences);
+    SWEEP_INC (sweep_unknown_equivalences);
     LOG ("first sweeping implication %s -> %s hit ticks limit",
          LOGLIT (other), LOGLIT (lit));
   }
@@ -1203,7 +1337,7 @@ static bool sweep_equivalence_candidates (sweeper *sweeper, unsigned lit,
   if (res != 20)
     return false;
 
-  INC (sweep_unsat_equivalences);
+  SWEEP_INC (sweep_unsat_equivalences);
   LOG ("first sweeping implication %s -> %s succeeded", LOGLIT (other),
        LOGLIT (lit));
 
@@ -1212,14 +1346,14 @@ static bool sweep_equivalence_candidates (sweeper *sweeper, unsigned lit,
   kitten_assume (kitten, lit);
   kitten_assume (kitten, not_other);
   res = sweep_solve (sweeper);
-  INC (sweep_solved_equivalences);
+  SWEEP_INC (sweep_solved_equivalences);
   if (res == 10) {
-    INC (sweep_sat_equivalences);
+    SWEEP_INC (sweep_sat_equivalences);
     LOG ("second sweeping implication %s <- %s failed", LOGLIT (other),
          LOGLIT (lit));
     sweep_refine (sweeper);
   } else if (!res) {
-    INC (sweep_unknown_equivalences);
+    SWEEP_INC (sweep_unknown_equivalences);
     LOG ("second sweeping implication %s <- %s hit ticks limit",
          LOGLIT (other), LOGLIT (lit));
   }
@@ -1229,52 +1363,42 @@ static bool sweep_equivalence_candidates (sweeper *sweeper, unsigned lit,
     return false;
   }
 
-  INC (sweep_unsat_equivalences);
+  SWEEP_INC (sweep_unsat_equivalences);
   LOG ("second sweeping implication %s <- %s succeeded too", LOGLIT (other),
        LOGLIT (lit));
 
   save_core (sweeper, 1);
 
-  LOG ("sweep equivalence %s = %s", LOGLIT (lit), LOGLIT (other));
-  INC (sweep_equivalences);
-
-  add_core (sweeper, 0);
-  add_binary (solver, lit, not_other);
-  clear_core (sweeper, 0);
+  if (sweeper->worker) {
+    LOG ("deferring sweep equivalence %s = %s", LOGLIT (lit),
+         LOGLIT (other));
+    defer_cores (sweeper, lit, other);
+    sweep_remove (sweeper, lit < other ? other : lit);
+  } else
+    sweep_remove (sweeper, merge_equivalence (sweeper, sweeper, lit, other));
 
-  add_core (sweeper, 1);
-  add_binary (solver, not_lit, other);
-  clear_core (sweeper, 1);
+  return true;
+}
 
-  unsigned repr;
-  if (lit < other) {
-    repr = sweeper->reprs[other] = lit;
-    sweeper->reprs[not_other] = not_lit;
-    substitute_connected_clauses (sweeper, other, lit);
-    substitute_connected_clauses (sweeper, not_other, not_lit);
-    sweep_remove (sweeper, other);
-  } else {
-    repr = sweeper->reprs[lit] = other;
-    sweeper->reprs[not_lit] = not_other;
-    substitute_connected_clauses (sweeper, lit, other);
-    substitute_connected_clauses (sweeper, not_lit, not_other);
-    sweep_remove (sweeper, lit);
+static bool sweepable_variable (sweeper *sweeper, unsigned idx,
+                                const char **reason) {
+  kissat *solver = sweeper->solver;
+  if (!ACTIVE (idx)) {
+    *reason = "inactive variable";
+    return false;
+  }
+  const unsigned start = LIT (idx);
+  if (sweeper->reprs[start] != start) {
+    *reason = "non-representative variable";
+    return false;
   }
-
-  const unsigned repr_idx = IDX (repr);
-  schedule_inner (sweeper, repr_idx);
-
   return true;
 }
 
-static const char *sweep_variable (sweeper *sweeper, unsigned idx) {
+static void encode_environment (sweeper *sweeper, unsigned idx) {
   kissat *solver = sweeper->solver;
   assert (!solver->inconsistent);
-  if (!ACTIVE (idx))
-    return "inactive variable";
   const unsigned start = LIT (idx);
-  if (sweeper->reprs[start] != start)
-    return "non-representative variable";
   assert (EMPTY_STACK (sweeper->vars));
   assert (EMPTY_STACK (sweeper->refs));
   assert (EMPTY_STACK (sweeper->backbone));
@@ -1292,7 +1416,6 @@ static const char *sweep_variable (sweeper *sweeper, unsigned idx) {
 
   bool limit_reached = false;
   size_t expand = 0, next = 1;
-  bool success = false;
   unsigned depth = 1;
 
   while (!limit_reached) {
@@ -1357,99 +1480,134 @@ static const char *sweep_variable (sweeper *sweeper, unsigned idx) {
                             kissat_export_literal (solver, LIT (idx)),
                             SIZE_STACK (sweeper->vars), sweeper->encoded,
                             depth);
-  int res = sweep_solve (sweeper);
-  LOG ("sub-solver returns '%d'", res);
-  if (res == 10) {
-    init_backbone_and_partition (sweeper);
+  sweeper->success = false;
+  sweeper->limit_reached = limit_reached;
+}
+
+static bool sweep_backbone (sweeper *sweeper) {
+  kissat *solver = sweeper->solver;
+  const bool worker = sweeper->worker;
 #ifndef QUIET
-    uint64_t units = solver->statistics.sweep_units;
-    uint64_t solved = solver->statistics.sweep_solved;
+  uint64_t units = solver->statistics.sweep_units;
+  uint64_t solved = solver->statistics.sweep_solved;
 #endif
+  if (!worker)
     START (sweepbackbone);
-    while (!EMPTY_STACK (sweeper->backbone)) {
-      if (solver->inconsistent || TERMINATED (sweep_terminated_3) ||
-          kitten_ticks_limit_hit (sweeper, "backbone refinement")) {
-        limit_reached = true;
-      STOP_SWEEP_BACKBONE:
-        STOP (sweepbackbone);
-        goto DONE;
-      }
-      flip_backbone_literals (sweeper);
-      if (TERMINATED (sweep_terminated_4) ||
-          kitten_ticks_limit_hit (sweeper, "backbone refinement")) {
-        limit_reached = true;
-        goto STOP_SWEEP_BACKBONE;
-      }
-      if (EMPTY_STACK (sweeper->backbone))
-        break;
-      const unsigned lit = POP_STACK (sweeper->backbone);
-      if (!ACTIVE (IDX (lit)))
-        continue;
-      if (sweep_backbone_candidate (sweeper, lit))
-        success = true;
+  bool completed = true;
+  while (!EMPTY_STACK (sweeper->backbone)) {
+    if (solver->inconsistent || TERMINATED (sweep_terminated_3) ||
+        kitten_ticks_limit_hit (sweeper, "backbone refinement")) {
+      completed = false;
+      break;
     }
+    flip_backbone_literals (sweeper);
+    if (TERMINATED (sweep_terminated_4) ||
+        kitten_ticks_limit_hit (sweeper, "backbone refinement")) {
+      completed = false;
+      break;
+    }
+    if (EMPTY_STACK (sweeper->backbone))
+      break;
+    const unsigned lit = POP_STACK (sweeper->backbone);
+    if (!ACTIVE (IDX (lit)))
+      continue;
+    if (sweep_backbone_candidate (sweeper, lit))
+      sweeper->success = true;
+  }
+  if (!worker)
     STOP (sweepbackbone);
+  if (!completed) {
+    sweeper->limit_reached = true;
+    return false;
+  }
 #ifndef QUIET
+  if (!worker) {
     units = solver->statistics.sweep_units - units;
     solved = solver->statistics.sweep_solved - solved;
     kissat_extremely_verbose (
         solver,
         "complete swept variable %d backbone with %" PRIu64
         " units in %" PRIu64 " solver calls",
-        kissat_export_literal (solver, LIT (idx)), units, solved);
+        kissat_export_literal (solver, LIT (PEEK_STACK (sweeper->vars, 0))),
+        units, solved);
+  }
 #endif
-    assert (EMPTY_STACK (sweeper->backbone));
+  assert (EMPTY_STACK (sweeper->backbone));
+  return true;
+}
+
+static void sweep_partition (sweeper *sweeper) {
+  kissat *solver = sweeper->solver;
+  const bool worker = sweeper->worker;
 #ifndef QUIET
-    uint64_t equivalences = solver->statistics.sweep_equivalences;
-    solved = solver->statistics.sweep_solved;
+  uint64_t equivalences = solver->statistics.sweep_equivalences;
+  uint64_t solved = solver->statistics.sweep_solved;
 #endif
+  if (!worker)
     START (sweepequivalences);
-    while (!EMPTY_STACK (sweeper->partition)) {
-      if (solver->inconsistent || TERMINATED (sweep_terminated_5) ||
-          kitten_ticks_limit_hit (sweeper, "partition refinement")) {
-        limit_reached = true;
-      STOP_SWEEP_EQUIVALENCES:
-        STOP (sweepequivalences);
-        goto DONE;
-      }
-      flip_partition_literals (sweeper);
-      if (TERMINATED (sweep_terminated_6) ||
-          kitten_ticks_limit_hit (sweeper, "backbone refinement")) {
-        limit_reached = true;
-        goto STOP_SWEEP_EQUIVALENCES;
-      }
-      if (EMPTY_STACK (sweeper->partition))
-        break;
-      if (SIZE_STACK (sweeper->partition) > 2) {
-        const unsigned *end = END_STACK (sweeper->partition);
-        assert (end[-1] == INVALID_LIT);
-        unsigned lit = end[-3];
-        unsigned other = end[-2];
-        if (sweep_equivalence_candidates (sweeper, lit, other))
-          success = true;
-      } else
-        CLEAR_STACK (sweeper->partition);
+  bool completed = true;
+  while (!EMPTY_STACK (sweeper->partition)) {
+    if (solver->inconsistent || TERMINATED (sweep_terminated_5) ||
+        kitten_ticks_limit_hit (sweeper, "partition refinement")) {
+      completed = false;
+      break;
+    }
+    flip_partition_literals (sweeper);
+    if (TERMINATED (sweep_terminated_6) ||
+        kitten_ticks_limit_hit (sweeper, "backbone refinement")) {
+      completed = false;
+      break;
     }
+    if (EMPTY_STACK (sweeper->partition))
+      break;
+    if (SIZE_STACK (sweeper->partition) > 2) {
+      const unsigned *end = END_STACK (sweeper->partition);
+      assert (end[-1] == INVALID_LIT);
+      unsigned lit = end[-3];
+      unsigned other = end[-2];
+      if (sweep_equivalence_candidates (sweeper, lit, other))
+        sweeper->success = true;
+    } else
+      CLEAR_STACK (sweeper->partition);
+  }
+  if (!worker)
     STOP (sweepequivalences);
+  if (!completed) {
+    sweeper->limit_reached = true;
+    return;
+  }
 #ifndef QUIET
-    equivalences = solver->statistics.sweep_equivalences - equivalences;
-    solved = solver->statistics.sweep_solved - solved;
-    if (equivalences)
-      kissat_extremely_verbose (
-          solver,
-          "complete swept variable %d partition with %" PRIu64
-          " equivalences in %" PRIu64 " solver calls",
-          kissat_export_literal (solver, LIT (idx)), equivalences, solved);
+  if (worker)
+    return;
+  equivalences = solver->statistics.sweep_equivalences - equivalences;
+  solved = solver->statistics.sweep_solved - solved;
+  if (equivalences)
+    kissat_extremely_verbose (
+        solver,
+        "complete swept variable %d partition with %" PRIu64
+        " equivalences in %" PRIu64 " solver calls",
+        kissat_export_literal (solver, LIT (PEEK_STACK (sweeper->vars, 0))),
+        equivalences, solved);
+#endif
+}
+
+static void sweep_environment (sweeper *sweeper) {
+#ifdef LOGGING
+  kissat *solver = sweeper->solver;
 #endif
+  int res = sweep_solve (sweeper);
+  LOG ("sub-solver returns '%d'", res);
+  if (res == 10) {
+    init_backbone_and_partition (sweeper);
+    if (sweep_backbone (sweeper))
+      sweep_partition (sweeper);
   } else if (res == 20)
     sweep_empty_clause (sweeper);
+}
 
-DONE:
-  clear_sweeper (sweeper);
-
-  if (!solver->inconsistent && !kissat_propagated (solver))
-    (void) kissat_dense_propagate (solver);
-
+static const char *sweep_result (sweeper *sweeper) {
+  const bool success = sweeper->success;
+  const bool limit_reached = sweeper->limit_reached;
   if (success && limit_reached)
     return "successfully despite reaching limit";
   if (!success && !limit_reached)
@@ -1460,6 +1618,22 @@ DONE:
   return "unsuccessfully and reached limit";
 }
 
+static const char *sweep_variable (sweeper *sweeper, unsigned idx) {
+  kissat *solver = sweeper->solver;
+  const char *reason;
+  if (!sweepable_variable (sweeper, idx, &reason))
+    return reason;
+
+  encode_environment (sweeper, idx);
+  sweep_environment (sweeper);
+  clear_sweeper (sweeper);
+
+  if (!solver->inconsistent && !kissat_propagated (solver))
+    (void) kissat_dense_propagate (solver);
+
+  return sweep_result (sweeper);
+}
+
 typedef struct sweep_candidate sweep_candidate;
 
 struct sweep_candidate {
@@ -1645,6 +1819,192 @@ static void unschedule_sweeping (sweeper *sweeper, unsigned swept,
                 kissat_percent (incomplete, scheduled));
 }
 
+/*------------------------------------------------------------------------*/
+
+// Concurrent sweeping ('sweepthreads > 1') pops a batch of scheduled
+// variables and encodes their environments with the main sweeper into the
+// detached kittens of worker sweepers.  Environments may overlap, since
+// workers only read the solver.  Each worker gets the same share of the
+// remaining ticks budget.  Then the workers search for backbones and
+// equivalences concurrently.  Their deferred results are merged afterwards
+// in the order of the batch (see 'parallel.h') through the same core, unit
+// and substitution code as in sequential sweeping.  Equivalences are
+// dropped if one of their literals became assigned or was substituted by
+// merging an earlier result.
+
+#define SWEEP_BATCH_PER_THREAD 4
+
+typedef struct workers workers;
+
+struct workers {
+  unsigned threads;
+  unsigned size;
+  unsigned capacity;
+  sweeper *sweepers;
+  statistics *statistics;
+};
+
+static void init_workers (sweeper *sweeper, workers *workers,
+                          unsigned threads) {
+  kissat *solver = sweeper->solver;
+  workers->threads = threads;
+  workers->size = 0;
+  workers->capacity = threads * SWEEP_BATCH_PER_THREAD;
+  CALLOC (workers->sweepers, workers->capacity);
+  CALLOC (workers->statistics, workers->capacity);
+  for (unsigned i = 0; i != workers->capacity; i++) {
+    struct sweeper *worker = workers->sweepers + i;
+    worker->solver = solver;
+    worker->statistics = workers->statistics + i;
+    worker->kitten = kitten_detached (solver, worker->statistics);
+    kitten_track_antecedents (worker->kitten);
+    worker->worker = true;
+    worker->reprs = sweeper->reprs;
+    worker->first = worker->last = INVALID_IDX;
+    worker->limit = sweeper->limit;
+  }
+}
+
+static void release_workers (sweeper *sweeper, workers *workers) {
+  kissat *solver = sweeper->solver;
+  for (unsigned i = 0; i != workers->capacity; i++) {
+    struct sweeper *worker = workers->sweepers + i;
+    kitten_release (worker->kitten);
+    release_sweeper_stack (worker, &worker->vars);
+    release_sweeper_stack (worker, &worker->backbone);
+    release_sweeper_stack (worker, &worker->partition);
+    release_sweeper_stack (worker, &worker->core[0]);
+    release_sweeper_stack (worker, &worker->core[1]);
+    release_sweeper_stack (worker, &worker->deferred);
+  }
+  DEALLOC (workers->sweepers, workers->capacity);
+  DEALLOC (workers->statistics, workers->capacity);
+}
+
+static void schedule_workers (sweeper *sweeper, workers *workers,
+                              uint64_t *swept) {
+  kissat *solver = sweeper->solver;
+  kitten *const kitten = sweeper->kitten;
+  workers->size = 0;
+  while (workers->size < workers->capacity) {
+    const unsigned idx = next_scheduled (sweeper);
+    if (idx == INVALID_IDX)
+      break;
+    FLAGS (idx)->sweep = false;
+    *swept += 1;
+    const char *reason;
+    if (!sweepable_variable (sweeper, idx, &reason)) {
+      kissat_extremely_verbose (solver, "skipped external variable %d %s",
+                                kissat_export_literal (solver, LIT (idx)),
+                                reason);
+      continue;
+    }
+    struct sweeper *worker = workers->sweepers + workers->size++;
+    sweeper->kitten = worker->kitten;
+    encode_environment (sweeper, idx);
+    worker->success = false;
+    worker->limit_reached = sweeper->limit_reached;
+    for (all_stack (unsigned, other, sweeper->vars))
+      push_sweeper_stack (worker, &worker->vars, other);
+    clear_environment (sweeper);
+  }
+  sweeper->kitten = kitten;
+
+  const unsigned size = workers->size;
+  if (!size)
+    return;
+  uint64_t remaining = 0;
+  if (solver->statistics.kitten_ticks < sweeper->limit.ticks)
+    remaining = sweeper->limit.ticks - solver->statistics.kitten_ticks;
+  const uint64_t share = remaining / size;
+  for (unsigned i = 0; i != size; i++) {
+    struct sweeper *worker = workers->sweepers + i;
+    const uint64_t ticks = worker->statistics->kitten_ticks;
+    worker->limit.ticks = UINT64_MAX - share <= ticks ? UINT64_MAX
+                                                      : ticks + share;
+    set_kitten_ticks_limit (worker);
+  }
+  LOG ("scheduled %u environments with %" PRIu64 " ticks each", size,
+       share);
+}
+
+static void sweep_worker (void *state, unsigned task, unsigned thread) {
+  workers *workers = state;
+  assert (task < workers->size);
+  sweep_environment (workers->sweepers + task);
+  (void) thread;
+}
+
+static void merge_statistics (kissat *solver, statistics *statistics) {
+  uint64_t *dst = (uint64_t *) &solver->statistics;
+  uint64_t *src = (uint64_t *) statistics;
+  const size_t size = sizeof *statistics / sizeof (uint64_t);
+  for (size_t i = 0; i != size; i++)
+    dst[i] += src[i], src[i] = 0;
+}
+
+static bool mergeable_equivalence (sweeper *sweeper, unsigned lit,
+                                   unsigned other) {
+  kissat *solver = sweeper->solver;
+  if (solver->inconsistent)
+    return false;
+  if (VALUE (lit) || VALUE (other))
+    return false;
+  if (sweep_repr (sweeper, lit) != lit)
+    return false;
+  if (sweep_repr (sweeper, other) != other)
+    return false;
+  return true;
+}
+
+static void merge_worker (sweeper *sweeper, struct sweeper *worker) {
+  kissat *solver = sweeper->solver;
+  merge_statistics (solver, worker->statistics);
+  const unsigned *const end = END_STACK (worker->deferred);
+  const unsigned *p = BEGIN_STACK (worker->deferred);
+  while (p != end) {
+    const unsigned lit = p[0], other = p[1];
+    p = undefer_cores (worker, p);
+    if (other == INVALID_LIT) {
+      add_core (worker, 0);
+      clear_core (worker, 0);
+    } else if (mergeable_equivalence (sweeper, lit, other))
+      (void) merge_equivalence (sweeper, worker, lit, other);
+    else
+      LOG ("dropping deferred sweep equivalence %s = %s", LOGLIT (lit),
+           LOGLIT (other));
+    CLEAR_STACK (worker->core[0]);
+    CLEAR_STACK (worker->core[1]);
+  }
+  CLEAR_STACK (worker->deferred);
+  kissat_extremely_verbose (
+      solver, "swept external variable %d %s",
+      kissat_export_literal (solver, LIT (PEEK_STACK (worker->vars, 0))),
+      sweep_result (worker));
+  kitten_clear (worker->kitten);
+  kitten_track_antecedents (worker->kitten);
+  CLEAR_STACK (worker->vars);
+  CLEAR_STACK (worker->backbone);
+  CLEAR_STACK (worker->partition);
+
+  if (!solver->inconsistent && !kissat_propagated (solver))
+    (void) kissat_dense_propagate (solver);
+}
+
+static bool sweep_concurrently (sweeper *sweeper, workers *workers,
+                                uint64_t *swept) {
+  schedule_workers (sweeper, workers, swept);
+  const unsigned size = workers->size;
+  if (!size)
+    return false;
+  kissat *solver = sweeper->solver;
+  kissat_parallel_for (solver, workers->threads, size, sweep_worker,
+                       workers);
+  for (unsigned i = 0; i != size; i++)
+    merge_worker (sweeper, workers->sweepers + i);
+  return true;
+}
+
 bool kissat_sweep (kissat *solver) {
   if (!GET_OPTION (sweep))
     return false;
@@ -1664,6 +2024,10 @@ bool kissat_sweep (kissat *solver) {
   sweeper sweeper;
   init_sweeper (solver, &sweeper);
   const unsigned scheduled = schedule_sweeping (&sweeper);
+  const unsigned threads = GET_OPTION (sweepthreads);
+  workers workers;
+  if (threads > 1)
+    init_workers (&sweeper, &workers, threads);
   uint64_t swept = 0, limit = 10;
   for (;;) {
     if (solver->inconsistent)
@@ -1672,26 +2036,35 @@ bool kissat_sweep (kissat *solver) {
       break;
     if (solver->statistics.kitten_ticks > sweeper.limit.ticks)
       break;
-    unsigned idx = next_scheduled (&sweeper);
-    if (idx == INVALID_IDX)
-      break;
-    FLAGS (idx)->sweep = false;
+    if (threads > 1) {
+      if (!sweep_concurrently (&sweeper, &workers, &swept))
+        break;
+    } else {
+      unsigned idx = next_scheduled (&sweeper);
+      if (idx == INVALID_IDX)
+        break;
+      FLAGS (idx)->sweep = false;
 #ifndef QUIET
-    const char *res =
+      const char *res =
 #endif
-        sweep_variable (&sweeper, idx);
-    kissat_extremely_verbose (
-        solver, "swept[%" PRIu64 "] external variable %d %s", swept,
-        kissat_export_literal (solver, LIT (idx)), res);
-    if (++swept == limit) {
+          sweep_variable (&sweeper, idx);
+      kissat_extremely_verbose (
+          solver, "swept[%" PRIu64 "] external variable %d %s", swept,
+          kissat_export_literal (solver, LIT (idx)), res);
+      swept++;
+    }
+    if (swept >= limit) {
       kissat_very_verbose (solver,
                            "found %" PRIu64 " equivalences and %" PRIu64
                            " units after sweeping %" PRIu64 " variables ",
                            statistics->sweep_equivalences - equivalences,
                            solver->statistics.sweep_units - units, swept);
-      limit *= 10;
+      while (swept >= limit)
+        limit *= 10;
     }
   }
+  if (threads > 1)
+    release_workers (&sweeper, &workers);
   kissat_very_verbose (solver, "swept %" PRIu64 " variables", swept);
   equivalences = statistics->sweep_equivalences - equivalences,
   units = solver->statistics.sweep_units - units;
@@ -1719,6 +2092,7 @@ bool kissat_sweep (kissat *solver) {
     BUMP_DELAY (sweep);
   else
     REDUCE_DELAY (sweep);
+  STOP_PAYOFF (sweep, kitten_ticks);
   STOP (sweep);
   return eliminated;
 }
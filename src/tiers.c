@@ -60,6 +60,24 @@ void kissat_compute_and_set_tier_limits (struct kissat *solver) {
                 stable ? "stable" : "focused", tier1, tier2, CONFLICTS);
 }
 
+// Under memory pressure (see 'pressure.h') clauses in tier two are no
+// longer protected by frequent use and at the highest level tier one is
+// narrowed too, which leaves more learned clauses reducible.
+
+void kissat_get_reduce_tier_limits (kissat *solver, unsigned *tier1_ptr,
+                                    unsigned *tier2_ptr) {
+  unsigned tier1 = TIER1;
+  unsigned tier2 = MAX (tier1, TIER2);
+  const unsigned pressure = solver->pressure;
+  if (pressure > 2 && tier1 > 1)
+    tier1--;
+  if (pressure > 1)
+    tier2 = tier1;
+  assert (tier1 <= tier2);
+  *tier1_ptr = tier1;
+  *tier2_ptr = tier2;
+}
+
 static unsigned decimal_digits (uint64_t i) {
   unsigned res = 1;
   uint64_t limit = 10;
@@ -6,6 +6,8 @@
 struct kissat;
 
 void kissat_compute_and_set_tier_limits (struct kissat *);
+void kissat_get_reduce_tier_limits (struct kissat *, unsigned *tier1_ptr,
+                                    unsigned *tier2_ptr);
 void kissat_print_tier_usage_statistics (struct kissat *solver,
                                          bool stable);
 
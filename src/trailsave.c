@@ -0,0 +1,189 @@
+#include "trailsave.h"
+#include "fastassign.h"
+#include "internal.h"
+#include "logging.h"
+
+void kissat_clear_saved_trail (kissat *solver) {
+  saved_trail *saved = &solver->saved_trail;
+  if (EMPTY_STACK (saved->literals))
+    return;
+  LOG ("clearing %zu saved trail literals", SIZE_STACK (saved->literals));
+  CLEAR_STACK (saved->literals);
+  saved->next = 0;
+}
+
+void kissat_release_saved_trail (kissat *solver) {
+  RELEASE_STACK (solver->saved_trail.literals);
+}
+
+void kissat_save_trail (kissat *solver, unsigned new_level, bool restart) {
+  kissat_clear_saved_trail (solver);
+  if (!GET_OPTION (trailsave))
+    return;
+  if (solver->probing)
+    return;
+  assert (new_level < solver->level);
+  saved_trail *saved = &solver->saved_trail;
+  const assigned *const assigned = solver->assigned;
+  const unsigned *const begin = BEGIN_ARRAY (solver->trail);
+  const unsigned *const end = END_ARRAY (solver->trail);
+  for (const unsigned *p = begin + FRAME (new_level + 1).trail; p != end;
+       p++) {
+    const unsigned lit = *p;
+    const struct assigned *const a = assigned + IDX (lit);
+    if (a->level <= new_level)
+      continue;
+    saved_literal s;
+    s.lit = lit;
+    s.level = a->level;
+    s.binary = a->binary;
+    s.reason = a->reason;
+    PUSH_STACK (saved->literals, s);
+  }
+  saved->restart = restart && GET_OPTION (trailsave) > 1;
+  saved->level = new_level;
+  saved->conflicts = CONFLICTS;
+  saved->added = solver->statistics.clauses_added;
+  saved->clauses = CLAUSES;
+  INC (trail_saved);
+  LOG ("saved %zu trail literals above level %u",
+       SIZE_STACK (saved->literals), new_level);
+}
+
+static bool replayed_assignment_unchanged (kissat *solver,
+                                           saved_trail *saved) {
+  return saved->restart && saved->conflicts == CONFLICTS &&
+         saved->added == solver->statistics.clauses_added &&
+         saved->clauses == CLAUSES;
+}
+
+#ifndef NDEBUG
+
+static void check_saved_reason (kissat *solver, unsigned lit,
+                                clause *reason) {
+  const value *const values = solver->values;
+  bool found = false;
+  for (all_literals_in_clause (other, reason))
+    if (other == lit)
+      found = true;
+    else
+      assert (values[other] < 0);
+  assert (found);
+}
+
+#else
+#define check_saved_reason(...) \
+  do { \
+  } while (0)
+#endif
+
+static uint64_t skipped_propagation_ticks (kissat *solver,
+                                           const unsigned *begin,
+                                           const unsigned *end) {
+  uint64_t ticks = 0;
+  for (const unsigned *p = begin; p != end; p++) {
+    watches *const watches = &WATCHES (NOT (*p));
+    const size_t size_watches = SIZE_WATCHES (*watches);
+    ticks += 1 + kissat_cache_lines (size_watches, sizeof (watch));
+  }
+  return ticks;
+}
+
+clause *kissat_replay_saved_trail (kissat *solver) {
+  assert (!solver->probing);
+  saved_trail *saved = &solver->saved_trail;
+  saved_literal *const begin = BEGIN_STACK (saved->literals);
+  const saved_literal *const end = END_STACK (saved->literals);
+  saved_literal *p = begin + saved->next;
+  const unsigned level = solver->level;
+  assert (p < end);
+  assert (p->level == level);
+  const unsigned decision = FRAME (level).decision;
+  const unsigned *const propagate = solver->propagate;
+  if (p->binary || p->reason != DECISION_REASON || p->lit != decision ||
+      propagate + 1 != END_ARRAY (solver->trail)) {
+    LOG ("decision %s on level %u differs from saved trail",
+         LOGLIT (decision), level);
+    kissat_clear_saved_trail (solver);
+    return 0;
+  }
+  assert (*propagate == decision);
+  LOG ("replaying saved trail on level %u after decision %s", level,
+       LOGLIT (decision));
+  INC (trail_replays);
+  value *const values = solver->values;
+  assigned *const assigned = solver->assigned;
+  bool unchanged = replayed_assignment_unchanged (solver, saved);
+  bool invalid = false;
+  clause *res = 0;
+  unsigned replayed = 0;
+  uint64_t ticks = 0;
+  while (++p != end) {
+    if (!p->binary && p->reason == DECISION_REASON)
+      break;
+    const unsigned lit = p->lit;
+    if (p->level != level) {
+      LOG ("saved %s on different level %u", LOGLIT (lit), p->level);
+      invalid = true;
+      break;
+    }
+    const value value = values[lit];
+    if (value > 0) {
+      LOG ("saved %s already assigned", LOGLIT (lit));
+      unchanged = false;
+      continue;
+    }
+    if (p->binary) {
+      const unsigned other = p->reason;
+      assert (values[other] < 0);
+      if (value < 0) {
+        res = kissat_binary_conflict (solver, lit, other);
+        break;
+      }
+      kissat_fast_assign (solver, false, level, values, assigned, true, lit,
+                          other);
+      LOGBINARY (lit, other, "replayed %s reason", LOGLIT (lit));
+    } else {
+      const reference ref = p->reason;
+      clause *const reason = kissat_dereference_clause (solver, ref);
+      ticks++;
+      if (reason->garbage ||
+          (reason->lits[0] != lit && reason->lits[1] != lit)) {
+        LOGREF (ref, "saved %s reason changed", LOGLIT (lit));
+        invalid = true;
+        break;
+      }
+      check_saved_reason (solver, lit, reason);
+      if (value < 0) {
+        res = reason;
+        break;
+      }
+      kissat_fast_assign (solver, false, level, values, assigned, false,
+                          lit, ref);
+      LOGREF (ref, "replayed %s reason", LOGLIT (lit));
+    }
+    replayed++;
+  }
+  solver->ticks += ticks;
+  ADD (trail_replayed, replayed);
+  LOG ("replayed %u saved trail literals", replayed);
+  if (res) {
+    LOGCLS (res, "replayed conflicting");
+    INC (trail_replay_conflicts);
+    kissat_clear_saved_trail (solver);
+  } else if (invalid)
+    kissat_clear_saved_trail (solver);
+  else {
+    saved->next = p - begin;
+    if (unchanged) {
+      const unsigned *const end_trail = END_ARRAY (solver->trail);
+      LOG ("skipping propagation of %zu replayed literals",
+           (size_t) (end_trail - propagate));
+      ADD (trail_skipped, replayed);
+      ADD (trail_saved_ticks,
+           skipped_propagation_ticks (solver, propagate, end_trail));
+      solver->propagate = (unsigned *) end_trail;
+    }
+  }
+  return res;
+}
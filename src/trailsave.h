@@ -0,0 +1,56 @@
+#ifndef _trailsave_h_INCLUDED
+#define _trailsave_h_INCLUDED
+
+#include "stack.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Trail saving (option 'trailsave').  Before backtracking after a
+// conflict or during a restart the literals on the undone part of the
+// trail are saved together with their reasons.  If the search later
+// takes the same decision on the same level again, the saved implied
+// literals of that level are assigned directly with their saved reasons
+// instead of being derived through watch lists.  This is sound as long as
+// the kept part of the trail has only grown since saving and the reason
+// clauses have not been changed, which is ensured by clearing the saved
+// trail on backtracking below the saved level, during inprocessing,
+// reduction and garbage collection and by checking that the saved reason
+// still has the literal as one of its watches.  If the trail was saved
+// during a restart and no clause was added nor removed since then, the
+// assignment is exactly the one which was already completely propagated
+// before the restart and thus propagating replayed levels is skipped.
+
+typedef struct saved_literal saved_literal;
+typedef struct saved_trail saved_trail;
+
+struct saved_literal {
+  unsigned lit;
+  unsigned level;
+  bool binary;
+  unsigned reason;
+};
+
+// clang-format off
+typedef STACK (saved_literal) saved_literals;
+// clang-format on
+
+struct saved_trail {
+  bool restart;
+  unsigned level;
+  unsigned next;
+  uint64_t conflicts;
+  uint64_t added;
+  uint64_t clauses;
+  saved_literals literals;
+};
+
+struct kissat;
+struct clause;
+
+void kissat_save_trail (struct kissat *, unsigned new_level, bool restart);
+void kissat_clear_saved_trail (struct kissat *);
+void kissat_release_saved_trail (struct kissat *);
+struct clause *kissat_replay_saved_trail (struct kissat *);
+
+#endif
@@ -317,7 +317,7 @@ void kissat_transitive_reduction (kissat *solver) {
   uint64_t reduced = 0;
   unsigned units = 0;
 
-  SET_EFFORT_LIMIT (limit, transitive, transitive_ticks);
+  SET_SCHEDULED_EFFORT_LIMIT (limit, transitive, transitive_ticks);
 
 #ifndef QUIET
   const unsigned active = solver->active;
@@ -382,6 +382,7 @@ void kissat_transitive_reduction (kissat *solver) {
   solver->transitive_reducing = false;
 #endif
   REPORT (!success, 't');
+  STOP_PAYOFF (transitive, transitive_ticks);
   STOP (transitive);
 #ifdef QUIET
   (void) success;
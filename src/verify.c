@@ -0,0 +1,707 @@
+#ifndef NPROOFS
+
+#include "verify.h"
+#include "allocate.h"
+#include "error.h"
+#include "internal.h"
+#include "logging.h"
+#include "print.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+// Proof lines are appended by the solver thread as tag, literals and a
+// terminating zero to the current chunk.  Full chunks are handed over to
+// the verifier thread through a ring of 'size_chunks' chunks, similar to
+// the proof writer in 'proof.c'.  The solver thread only waits if the
+// verifier falls behind by all chunks in the ring.  If the verifier thread
+// can not be started, full chunks are checked synchronously instead.
+
+#define size_chunk (1u << 16)
+#define size_chunks 8
+
+enum verify_tag {
+  VERIFY_ORIGINAL = 1,
+  VERIFY_ADDED = 2,
+  VERIFY_DELETED = 3,
+};
+
+// Variables are 'original' if they occur in an original clause first and
+// 'extension' variables if they occur in an added clause first.  Only the
+// latter can be introduced by definitions and thus the pure and blocked
+// literal exceptions only apply to literals of extension variables.  An
+// original clause on an extension variable later on (incrementally) is
+// considered a failure as it might invalidate such definitions.
+
+enum verify_origin {
+  UNSEEN_VARIABLE = 0,
+  ORIGINAL_VARIABLE = 1,
+  EXTENSION_VARIABLE = 2,
+};
+
+typedef struct line line;
+
+// clang-format off
+
+typedef STACK (line *) lines;
+
+// clang-format on
+
+struct line {
+  line *next;
+  unsigned size;
+  unsigned hash;
+  unsigned lits[];
+};
+
+struct verifier {
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t filled;
+  pthread_cond_t emptied;
+  uint64_t published;
+  uint64_t consumed;
+  bool stop;
+  bool threaded;
+
+  ints *chunk;
+  ints chunks[size_chunks];
+
+  bool failed;
+  bool failed_original;
+  bool inconsistent;
+
+  unsigned vars;
+  unsigned size;
+
+  unsigned count;
+  unsigned hashed;
+  line **table;
+
+  lines *watches;
+  signed char *values;
+  bool *marks;
+  bool *used;
+  bool *large;
+  signed char *origins;
+
+  unsigneds imported;
+  unsigneds trail;
+  unsigned propagated;
+
+  ints failure;
+
+  uint64_t added;
+  uint64_t blocked;
+  uint64_t deleted;
+  uint64_t ignored;
+  uint64_t originals;
+  uint64_t propagations;
+  uint64_t pure;
+};
+
+#define VERIFIER_LITS (2 * verifier->vars)
+#define VALID_VERIFIER_LIT(LIT) ((LIT) < VERIFIER_LITS)
+
+static size_t bytes_verifier_line (unsigned size) {
+  return sizeof (line) + size * sizeof (unsigned);
+}
+
+static void resize_verifier (verifier *verifier, unsigned new_vars) {
+  kissat *const solver = 0;
+  const unsigned vars = verifier->vars;
+  const unsigned size = verifier->size;
+  if (new_vars > size) {
+    unsigned new_size = size ? 2 * size : 1;
+    while (new_size < new_vars)
+      new_size *= 2;
+    const unsigned size2 = 2 * size;
+    const unsigned new_size2 = 2 * new_size;
+    verifier->marks = kissat_realloc (solver, verifier->marks, size2,
+                                      new_size2 * sizeof (bool));
+    verifier->used = kissat_realloc (solver, verifier->used, size2,
+                                     new_size2 * sizeof (bool));
+    verifier->large = kissat_realloc (solver, verifier->large, size2,
+                                      new_size2 * sizeof (bool));
+    verifier->values =
+        kissat_realloc (solver, verifier->values, size2, new_size2);
+    verifier->origins =
+        kissat_realloc (solver, verifier->origins, size, new_size);
+    verifier->watches = kissat_realloc (
+        solver, verifier->watches, size2 * sizeof *verifier->watches,
+        new_size2 * sizeof *verifier->watches);
+    verifier->size = new_size;
+  }
+  const unsigned vars2 = 2 * vars;
+  const unsigned delta2 = 2 * (new_vars - vars);
+  memset (verifier->watches + vars2, 0,
+          delta2 * sizeof *verifier->watches);
+  memset (verifier->marks + vars2, 0, delta2);
+  memset (verifier->used + vars2, 0, delta2);
+  memset (verifier->large + vars2, 0, delta2);
+  memset (verifier->values + vars2, 0, delta2);
+  memset (verifier->origins + vars, 0, new_vars - vars);
+  verifier->vars = new_vars;
+}
+
+static void import_verifier_literals (verifier *verifier, size_t size,
+                                      const int *elits) {
+  kissat *const solver = 0;
+  CLEAR_STACK (verifier->imported);
+  for (size_t i = 0; i != size; i++) {
+    const int elit = elits[i];
+    assert (elit);
+    assert (elit != INT_MIN);
+    const unsigned idx = ABS (elit) - 1;
+    if (idx >= verifier->vars)
+      resize_verifier (verifier, idx + 1);
+    const unsigned lit = 2 * idx + (elit < 0);
+    PUSH_STACK (verifier->imported, lit);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+static inline unsigned hash_verifier_literal (unsigned lit) {
+  uint64_t res = (lit + 1) * 0x9e3779b97f4a7c15ull;
+  res ^= res >> 29;
+  return (unsigned) (res ^ (res >> 32));
+}
+
+// Sum of literal hashes, thus independent of the order of literals.
+
+static unsigned hash_imported (verifier *verifier) {
+  unsigned res = 0;
+  for (all_stack (unsigned, lit, verifier->imported))
+    res += hash_verifier_literal (lit);
+  return res;
+}
+
+static void resize_verifier_table (verifier *verifier) {
+  kissat *const solver = 0;
+  const unsigned old_hashed = verifier->hashed;
+  const unsigned new_hashed = old_hashed ? 2 * old_hashed : 1024;
+  line **table = kissat_calloc (solver, new_hashed, sizeof *table);
+  line **old_table = verifier->table;
+  const unsigned mask = new_hashed - 1;
+  for (unsigned i = 0; i != old_hashed; i++)
+    for (line *line = old_table[i], *next; line; line = next) {
+      next = line->next;
+      struct line **p = table + (line->hash & mask);
+      line->next = *p;
+      *p = line;
+    }
+  kissat_dealloc (solver, old_table, old_hashed, sizeof *old_table);
+  verifier->hashed = new_hashed;
+  verifier->table = table;
+}
+
+static bool match_imported (verifier *verifier, unsigned hash,
+                            const line *line) {
+  const size_t size = SIZE_STACK (verifier->imported);
+  if (line->size != size)
+    return false;
+  if (line->hash != hash)
+    return false;
+  const bool *const marks = verifier->marks;
+  const unsigned *const end = line->lits + size;
+  for (const unsigned *p = line->lits; p != end; p++)
+    if (!marks[*p])
+      return false;
+  return true;
+}
+
+static line *remove_imported_line (verifier *verifier) {
+  if (!verifier->hashed)
+    return 0;
+  const unsigned hash = hash_imported (verifier);
+  bool *const marks = verifier->marks;
+  for (all_stack (unsigned, lit, verifier->imported))
+    marks[lit] = true;
+  line **p = verifier->table + (hash & (verifier->hashed - 1)), *line;
+  while ((line = *p) && !match_imported (verifier, hash, line))
+    p = &line->next;
+  for (all_stack (unsigned, lit, verifier->imported))
+    marks[lit] = false;
+  if (line)
+    *p = line->next;
+  return line;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void verifier_assign (verifier *verifier, unsigned lit) {
+  kissat *const solver = 0;
+  assert (VALID_VERIFIER_LIT (lit));
+  signed char *const values = verifier->values;
+  const unsigned not_lit = lit ^ 1;
+  assert (!values[lit]);
+  assert (!values[not_lit]);
+  values[lit] = 1;
+  values[not_lit] = -1;
+  PUSH_STACK (verifier->trail, lit);
+}
+
+static void watch_verifier_literal (verifier *verifier, line *line,
+                                    unsigned lit) {
+  kissat *const solver = 0;
+  PUSH_STACK (verifier->watches[lit], line);
+}
+
+static bool verifier_propagate (verifier *verifier) {
+  unsigned propagated = verifier->propagated;
+  signed char *const values = verifier->values;
+  bool res = true;
+  while (res && propagated < SIZE_STACK (verifier->trail)) {
+    const unsigned lit = PEEK_STACK (verifier->trail, propagated);
+    const unsigned not_lit = lit ^ 1;
+    propagated++;
+    lines *watches = verifier->watches + not_lit;
+    line **q = BEGIN_STACK (*watches);
+    line *const *p = q, *const *const end_of_lines = END_STACK (*watches);
+    while (p != end_of_lines) {
+      line *line = *q++ = *p++;
+      if (!res)
+        continue;
+      unsigned *lits = line->lits;
+      const unsigned other = not_lit ^ lits[0] ^ lits[1];
+      const signed char other_value = values[other];
+      if (other_value > 0)
+        continue;
+      const unsigned *const end_of_lits = lits + line->size;
+      unsigned replacement = INVALID_LIT, *r;
+      signed char replacement_value = -1;
+      for (r = lits + 2; r != end_of_lits; r++) {
+        replacement = *r;
+        if (replacement == other || replacement == not_lit)
+          continue;
+        replacement_value = values[replacement];
+        if (replacement_value >= 0)
+          break;
+      }
+      if (replacement_value >= 0) {
+        lits[0] = other;
+        lits[1] = replacement;
+        *r = not_lit;
+        watch_verifier_literal (verifier, line, replacement);
+        q--;
+      } else if (other_value < 0)
+        res = false;
+      else
+        verifier_assign (verifier, other);
+    }
+    SET_END_OF_STACK (*watches, q);
+  }
+  verifier->propagations += propagated - verifier->propagated;
+  verifier->propagated = propagated;
+  return res;
+}
+
+static void verifier_backtrack (verifier *verifier, unsigned saved) {
+  signed char *const values = verifier->values;
+  const unsigned *const begin = BEGIN_STACK (verifier->trail) + saved;
+  const unsigned *p = END_STACK (verifier->trail);
+  while (p != begin) {
+    const unsigned lit = *--p;
+    values[lit] = values[lit ^ 1] = 0;
+  }
+  RESIZE_STACK (verifier->trail, saved);
+  verifier->propagated = saved;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Returns 'true' if the imported clause is trivial, satisfied, unit or
+// empty at the root level, in which case it is not inserted (units are
+// assigned though).  Otherwise the two first literals are unassigned.
+
+static bool simplify_imported (verifier *verifier) {
+  unsigned *const lits = BEGIN_STACK (verifier->imported);
+  const unsigned *const end = END_STACK (verifier->imported);
+  const signed char *const values = verifier->values;
+  bool *const marks = verifier->marks;
+  unsigned non_false = 0;
+  bool res = false;
+  unsigned *p;
+  for (p = lits; !res && p != end; p++) {
+    const unsigned lit = *p;
+    if (marks[lit])
+      continue;
+    marks[lit] = true;
+    if (marks[lit ^ 1])
+      res = true;
+    else {
+      const signed char value = values[lit];
+      if (value > 0)
+        res = true;
+      else if (!value) {
+        if (non_false < 2)
+          SWAP (unsigned, *p, lits[non_false]);
+        non_false++;
+      }
+    }
+  }
+  for (const unsigned *q = lits; q != p; q++)
+    marks[*q] = false;
+  if (res)
+    return true;
+  if (!non_false) {
+    verifier->inconsistent = true;
+    return true;
+  }
+  if (non_false == 1) {
+    verifier_assign (verifier, lits[0]);
+    return true;
+  }
+  return false;
+}
+
+static void insert_imported (verifier *verifier) {
+  kissat *const solver = 0;
+  if (verifier->inconsistent)
+    return;
+  const unsigned hash = hash_imported (verifier);
+  if (simplify_imported (verifier))
+    return;
+  if (verifier->count == verifier->hashed)
+    resize_verifier_table (verifier);
+  const unsigned size = SIZE_STACK (verifier->imported);
+  line *line = kissat_malloc (solver, bytes_verifier_line (size));
+  line->size = size;
+  line->hash = hash;
+  memcpy (line->lits, BEGIN_STACK (verifier->imported),
+          size * sizeof (unsigned));
+  struct line **p = verifier->table + (hash & (verifier->hashed - 1));
+  line->next = *p;
+  *p = line;
+  verifier->count++;
+  watch_verifier_literal (verifier, line, line->lits[0]);
+  watch_verifier_literal (verifier, line, line->lits[1]);
+  const bool large = size > 2;
+  for (all_stack (unsigned, lit, verifier->imported)) {
+    verifier->used[lit] = true;
+    if (large)
+      verifier->large[lit] = true;
+  }
+}
+
+static bool verifier_extension_literal (verifier *verifier, unsigned lit) {
+  return verifier->origins[lit / 2] == EXTENSION_VARIABLE;
+}
+
+// Blocked binary clauses (clauses on extension variables) are accepted if
+// all binary clauses with the negation of one of their extension literals
+// are satisfied after propagating the negation of the checked clause.
+
+static bool verifier_blocked_literal (verifier *verifier, unsigned lit) {
+  const signed char *const values = verifier->values;
+  const unsigned not_lit = lit ^ 1;
+  if (!verifier_extension_literal (verifier, lit))
+    return false;
+  if (verifier->large[not_lit])
+    return false;
+  for (all_pointers (line, watched, verifier->watches[not_lit])) {
+    bool satisfied = false;
+    const unsigned *const end = watched->lits + watched->size;
+    for (const unsigned *p = watched->lits; !satisfied && p != end; p++)
+      satisfied = (*p != not_lit && values[*p] > 0);
+    if (!satisfied)
+      return false;
+  }
+  return true;
+}
+
+static bool verifier_blocked_imported (verifier *verifier) {
+  for (all_stack (unsigned, lit, verifier->imported))
+    if (verifier_blocked_literal (verifier, lit))
+      return true;
+  return false;
+}
+
+static bool check_imported (verifier *verifier) {
+  if (!verifier_propagate (verifier)) {
+    verifier->inconsistent = true;
+    return true;
+  }
+  const unsigned saved = SIZE_STACK (verifier->trail);
+  const signed char *const values = verifier->values;
+  bool res = false;
+  for (all_stack (unsigned, lit, verifier->imported)) {
+    const signed char value = values[lit];
+    if (value < 0)
+      continue;
+    if (value > 0) {
+      res = true;
+      break;
+    }
+    const unsigned not_lit = lit ^ 1;
+    if (!verifier->used[not_lit] &&
+        verifier_extension_literal (verifier, lit)) {
+      verifier->pure++;
+      res = true;
+      break;
+    }
+    verifier_assign (verifier, not_lit);
+  }
+  if (!res) {
+    if (!verifier_propagate (verifier))
+      res = true;
+    else if (verifier_blocked_imported (verifier)) {
+      verifier->blocked++;
+      res = true;
+    }
+  }
+  verifier_backtrack (verifier, saved);
+  return res;
+}
+
+static void delete_imported (verifier *verifier) {
+  kissat *const solver = 0;
+  if (!verifier_propagate (verifier)) {
+    verifier->inconsistent = true;
+    return;
+  }
+  const size_t size = SIZE_STACK (verifier->imported);
+  if (size < 2) {
+    verifier->ignored++;
+    return;
+  }
+  const signed char *const values = verifier->values;
+  for (all_stack (unsigned, lit, verifier->imported))
+    if (values[lit] > 0)
+      return;
+  line *line = remove_imported_line (verifier);
+  if (!line) {
+    verifier->ignored++;
+    return;
+  }
+  REMOVE_STACK (struct line *, verifier->watches[line->lits[0]], line);
+  REMOVE_STACK (struct line *, verifier->watches[line->lits[1]], line);
+  kissat_free (solver, line, bytes_verifier_line (line->size));
+  assert (verifier->count);
+  verifier->count--;
+}
+
+// Returns 'false' if an original clause contains an extension variable.
+
+static bool set_verifier_origins (verifier *verifier, int tag) {
+  const signed char origin =
+      tag == VERIFY_ORIGINAL ? ORIGINAL_VARIABLE : EXTENSION_VARIABLE;
+  signed char *const origins = verifier->origins;
+  bool res = true;
+  for (all_stack (unsigned, lit, verifier->imported)) {
+    signed char *const p = origins + lit / 2;
+    if (!*p)
+      *p = origin;
+    else if (tag == VERIFY_ORIGINAL && *p == EXTENSION_VARIABLE)
+      res = false;
+  }
+  return res;
+}
+
+static void verify_line (verifier *verifier, int tag, size_t size,
+                         const int *elits) {
+  kissat *const solver = 0;
+  if (tag == VERIFY_ORIGINAL)
+    verifier->originals++;
+  else if (tag == VERIFY_ADDED)
+    verifier->added++;
+  else {
+    assert (tag == VERIFY_DELETED);
+    verifier->deleted++;
+  }
+  if (verifier->inconsistent)
+    return;
+  import_verifier_literals (verifier, size, elits);
+  if (tag == VERIFY_DELETED)
+    delete_imported (verifier);
+  else if (!set_verifier_origins (verifier, tag)) {
+    verifier->failed = verifier->failed_original = true;
+    for (size_t i = 0; i != size; i++)
+      PUSH_STACK (verifier->failure, elits[i]);
+  } else if (tag == VERIFY_ORIGINAL || check_imported (verifier))
+    insert_imported (verifier);
+  else {
+    verifier->failed = true;
+    for (size_t i = 0; i != size; i++)
+      PUSH_STACK (verifier->failure, elits[i]);
+  }
+}
+
+static void verify_chunk (verifier *verifier, const ints *chunk) {
+  const int *p = BEGIN_STACK (*chunk);
+  const int *const end = END_STACK (*chunk);
+  while (p != end) {
+    const int tag = *p++;
+    const int *const elits = p;
+    while (*p)
+      p++;
+    const size_t size = p++ - elits;
+    if (!verifier->failed)
+      verify_line (verifier, tag, size, elits);
+  }
+}
+
+static void *verify_chunks (void *ptr) {
+  verifier *verifier = ptr;
+  pthread_mutex_lock (&verifier->lock);
+  for (;;) {
+    while (verifier->consumed == verifier->published && !verifier->stop)
+      pthread_cond_wait (&verifier->filled, &verifier->lock);
+    if (verifier->consumed == verifier->published)
+      break;
+    const ints *chunk = verifier->chunks + verifier->consumed % size_chunks;
+    pthread_mutex_unlock (&verifier->lock);
+    verify_chunk (verifier, chunk);
+    pthread_mutex_lock (&verifier->lock);
+    verifier->consumed++;
+    pthread_cond_signal (&verifier->emptied);
+  }
+  pthread_mutex_unlock (&verifier->lock);
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void hand_over_chunk (verifier *verifier) {
+  if (!verifier->threaded) {
+    verify_chunk (verifier, verifier->chunk);
+    CLEAR_STACK (*verifier->chunk);
+    return;
+  }
+  assert (verifier->chunk ==
+          verifier->chunks + verifier->published % size_chunks);
+  pthread_mutex_lock (&verifier->lock);
+  verifier->published++;
+  pthread_cond_signal (&verifier->filled);
+  while (verifier->published - verifier->consumed == size_chunks)
+    pthread_cond_wait (&verifier->emptied, &verifier->lock);
+  pthread_mutex_unlock (&verifier->lock);
+  ints *chunk = verifier->chunks + verifier->published % size_chunks;
+  CLEAR_STACK (*chunk);
+  verifier->chunk = chunk;
+}
+
+static void push_verifier_line (verifier *verifier, int tag, size_t size,
+                                const int *elits) {
+  kissat *const solver = 0;
+  ints *chunk = verifier->chunk;
+  PUSH_STACK (*chunk, tag);
+  for (size_t i = 0; i != size; i++)
+    PUSH_STACK (*chunk, elits[i]);
+  PUSH_STACK (*chunk, 0);
+  if (SIZE_STACK (*chunk) >= size_chunk)
+    hand_over_chunk (verifier);
+}
+
+void kissat_verify_original (verifier *verifier, size_t size,
+                             const int *elits) {
+  push_verifier_line (verifier, VERIFY_ORIGINAL, size, elits);
+}
+
+void kissat_verify_added (verifier *verifier, size_t size,
+                          const int *elits) {
+  push_verifier_line (verifier, VERIFY_ADDED, size, elits);
+}
+
+void kissat_verify_deleted (verifier *verifier, size_t size,
+                            const int *elits) {
+  push_verifier_line (verifier, VERIFY_DELETED, size, elits);
+}
+
+verifier *kissat_start_verifier (kissat *solver) {
+  verifier *verifier = kissat_calloc (0, 1, sizeof (struct verifier));
+  verifier->chunk = verifier->chunks;
+  pthread_mutex_init (&verifier->lock, 0);
+  pthread_cond_init (&verifier->filled, 0);
+  pthread_cond_init (&verifier->emptied, 0);
+  verifier->threaded =
+      !pthread_create (&verifier->thread, 0, verify_chunks, verifier);
+  if (verifier->threaded)
+    LOG ("started proof checking thread");
+  else
+    kissat_warning (solver, "failed to start proof checking thread "
+                            "(checking proof synchronously)");
+  return verifier;
+}
+
+static void release_verifier (verifier *verifier) {
+  kissat *const solver = 0;
+  for (unsigned i = 0; i != verifier->hashed; i++)
+    for (line *line = verifier->table[i], *next; line; line = next) {
+      next = line->next;
+      kissat_free (solver, line, bytes_verifier_line (line->size));
+    }
+  kissat_dealloc (solver, verifier->table, verifier->hashed,
+                  sizeof *verifier->table);
+  const unsigned size2 = 2 * verifier->size;
+  for (unsigned lit = 0; lit != VERIFIER_LITS; lit++)
+    RELEASE_STACK (verifier->watches[lit]);
+  kissat_dealloc (solver, verifier->watches, size2,
+                  sizeof *verifier->watches);
+  kissat_free (solver, verifier->marks, size2 * sizeof (bool));
+  kissat_free (solver, verifier->used, size2 * sizeof (bool));
+  kissat_free (solver, verifier->large, size2 * sizeof (bool));
+  kissat_free (solver, verifier->values, size2);
+  kissat_free (solver, verifier->origins, verifier->size);
+  RELEASE_STACK (verifier->imported);
+  RELEASE_STACK (verifier->trail);
+  RELEASE_STACK (verifier->failure);
+  for (unsigned i = 0; i != size_chunks; i++)
+    RELEASE_STACK (verifier->chunks[i]);
+  pthread_cond_destroy (&verifier->emptied);
+  pthread_cond_destroy (&verifier->filled);
+  pthread_mutex_destroy (&verifier->lock);
+  kissat_free (solver, verifier, sizeof (struct verifier));
+}
+
+void kissat_stop_verifier (kissat *solver, verifier *verifier) {
+  if (!EMPTY_STACK (*verifier->chunk))
+    hand_over_chunk (verifier);
+  if (verifier->threaded) {
+    pthread_mutex_lock (&verifier->lock);
+    verifier->stop = true;
+    pthread_cond_signal (&verifier->filled);
+    pthread_mutex_unlock (&verifier->lock);
+    pthread_join (verifier->thread, 0);
+    LOG ("stopped proof checking thread");
+  }
+  if (verifier->failed) {
+    kissat_fatal_message_start ();
+    if (verifier->failed_original)
+      fputs ("proof check failed for original clause "
+             "on extension variable:\n",
+             stderr);
+    else
+      fputs ("proof check failed for added clause:\n", stderr);
+    for (all_stack (int, elit, verifier->failure))
+      fprintf (stderr, "%d ", elit);
+    fputs ("0\n", stderr);
+    fflush (stderr);
+    kissat_abort ();
+  }
+  if (solver->inconsistent && !verifier->inconsistent)
+    kissat_fatal ("proof check failed to derive the empty clause");
+#ifndef QUIET
+  kissat_message (solver,
+                  "proof checked %" PRIu64 " added clauses%s%s",
+                  verifier->added,
+                  verifier->inconsistent ? " including empty clause" : "",
+                  verifier->threaded ? " in background thread" : "");
+  kissat_verbose (solver,
+                  "proof checker had %" PRIu64 " original, %" PRIu64
+                  " deleted (%" PRIu64 " ignored), %" PRIu64
+                  " pure and %" PRIu64 " blocked clauses",
+                  verifier->originals, verifier->deleted,
+                  verifier->ignored, verifier->pure, verifier->blocked);
+  kissat_verbose (solver, "proof checker propagated %" PRIu64 " literals",
+                  verifier->propagations);
+#endif
+  release_verifier (verifier);
+}
+
+#else
+int kissat_verify_dummy_to_avoid_warning;
+#endif
@@ -0,0 +1,32 @@
+#ifndef _verify_h_INCLUDED
+#define _verify_h_INCLUDED
+
+#ifndef NPROOFS
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+// Forward checking of the proof stream in a background thread (option
+// 'proofcheck').  Unlike the internal checker (see 'check.h'), which is
+// only available with assertions and runs on the solver thread, the
+// verifier only sees the external proof lines (original, added and
+// deleted clauses) which are passed to it in chunks.  Added clauses are
+// checked to be reverse unit propagation (RUP) implied, where the same
+// pure and blocked literal exceptions as in the internal checker are
+// accepted, but only for literals of extension variables, i.e., variables
+// which occur in an added clause before they occur in an original clause.
+
+struct kissat;
+
+typedef struct verifier verifier;
+
+verifier *kissat_start_verifier (struct kissat *);
+void kissat_stop_verifier (struct kissat *, verifier *);
+
+void kissat_verify_original (verifier *, size_t, const int *);
+void kissat_verify_added (verifier *, size_t, const int *);
+void kissat_verify_deleted (verifier *, size_t, const int *);
+
+#endif
+
+#endif
@@ -6,6 +6,7 @@
 #include "decide.h"
 #include "deduce.h"
 #include "inline.h"
+#include "parallel.h"
 #include "print.h"
 #include "promote.h"
 #include "proprobe.h"
@@ -49,30 +50,32 @@
 // Lower threshold = more clauses tried (less aggressive filtering)
 #define VIVIFY_ACTIVITY_THRESHOLD 0.01
 
-// Clause activity tracking
-static double *clause_activity = 0;
-static unsigned clause_activity_size = 0;
-
 // Initialize activity tracking
 static void init_vivify_activity (kissat *solver) {
   // Arena is STACK(ward), and reference is offset in ward units
+  // Activities live in the solver (not in a global) since several solvers
+  // might run concurrently in portfolio mode.
   size_t max_refs = SIZE_STACK (solver->arena);
-  if (max_refs > clause_activity_size) {
-    clause_activity =
-        kissat_realloc (solver, clause_activity,
-                        clause_activity_size * sizeof (double),
+  const size_t old_size = solver->vivify_activity_size;
+  if (max_refs > old_size) {
+    double *clause_activity =
+        kissat_realloc (solver, solver->vivify_activity,
+                        old_size * sizeof (double),
                         max_refs * sizeof (double));
-    memset (clause_activity + clause_activity_size, 0,
-            (max_refs - clause_activity_size) * sizeof (double));
-    clause_activity_size = max_refs;
+    memset (clause_activity + old_size, 0,
+            (max_refs - old_size) * sizeof (double));
+    solver->vivify_activity = clause_activity;
+    solver->vivify_activity_size = max_refs;
   }
 }
 
 // Decay all activities
-static void decay_vivify_activity (void) {
+static void decay_vivify_activity (kissat *solver) {
+  double *clause_activity = solver->vivify_activity;
   if (!clause_activity)
     return;
-  for (unsigned i = 0; i < clause_activity_size; i++)
+  const unsigned size = solver->vivify_activity_size;
+  for (unsigned i = 0; i < size; i++)
     clause_activity[i] *= VIVIFY_ACTIVITY_DECAY;
 }
 
@@ -83,7 +86,8 @@ void kissat_bump_clause_vivify_activity (kissat *solver, clause *c) {
   init_vivify_activity (solver);
   ward *arena = BEGIN_STACK (solver->arena);
   reference ref = (ward *) c - arena;
-  if (ref < clause_activity_size) {
+  if (ref < solver->vivify_activity_size) {
+    double *clause_activity = solver->vivify_activity;
     clause_activity[ref] += VIVIFY_ACTIVITY_INC;
     // Cap at reasonable maximum to avoid overflow
     if (clause_activity[ref] > 1e6)
@@ -93,12 +97,12 @@ void kissat_bump_clause_vivify_activity (kissat *solver, clause *c) {
 
 // Get clause activity
 static double get_clause_vivify_activity (kissat *solver, clause *c) {
-  if (!c || !clause_activity)
+  if (!c || !solver->vivify_activity)
     return 0.0;
   ward *arena = BEGIN_STACK (solver->arena);
   reference ref = (ward *) c - arena;
-  if (ref < clause_activity_size)
-    return clause_activity[ref];
+  if (ref < solver->vivify_activity_size)
+    return solver->vivify_activity[ref];
   return 0.0;
 }
 
@@ -239,6 +243,16 @@ struct countref {
 typedef struct countref countref;
 typedef STACK (countref) countrefs;
 
+struct vivify_worker {
+  value *values;
+  mark *marks;
+  unsigneds trail;
+  unsigneds sorted;
+  unsigneds sorter;
+};
+
+typedef struct vivify_worker vivify_worker;
+
 struct vivifier {
   kissat *solver;
   unsigned *counts;
@@ -246,6 +260,17 @@ struct vivifier {
   size_t scheduled, tried, vivified;
   countrefs countrefs;
   unsigneds sorted;
+  unsigned threads;
+  unsigned capacity;
+  vivify_worker *workers;
+  bool *promising;
+  uint64_t *ticks;
+  size_t *offsets;
+  reference *occurrences;
+  size_t size_occurrences;
+  uint64_t added, units;
+  uint64_t checked_ticks, limit;
+  size_t checked;
 #ifndef QUIET
   const char *mode;
   const char *name;
@@ -262,6 +287,7 @@ static void init_vivifier (kissat *solver, vivifier *vivifier) {
   INIT_STACK (vivifier->schedule);
   INIT_STACK (vivifier->countrefs);
   INIT_STACK (vivifier->sorted);
+  vivifier->threads = 1;
   LOG ("initialized vivifier");
 }
 
@@ -325,7 +351,7 @@ static void schedule_vivification_candidates (vivifier *vivifier) {
   LOG ("scheduling vivification candidates");
   
   // Decay clause activities for smart vivification
-  decay_vivify_activity ();
+  decay_vivify_activity (solver);
   
   int tier = vivifier->tier;
   unsigned lower_glue_limit, upper_glue_limit;
@@ -411,6 +437,7 @@ static void schedule_vivification_candidates (vivifier *vivifier) {
   }
   vivifier->scheduled = scheduled;
   vivifier->tried = vivifier->vivified = 0;
+  vivifier->checked_ticks = vivifier->checked = 0;
 }
 
 static inline bool worse_candidate (kissat *solver, unsigned *counts,
@@ -1360,6 +1387,334 @@ EXIT_ASSUMPTION_LOOP:;
   return res;
 }
 
+/*------------------------------------------------------------------------*/
+
+// Concurrent vivification ('vivifythreads > 1') takes the next batch of
+// scheduled candidates and propagates the negation of their literals on
+// helper threads.  The main solver waits at the root level during this
+// phase and thus its binary watches, root level values and the large
+// clauses in the arena act as read-only snapshot.  As large clause
+// watches are not updated by threads, a flat occurrence list of all large
+// clauses is built per round and propagation visits all occurrences of a
+// falsified literal.  Each thread uses its own local values, marks and
+// trail and only decides whether the candidate is promising, i.e.,
+// whether sequential vivification would find a conflict, an implied or a
+// propagated falsified literal or succeed with instantiation.  Only
+// promising candidates are then vivified (and strengthened) sequentially
+// in schedule order while all others are dropped without touching the
+// solver.  Clauses and units added while vivifying earlier candidates are
+// not part of the snapshot and could make a dropped candidate succeed.
+// Thus the snapshot is rebuilt for the next batch if clauses or units
+// were added since it was built and within the current batch candidates
+// are only dropped as long as the snapshot is still up-to-date.  The
+// remaining candidates of the batch are vivified sequentially instead.
+//
+// Propagating over full occurrence lists is much more expensive than
+// propagating over watches.  Workers therefore give up on a candidate,
+// which then counts as promising, as soon as they spent more ticks than
+// the average sequential vivification check of this round multiplied by
+// the number of threads.  Thus a candidate is only dropped if filtering
+// it was cheaper than vivifying it.  Until sequential checks have been
+// measured in a round candidates are not filtered at all.
+
+#define VIVIFY_BATCH_PER_THREAD 16
+
+static void push_worker_stack (unsigneds *stack, unsigned element) {
+  kissat *const solver = 0;
+  PUSH_STACK (*stack, element);
+}
+
+static void release_worker_stack (unsigneds *stack) {
+  kissat *const solver = 0;
+  RELEASE_STACK (*stack);
+}
+
+static void init_vivify_workers (vivifier *vivifier, unsigned threads) {
+  kissat *solver = vivifier->solver;
+  vivifier->threads = threads;
+  vivifier->workers =
+      kissat_calloc (solver, threads, sizeof *vivifier->workers);
+  for (unsigned i = 0; i != threads; i++) {
+    vivify_worker *worker = vivifier->workers + i;
+    worker->values = kissat_calloc (solver, LITS, sizeof (value));
+    worker->marks = kissat_calloc (solver, LITS, sizeof (mark));
+  }
+  const unsigned capacity = threads * VIVIFY_BATCH_PER_THREAD;
+  vivifier->capacity = capacity;
+  vivifier->promising =
+      kissat_calloc (solver, capacity, sizeof *vivifier->promising);
+  vivifier->ticks =
+      kissat_calloc (solver, capacity, sizeof *vivifier->ticks);
+  LOG ("initialized %u vivification workers", threads);
+}
+
+static void release_vivify_workers (vivifier *vivifier) {
+  kissat *solver = vivifier->solver;
+  const unsigned threads = vivifier->threads;
+  for (unsigned i = 0; i != threads; i++) {
+    vivify_worker *worker = vivifier->workers + i;
+    kissat_dealloc (solver, worker->values, LITS, sizeof (value));
+    kissat_dealloc (solver, worker->marks, LITS, sizeof (mark));
+    release_worker_stack (&worker->trail);
+    release_worker_stack (&worker->sorted);
+    release_worker_stack (&worker->sorter);
+  }
+  kissat_dealloc (solver, vivifier->workers, threads,
+                  sizeof *vivifier->workers);
+  const unsigned capacity = vivifier->capacity;
+  kissat_dealloc (solver, vivifier->promising, capacity,
+                  sizeof *vivifier->promising);
+  kissat_dealloc (solver, vivifier->ticks, capacity,
+                  sizeof *vivifier->ticks);
+}
+
+static void init_vivify_occurrences (vivifier *vivifier) {
+  kissat *solver = vivifier->solver;
+  size_t *offsets = kissat_calloc (solver, LITS + 1, sizeof *offsets);
+  for (all_clauses (c))
+    if (!c->garbage)
+      for (all_literals_in_clause (lit, c))
+        offsets[lit]++;
+  size_t total = 0;
+  for (all_literals (lit))
+    total += offsets[lit], offsets[lit] = total;
+  offsets[LITS] = total;
+  reference *occurrences =
+      kissat_nalloc (solver, total, sizeof *occurrences);
+  ward *const arena = BEGIN_STACK (solver->arena);
+  for (all_clauses (c))
+    if (!c->garbage) {
+      const reference ref = (ward *) c - arena;
+      for (all_literals_in_clause (lit, c))
+        occurrences[--offsets[lit]] = ref;
+    }
+  vivifier->offsets = offsets;
+  vivifier->occurrences = occurrences;
+  vivifier->size_occurrences = total;
+  vivifier->added = solver->statistics.clauses_added;
+  vivifier->units = solver->statistics.units;
+  ADD (probing_ticks, kissat_cache_lines (total, sizeof *occurrences));
+  kissat_extremely_verbose (solver,
+                            "vivification snapshot with %zu occurrences",
+                            total);
+}
+
+static void release_vivify_occurrences (vivifier *vivifier) {
+  kissat *solver = vivifier->solver;
+  kissat_dealloc (solver, vivifier->offsets, LITS + 1,
+                  sizeof *vivifier->offsets);
+  kissat_dealloc (solver, vivifier->occurrences,
+                  vivifier->size_occurrences,
+                  sizeof *vivifier->occurrences);
+}
+
+static bool vivify_snapshot_outdated (vivifier *vivifier) {
+  kissat *solver = vivifier->solver;
+  return vivifier->added != solver->statistics.clauses_added ||
+         vivifier->units != solver->statistics.units;
+}
+
+static void sort_worker_lits (vivify_worker *worker, unsigned *counts,
+                              size_t size, unsigned *lits) {
+  kissat *const solver = 0;
+#undef SORTER
+#define SORTER (worker->sorter)
+  QUICK_SORT (unsigned, size, lits, MORE_OCCURRENCES);
+  INSERTION_SORT (unsigned, size, lits, MORE_OCCURRENCES);
+#undef SORTER
+#define SORTER (solver->sorter)
+}
+
+#define WORKER_VALUE(LIT) (fixed[LIT] ? fixed[LIT] : values[LIT])
+
+static void worker_assign (vivifier *vivifier, vivify_worker *worker,
+                           unsigned lit) {
+#ifndef NDEBUG
+  kissat *const solver = vivifier->solver;
+#else
+  (void) vivifier;
+#endif
+  value *const values = worker->values;
+  values[lit] = 1;
+  values[NOT (lit)] = -1;
+  push_worker_stack (&worker->trail, lit);
+}
+
+static void worker_backtrack (vivifier *vivifier, vivify_worker *worker,
+                              size_t level) {
+#ifndef NDEBUG
+  kissat *const solver = vivifier->solver;
+#else
+  (void) vivifier;
+#endif
+  value *const values = worker->values;
+  unsigneds *const trail = &worker->trail;
+  while (SIZE_STACK (*trail) > level) {
+    const unsigned lit = POP_STACK (*trail);
+    values[lit] = values[NOT (lit)] = 0;
+  }
+}
+
+static bool worker_propagate (vivifier *vivifier, vivify_worker *worker,
+                              reference ignore, size_t *propagated,
+                              uint64_t *ticks) {
+  kissat *const solver = vivifier->solver;
+  const value *const fixed = solver->values;
+  const value *const values = worker->values;
+  const size_t *const offsets = vivifier->offsets;
+  const reference *const occurrences = vivifier->occurrences;
+  ward *const arena = BEGIN_STACK (solver->arena);
+  unsigneds *const trail = &worker->trail;
+  const uint64_t limit = vivifier->limit;
+  while (*propagated < SIZE_STACK (*trail)) {
+    if (*ticks > limit)
+      return true;
+    const unsigned lit = PEEK_STACK (*trail, *propagated);
+    const unsigned not_lit = NOT (lit);
+    *propagated += 1;
+    watches *const watches = &WATCHES (not_lit);
+    *ticks += 1 + kissat_cache_lines (SIZE_WATCHES (*watches),
+                                      sizeof (watch));
+    for (all_binary_blocking_watches (watch, *watches)) {
+      if (!watch.type.binary)
+        continue;
+      const unsigned other = watch.binary.lit;
+      const value value = WORKER_VALUE (other);
+      if (value > 0)
+        continue;
+      if (value < 0)
+        return true;
+      worker_assign (vivifier, worker, other);
+    }
+    const reference *p = occurrences + offsets[not_lit];
+    const reference *const end = occurrences + offsets[not_lit + 1];
+    *ticks += kissat_cache_lines (end - p, sizeof (reference));
+    while (p != end) {
+      const reference ref = *p++;
+      if (ref == ignore)
+        continue;
+      clause *const c = (clause *) (arena + ref);
+      if (c->garbage)
+        continue;
+      *ticks += 1;
+      unsigned unit = INVALID_LIT, unassigned = 0;
+      bool satisfied = false;
+      for (all_literals_in_clause (other, c)) {
+        const value value = WORKER_VALUE (other);
+        if (value < 0)
+          continue;
+        if (value > 0 || unassigned++) {
+          satisfied = value > 0;
+          unassigned = 2;
+          break;
+        }
+        unit = other;
+      }
+      if (satisfied || unassigned > 1)
+        continue;
+      if (!unassigned)
+        return true;
+      worker_assign (vivifier, worker, unit);
+    }
+  }
+  return false;
+}
+
+static bool promising_candidate (vivifier *vivifier, vivify_worker *worker,
+                                 reference ref, uint64_t *ticks) {
+  kissat *const solver = vivifier->solver;
+  const value *const fixed = solver->values;
+  const value *const values = worker->values;
+  clause *const c = kissat_dereference_clause (solver, ref);
+  unsigneds *const sorted = &worker->sorted;
+  CLEAR_STACK (*sorted);
+  for (all_literals_in_clause (lit, c)) {
+    const value value = fixed[lit];
+    if (value > 0)
+      return true;
+    if (!value)
+      push_worker_stack (sorted, lit);
+  }
+  const size_t size = SIZE_STACK (*sorted);
+  if (size < 3)
+    return size < 2;
+  unsigned *const lits = BEGIN_STACK (*sorted);
+  sort_worker_lits (worker, vivifier->counts, size, lits);
+  mark *const marks = worker->marks;
+  for (size_t i = 0; i != size; i++)
+    marks[lits[i]] = 1;
+  assert (EMPTY_STACK (worker->trail));
+  size_t propagated = 0, level = 0;
+  bool res = false;
+  for (size_t i = 0; !res && i != size; i++) {
+    const unsigned lit = lits[i];
+    if (WORKER_VALUE (lit)) {
+      res = true;
+      break;
+    }
+    level = SIZE_STACK (worker->trail);
+    worker_assign (vivifier, worker, NOT (lit));
+    if (worker_propagate (vivifier, worker, ref, &propagated, ticks)) {
+      res = true;
+      break;
+    }
+    const unsigned *const end = END_STACK (worker->trail);
+    for (const unsigned *p = BEGIN_STACK (worker->trail) + level; p != end;
+         p++)
+      if (marks[*p]) {
+        res = true;
+        break;
+      }
+  }
+  if (!res) {
+    worker_backtrack (vivifier, worker, level);
+    propagated = level;
+    worker_assign (vivifier, worker, lits[size - 1]);
+    res = worker_propagate (vivifier, worker, ref, &propagated, ticks);
+  }
+  worker_backtrack (vivifier, worker, 0);
+  for (size_t i = 0; i != size; i++)
+    marks[lits[i]] = 0;
+  return res;
+}
+
+static void vivify_worker_task (void *state, unsigned task,
+                                unsigned thread) {
+  vivifier *vivifier = state;
+  const references *const schedule = &vivifier->schedule;
+  const size_t pos = SIZE_STACK (*schedule) - 1 - task;
+  const reference ref = PEEK_STACK (*schedule, pos);
+  vivify_worker *const worker = vivifier->workers + thread;
+  uint64_t *const ticks = vivifier->ticks + task;
+  *ticks = 0;
+  vivifier->promising[task] =
+      promising_candidate (vivifier, worker, ref, ticks);
+}
+
+static unsigned filter_vivification_candidates (vivifier *vivifier) {
+  kissat *solver = vivifier->solver;
+  if (solver->level)
+    kissat_backtrack_without_updating_phases (solver, 0);
+  const size_t scheduled = SIZE_STACK (vivifier->schedule);
+  const unsigned size = MIN (scheduled, vivifier->capacity);
+  if (!vivifier->checked) {
+    for (unsigned i = 0; i != size; i++)
+      vivifier->promising[i] = true;
+    LOG ("not filtering batch of %u vivification candidates", size);
+    return size;
+  }
+  vivifier->limit =
+      vivifier->threads * vivifier->checked_ticks / vivifier->checked;
+  kissat_parallel_for (solver, vivifier->threads, size,
+                       vivify_worker_task, vivifier);
+  uint64_t ticks = 0;
+  for (unsigned i = 0; i != size; i++)
+    ticks += vivifier->ticks[i];
+  ADD (probing_ticks, ticks / vivifier->threads);
+  LOG ("filtered batch of %u vivification candidates", size);
+  return size;
+}
+
 static void vivify_round (vivifier *vivifier, uint64_t limit) {
   int tier = vivifier->tier;
   kissat *solver = vivifier->solver;
@@ -1383,6 +1738,9 @@ static void vivify_round (vivifier *vivifier, uint64_t limit) {
   }
 
   kissat_watch_large_clauses (solver);
+  const bool concurrent = vivifier->threads > 1;
+  if (concurrent)
+    init_vivify_occurrences (vivifier);
 #ifndef QUIET
   uint64_t start = solver->statistics.probing_ticks;
   uint64_t delta = limit - start;
@@ -1398,6 +1756,7 @@ static void vivify_round (vivifier *vivifier, uint64_t limit) {
 #endif
   assert (!vivifier->vivified);
   assert (!vivifier->tried);
+  unsigned batched = 0, filtered = 0;
   while (!EMPTY_STACK (vivifier->schedule)) {
     const uint64_t probing_ticks = solver->statistics.probing_ticks;
     if (probing_ticks > limit) {
@@ -1409,11 +1768,32 @@ static void vivify_round (vivifier *vivifier, uint64_t limit) {
     }
     if (TERMINATED (vivify_terminated_1))
       break;
+    if (concurrent && filtered == batched) {
+      if (vivifier->checked && vivify_snapshot_outdated (vivifier)) {
+        release_vivify_occurrences (vivifier);
+        init_vivify_occurrences (vivifier);
+      }
+      batched = filter_vivification_candidates (vivifier);
+      filtered = 0;
+    }
     const reference ref = POP_STACK (vivifier->schedule);
     clause *candidate = kissat_dereference_clause (solver, ref);
     assert (!candidate->garbage);
     vivifier->tried++;
-    if (vivify_clause (vivifier, candidate))
+    if (concurrent && !vivifier->promising[filtered++] &&
+        !vivify_snapshot_outdated (vivifier)) {
+      LOGCLS (candidate, "concurrently filtered");
+      INC (vivify_filtered);
+      candidate->vivify = false;
+      continue;
+    }
+    if (concurrent) {
+      const uint64_t before = solver->statistics.probing_ticks;
+      if (vivify_clause (vivifier, candidate))
+        vivifier->vivified++;
+      vivifier->checked_ticks += solver->statistics.probing_ticks - before;
+      vivifier->checked++;
+    } else if (vivify_clause (vivifier, candidate))
       vivifier->vivified++;
     if (solver->inconsistent)
       break;
@@ -1421,6 +1801,8 @@ static void vivify_round (vivifier *vivifier, uint64_t limit) {
   }
   if (solver->level)
     kissat_backtrack_without_updating_phases (solver, 0);
+  if (concurrent)
+    release_vivify_occurrences (vivifier);
 #ifndef QUIET
   kissat_phase (solver, vivifier->mode, GET (vivifications),
                 "vivified %zu clauses %.0f%% out of %zu tried",
@@ -1528,7 +1910,7 @@ void kissat_vivify (kissat *solver) {
   solver->vivifying = true;
 #endif
 
-  SET_EFFORT_LIMIT (limit, vivify, probing_ticks);
+  SET_SCHEDULED_EFFORT_LIMIT (limit, vivify, probing_ticks);
   const uint64_t total = limit - solver->statistics.probing_ticks;
   limit = solver->statistics.probing_ticks;
   unsigned tier1_limit = vivify_tier1_limit (solver);
@@ -1542,6 +1924,9 @@ void kissat_vivify (kissat *solver) {
   {
     vivifier vivifier;
     init_vivifier (solver, &vivifier);
+    const unsigned threads = GET_OPTION (vivifythreads);
+    if (threads > 1)
+      init_vivify_workers (&vivifier, threads);
     if (tier1_budget) {
       limit += (total * tier1_budget) / sum;
       vivify_tier1 (&vivifier, limit);
@@ -1565,6 +1950,8 @@ void kissat_vivify (kissat *solver) {
       else
         REDUCE_DELAY (vivifyirr);
     }
+    if (threads > 1)
+      release_vivify_workers (&vivifier);
     release_vivifier (&vivifier);
   }
 
@@ -1585,5 +1972,6 @@ void kissat_vivify (kissat *solver) {
   assert (solver->vivifying);
   solver->vivifying = false;
 #endif
+  STOP_PAYOFF (vivify, probing_ticks);
   STOP (vivify);
 }
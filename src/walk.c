@@ -3,38 +3,22 @@
 #include "decide.h"
 #include "dense.h"
 #include "inline.h"
+#include "parallel.h"
 #include "phases.h"
 #include "print.h"
 #include "rephase.h"
 #include "report.h"
+#include "simdscan.h"
 #include "terminate.h"
 #include "warmup.h"
 
 #include <string.h>
 
-typedef struct tagged tagged;
-typedef struct counter counter;
 typedef struct walker walker;
 
 #define LD_MAX_WALK_REF 31
 #define MAX_WALK_REF ((1u << LD_MAX_WALK_REF) - 1)
 
-struct tagged {
-  unsigned ref : LD_MAX_WALK_REF;
-  bool binary : 1;
-};
-
-static inline tagged make_tagged (bool binary, unsigned ref) {
-  assert (ref <= MAX_WALK_REF);
-  tagged res = {.binary = binary, .ref = ref};
-  return res;
-}
-
-struct counter {
-  unsigned count;
-  unsigned pos;
-};
-
 // clang-format off
 typedef STACK (double) doubles;
 // clang-format on
@@ -46,20 +30,27 @@ struct walker {
 
   unsigned best_trail_pos;
   unsigned clauses;
+  unsigned connected;
   unsigned current;
   unsigned exponents;
+  unsigned id;
   unsigned initial;
   unsigned minimum;
   unsigned offset;
 
   generator random;
 
-  counter *counters;
+  unsigned *counts;
+  unsigned *positions;
   litpairs *binaries;
-  tagged *refs;
+  size_t *bounds;
+  unsigneds literals;
+  size_t *offsets;
+  unsigned *occurrences;
   double *table;
 
   value *original_values;
+  value *values;
   value *best_values;
 
   doubles scores;
@@ -69,10 +60,13 @@ struct walker {
   double size;
   double epsilon;
 
+  bool *satisfied;
+
   uint64_t limit;
+  uint64_t steps;
+  uint64_t flips;
   uint64_t flipped;
 #ifndef QUIET
-  uint64_t start;
   struct {
     uint64_t flipped;
     unsigned minimum;
@@ -80,62 +74,87 @@ struct walker {
 #endif
 };
 
-static const unsigned *dereference_literals (kissat *solver, walker *walker,
+// The walker copies the non-falsified literals of all connected clauses
+// into one flat 'literals' array, where clause 'counter_ref' occupies the
+// range from 'bounds[counter_ref]' to 'bounds[counter_ref + 1]'.  The
+// occurrences of literal 'lit' are stored in compressed sparse row format
+// in the 'occurrences' array from 'offsets[lit]' to 'offsets[lit + 1]'.
+// Both are built once in 'init_walker' and shared by all walkers, which
+// only keep their own 'counts' of true literals and 'positions' on the
+// unsatisfied stack.  Break values thus gather 'counts' at contiguous
+// clause indices instead of decoding watches and clause references.
+
+static const unsigned *dereference_literals (walker *walker,
                                              unsigned counter_ref,
                                              unsigned *size_ptr) {
   assert (counter_ref < walker->clauses);
-  tagged tagged = walker->refs[counter_ref];
-  unsigned const *lits;
-  if (tagged.binary) {
-    const unsigned binary_ref = tagged.ref;
-    lits = PEEK_STACK (*walker->binaries, binary_ref).lits;
-    *size_ptr = 2;
-  } else {
-    const reference clause_ref = tagged.ref;
-    clause *c = kissat_dereference_clause (solver, clause_ref);
-    *size_ptr = c->size;
-    lits = c->lits;
-  }
-  return lits;
+  const size_t *const bounds = walker->bounds;
+  const size_t begin = bounds[counter_ref];
+  const size_t end = bounds[counter_ref + 1];
+  assert (begin < end);
+  *size_ptr = end - begin;
+  return BEGIN_STACK (walker->literals) + begin;
+}
+
+// With 'walkthreads > 1' walkers flip literals concurrently on different
+// threads and thus their stacks are not accounted for by the solver.
+
+static void push_walker_unsigned (unsigneds *stack, unsigned element) {
+  kissat *const solver = 0;
+  PUSH_STACK (*stack, element);
+}
+
+static void push_walker_score (doubles *stack, double score) {
+  kissat *const solver = 0;
+  PUSH_STACK (*stack, score);
+}
+
+static void release_walker_stacks (walker *walker) {
+  kissat *const solver = 0;
+  RELEASE_STACK (walker->unsat);
+  RELEASE_STACK (walker->scores);
+  RELEASE_STACK (walker->trail);
 }
 
-static void push_unsat (kissat *solver, walker *walker, counter *counters,
+static void push_unsat (kissat *solver, walker *walker,
                         unsigned counter_ref) {
   assert (counter_ref < walker->clauses);
-  counter *counter = counters + counter_ref;
   assert (SIZE_STACK (walker->unsat) <= UINT_MAX);
-  counter->pos = SIZE_STACK (walker->unsat);
-  PUSH_STACK (walker->unsat, counter_ref);
+  const unsigned pos = SIZE_STACK (walker->unsat);
+  walker->positions[counter_ref] = pos;
+  push_walker_unsigned (&walker->unsat, counter_ref);
 #ifdef LOGGING
   unsigned size;
   const unsigned *const lits =
-      dereference_literals (solver, walker, counter_ref, &size);
-  LOGLITS (size, lits, "pushed unsatisfied[%u]", counter->pos);
+      dereference_literals (walker, counter_ref, &size);
+  LOGLITS (size, lits, "pushed unsatisfied[%u]", pos);
+#else
+  (void) solver;
 #endif
 }
 
-static bool pop_unsat (kissat *solver, walker *walker, counter *counters,
-                       unsigned counter_ref, unsigned pos) {
+static bool pop_unsat (kissat *solver, walker *walker, unsigned counter_ref,
+                       unsigned pos) {
   assert (walker->current);
   assert (counter_ref < walker->clauses);
-  assert (counters[counter_ref].pos == pos);
+  unsigned *const positions = walker->positions;
+  assert (positions[counter_ref] == pos);
   assert (walker->current == SIZE_STACK (walker->unsat));
   const unsigned other_counter_ref = POP_STACK (walker->unsat);
   walker->current--;
   bool res = false;
   if (counter_ref != other_counter_ref) {
     assert (other_counter_ref < walker->clauses);
-    counter *other_counter = counters + other_counter_ref;
-    assert (other_counter->pos == walker->current);
-    assert (pos < other_counter->pos);
-    other_counter->pos = pos;
+    assert (positions[other_counter_ref] == walker->current);
+    assert (pos < positions[other_counter_ref]);
+    positions[other_counter_ref] = pos;
     POKE_STACK (walker->unsat, pos, other_counter_ref);
     res = true;
   }
 #ifdef LOGGING
   unsigned size;
   const unsigned *const lits =
-      dereference_literals (solver, walker, counter_ref, &size);
+      dereference_literals (walker, counter_ref, &size);
   LOGLITS (size, lits, "popped unsatisfied[%u]", pos);
 #else
   (void) solver;
@@ -193,13 +212,15 @@ static unsigned currently_unsatified (walker *walker) {
   return SIZE_STACK (walker->unsat);
 }
 
-static void import_decision_phases (walker *walker) {
+static void import_decision_phases (walker *walker, unsigned threads) {
   kissat *solver = walker->solver;
-  INC (walk_decisions);
+  if (!walker->id)
+    INC (walk_decisions);
   const flags *const flags = solver->flags;
-  value *values = solver->values;
+  value *values = walker->values;
   walker->best_values = kissat_calloc (solver, VARS, 1);
   value *best_values = walker->best_values;
+  const uint64_t perturb = ((uint64_t) walker->id << 32) / (2 * threads);
 #ifndef QUIET
   unsigned imported = 0;
 #endif
@@ -208,6 +229,8 @@ static void import_decision_phases (walker *walker) {
       continue;
     value value = kissat_decide_phase (solver, idx);
     assert (value);
+    if (perturb && kissat_next_random32 (&walker->random) < perturb)
+      value = -value;
     best_values[idx] = value;
     const unsigned lit = LIT (idx);
     const unsigned not_lit = NOT (lit);
@@ -218,6 +241,8 @@ static void import_decision_phases (walker *walker) {
 #endif
     LOG ("copied %s decision phase %d", LOGVAR (idx), (int) value);
   }
+  if (walker->id)
+    return;
   kissat_phase (solver, "walk", GET (walks),
                 "imported %u decision phases %.0f%%", imported,
                 kissat_percent (imported, solver->active));
@@ -225,10 +250,10 @@ static void import_decision_phases (walker *walker) {
 
 static unsigned connect_binary_counters (walker *walker) {
   kissat *solver = walker->solver;
-  value *values = solver->values;
-  tagged *refs = walker->refs;
-  watches *all_watches = solver->watches;
-  counter *counters = walker->counters;
+  value *values = walker->values;
+  size_t *bounds = walker->bounds;
+  unsigneds *literals = &walker->literals;
+  unsigned *counts = walker->counts;
 
   assert (SIZE_STACK (*walker->binaries) <= UINT_MAX);
   const unsigned size = SIZE_STACK (*walker->binaries);
@@ -245,16 +270,13 @@ static unsigned connect_binary_counters (walker *walker) {
     if (!first_value || !second_value)
       continue;
     assert (counter_ref < walker->clauses);
-    refs[counter_ref] = make_tagged (true, binary_ref);
-    watches *first_watches = all_watches + first;
-    watches *second_watches = all_watches + second;
-    kissat_push_large_watch (solver, first_watches, counter_ref);
-    kissat_push_large_watch (solver, second_watches, counter_ref);
+    PUSH_STACK (*literals, first);
+    PUSH_STACK (*literals, second);
+    bounds[counter_ref + 1] = SIZE_STACK (*literals);
     const unsigned count = (first_value > 0) + (second_value > 0);
-    counter *counter = counters + counter_ref;
-    counter->count = count;
+    counts[counter_ref] = count;
     if (!count) {
-      push_unsat (solver, walker, counters, counter_ref);
+      push_unsat (solver, walker, counter_ref);
       unsat++;
     }
     counter_ref++;
@@ -269,14 +291,15 @@ static unsigned connect_binary_counters (walker *walker) {
   return counter_ref;
 }
 
-static void connect_large_counters (walker *walker, unsigned counter_ref) {
+static unsigned connect_large_counters (walker *walker,
+                                        unsigned counter_ref) {
   kissat *solver = walker->solver;
   assert (!solver->level);
   const value *const original_values = walker->original_values;
-  const value *const local_search_values = solver->values;
-  ward *const arena = BEGIN_STACK (solver->arena);
-  counter *counters = walker->counters;
-  tagged *refs = walker->refs;
+  const value *const local_search_values = walker->values;
+  size_t *bounds = walker->bounds;
+  unsigneds *literals = &walker->literals;
+  unsigned *counts = walker->counts;
 
   unsigned unsat = 0;
   unsigned large = 0;
@@ -304,11 +327,7 @@ static void connect_large_counters (walker *walker, unsigned counter_ref) {
     if (continue_with_next_clause)
       continue;
     large++;
-    assert (kissat_clause_in_arena (solver, c));
-    reference clause_ref = (ward *) c - arena;
-    assert (clause_ref <= MAX_WALK_REF);
     assert (counter_ref < walker->clauses);
-    refs[counter_ref] = make_tagged (false, clause_ref);
     unsigned count = 0, size = 0;
     for (all_literals_in_clause (lit, c)) {
       const value value = local_search_values[lit];
@@ -316,17 +335,16 @@ static void connect_large_counters (walker *walker, unsigned counter_ref) {
         assert (original_values[lit] < 0);
         continue;
       }
-      watches *watches = &WATCHES (lit);
-      kissat_push_large_watch (solver, watches, counter_ref);
+      PUSH_STACK (*literals, lit);
       size++;
       if (value > 0)
         count++;
     }
-    counter *counter = walker->counters + counter_ref;
-    counter->count = count;
+    bounds[counter_ref + 1] = SIZE_STACK (*literals);
+    counts[counter_ref] = count;
 
     if (!count) {
-      push_unsat (solver, walker, counters, counter_ref);
+      push_unsat (solver, walker, counter_ref);
       unsat++;
     }
     counter_ref++;
@@ -339,6 +357,31 @@ static void connect_large_counters (walker *walker, unsigned counter_ref) {
   (void) large;
   (void) unsat;
 #endif
+  return counter_ref;
+}
+
+static void connect_occurrences (walker *walker) {
+  kissat *solver = walker->solver;
+  size_t *offsets = kissat_calloc (solver, LITS + 1, sizeof *offsets);
+  const unsigned *const literals = BEGIN_STACK (walker->literals);
+  const size_t size_literals = SIZE_STACK (walker->literals);
+  for (size_t i = 0; i != size_literals; i++)
+    offsets[literals[i]]++;
+  size_t total = 0;
+  for (all_literals (lit))
+    total += offsets[lit], offsets[lit] = total;
+  offsets[LITS] = total;
+  assert (total == size_literals);
+  unsigned *occurrences =
+      kissat_nalloc (solver, total, sizeof *occurrences);
+  const size_t *const bounds = walker->bounds;
+  for (unsigned counter_ref = walker->connected; counter_ref--;) {
+    const size_t end = bounds[counter_ref + 1];
+    for (size_t i = bounds[counter_ref]; i != end; i++)
+      occurrences[--offsets[literals[i]]] = counter_ref;
+  }
+  walker->offsets = offsets;
+  walker->occurrences = occurrences;
 }
 
 #ifndef QUIET
@@ -368,7 +411,7 @@ static void report_minimum (const char *type, kissat *solver,
 #endif
 
 static void init_walker (kissat *solver, walker *walker,
-                         litpairs *binaries) {
+                         litpairs *binaries, unsigned threads) {
   uint64_t clauses = BINIRR_CLAUSES;
   assert (clauses <= MAX_WALK_REF);
 
@@ -380,16 +423,19 @@ static void init_walker (kissat *solver, walker *walker,
   walker->random = solver->random ^ solver->statistics.walks;
 
   walker->original_values = solver->values;
-  solver->values = kissat_calloc (solver, LITS, 1);
+  solver->values = walker->values = kissat_calloc (solver, LITS, 1);
 
-  import_decision_phases (walker);
+  import_decision_phases (walker, threads);
 
-  walker->counters = kissat_malloc (solver, clauses * sizeof (counter));
-  walker->refs = kissat_malloc (solver, clauses * sizeof (tagged));
+  walker->counts = kissat_malloc (solver, clauses * sizeof (unsigned));
+  walker->positions = kissat_malloc (solver, clauses * sizeof (unsigned));
+  walker->bounds = kissat_malloc (solver, (clauses + 1) * sizeof (size_t));
+  walker->bounds[0] = 0;
 
   assert (!walker->size);
   const unsigned counter_ref = connect_binary_counters (walker);
-  connect_large_counters (walker, counter_ref);
+  walker->connected = connect_large_counters (walker, counter_ref);
+  connect_occurrences (walker);
 
   walker->current = walker->initial = currently_unsatified (walker);
 
@@ -411,10 +457,12 @@ static void init_walker (kissat *solver, walker *walker,
 
 static void init_walker_limit (kissat *solver, walker *walker) {
   SET_EFFORT_LIMIT (limit, walk, walk_steps);
-  walker->limit = limit;
+  assert (limit >= solver->statistics.walk_steps);
+  walker->limit = limit - solver->statistics.walk_steps;
+  walker->steps = 0;
+  walker->flips = 0;
   walker->flipped = 0;
 #ifndef QUIET
-  walker->start = solver->statistics.walk_steps;
   walker->report.minimum = UINT_MAX;
   walker->report.flipped = 0;
 #endif
@@ -425,35 +473,33 @@ static void release_walker (walker *walker) {
   kissat_dealloc (solver, walker->table, walker->exponents,
                   sizeof (double));
   unsigned clauses = walker->clauses;
-  kissat_dealloc (solver, walker->refs, clauses, sizeof (tagged));
-  kissat_dealloc (solver, walker->counters, clauses, sizeof (counter));
-  RELEASE_STACK (walker->unsat);
-  RELEASE_STACK (walker->scores);
-  RELEASE_STACK (walker->trail);
-  kissat_free (solver, solver->values, LITS);
+  kissat_dealloc (solver, walker->counts, clauses, sizeof (unsigned));
+  kissat_dealloc (solver, walker->positions, clauses, sizeof (unsigned));
+  kissat_dealloc (solver, walker->bounds, clauses + 1, sizeof (size_t));
+  const size_t size_literals = SIZE_STACK (walker->literals);
+  kissat_dealloc (solver, walker->occurrences, size_literals,
+                  sizeof (unsigned));
+  kissat_dealloc (solver, walker->offsets, LITS + 1, sizeof (size_t));
+  RELEASE_STACK (walker->literals);
+  release_walker_stacks (walker);
+  assert (solver->values == walker->values);
+  kissat_free (solver, walker->values, LITS);
   kissat_free (solver, walker->best_values, VARS);
-  RELEASE_STACK (walker->unsat);
   solver->values = walker->original_values;
 }
 
-static unsigned break_value (kissat *solver, walker *walker, value *values,
-                             unsigned lit) {
-  assert (values[lit] < 0);
+static unsigned break_value (kissat *solver, walker *walker, unsigned lit) {
+  assert (walker->values[lit] < 0);
   const unsigned not_lit = NOT (lit);
-  watches *watches = &WATCHES (not_lit);
-  unsigned steps = 1;
-  unsigned res = 0;
-  for (all_binary_large_watches (watch, *watches)) {
-    steps++;
-    assert (!watch.type.binary);
-    reference counter_ref = watch.large.ref;
-    assert (counter_ref < walker->clauses);
-    counter *counter = walker->counters + counter_ref;
-    res += (counter->count == 1);
-  }
-  ADD (walk_steps, steps);
+  const size_t *const offsets = walker->offsets;
+  const size_t begin = offsets[not_lit], end = offsets[not_lit + 1];
+  const unsigned *const occurrences = walker->occurrences + begin;
+  const size_t size = end - begin;
+  const unsigned res =
+      kissat_simd_count_critical (walker->counts, occurrences, size);
+  walker->steps += 1 + size;
 #ifdef NDEBUG
-  (void) values;
+  (void) solver;
 #endif
   return res;
 }
@@ -471,27 +517,24 @@ static unsigned pick_literal (kissat *solver, walker *walker) {
   const unsigned counter_ref = PEEK_STACK (walker->unsat, pos);
   unsigned size;
   const unsigned *const lits =
-      dereference_literals (solver, walker, counter_ref, &size);
+      dereference_literals (walker, counter_ref, &size);
 
   LOGLITS (size, lits, "picked unsatisfied[%u]", pos);
   assert (EMPTY_STACK (walker->scores));
 
-  value *values = solver->values;
-
   double sum = 0;
   unsigned picked_lit = INVALID_LIT;
 
   const unsigned *const end_of_lits = lits + size;
   for (const unsigned *p = lits; p != end_of_lits; p++) {
     const unsigned lit = *p;
-    if (!values[lit])
-      continue;
+    assert (walker->values[lit] < 0);
     picked_lit = lit;
-    const unsigned breaks = break_value (solver, walker, values, lit);
+    const unsigned breaks = break_value (solver, walker, lit);
     const double score = scale_score (walker, breaks);
     assert (score > 0);
     LOG ("literal %s breaks %u score %g", LOGLIT (lit), breaks, score);
-    PUSH_STACK (walker->scores, score);
+    push_walker_score (&walker->scores, score);
     sum += score;
   }
   assert (picked_lit != INVALID_LIT);
@@ -514,8 +557,6 @@ static unsigned pick_literal (kissat *solver, walker *walker) {
 
   for (const unsigned *p = lits; p != end_of_lits; p++) {
     const unsigned lit = *p;
-    if (!values[lit])
-      continue;
     const double score = *scores++;
     sum += score;
     if (threshold < sum) {
@@ -545,19 +586,19 @@ static void break_clauses (kissat *solver, walker *walker,
   LOG ("breaking one-satisfied clauses containing negated flipped literal "
        "%s",
        LOGLIT (not_flipped));
-  watches *watches = &WATCHES (not_flipped);
-  counter *counters = walker->counters;
+  const size_t *const offsets = walker->offsets;
+  const unsigned *const begin = walker->occurrences + offsets[not_flipped];
+  const unsigned *const end = walker->occurrences + offsets[not_flipped + 1];
+  unsigned *counts = walker->counts;
   unsigned steps = 1;
-  for (all_binary_large_watches (watch, *watches)) {
+  for (const unsigned *p = begin; p != end; p++) {
     steps++;
-    assert (!watch.type.binary);
-    const unsigned counter_ref = watch.large.ref;
+    const unsigned counter_ref = *p;
     assert (counter_ref < walker->clauses);
-    counter *counter = counters + counter_ref;
-    assert (counter->count);
-    if (--counter->count)
+    assert (counts[counter_ref]);
+    if (--counts[counter_ref])
       continue;
-    push_unsat (solver, walker, counters, counter_ref);
+    push_unsat (solver, walker, counter_ref);
 #ifdef LOGGING
     broken++;
 #endif
@@ -565,7 +606,7 @@ static void break_clauses (kissat *solver, walker *walker,
   LOG ("broken %u one-satisfied clauses containing "
        "negated flipped literal %s",
        broken, LOGLIT (not_flipped));
-  ADD (walk_steps, steps);
+  walker->steps += steps;
 #ifdef NDEBUG
   (void) values;
 #endif
@@ -576,22 +617,23 @@ static void make_clauses (kissat *solver, walker *walker,
   assert (values[flipped] > 0);
   LOG ("making unsatisfied clauses containing flipped literal %s",
        LOGLIT (flipped));
-  watches *watches = &WATCHES (flipped);
-  counter *counters = walker->counters;
+  const size_t *const offsets = walker->offsets;
+  const unsigned *const begin = walker->occurrences + offsets[flipped];
+  const unsigned *const end = walker->occurrences + offsets[flipped + 1];
+  unsigned *counts = walker->counts;
   unsigned steps = 1;
 #ifdef LOGGING
   unsigned made = 0;
 #endif
-  for (all_binary_large_watches (watch, *watches)) {
+  for (const unsigned *p = begin; p != end; p++) {
     steps++;
-    assert (!watch.type.binary);
-    const unsigned counter_ref = watch.large.ref;
+    const unsigned counter_ref = *p;
     assert (counter_ref < walker->clauses);
-    counter *counter = counters + counter_ref;
-    assert (counter->count < UINT_MAX);
-    if (counter->count++)
+    assert (counts[counter_ref] < UINT_MAX);
+    if (counts[counter_ref]++)
       continue;
-    if (pop_unsat (solver, walker, counters, counter_ref, counter->pos))
+    const unsigned pos = walker->positions[counter_ref];
+    if (pop_unsat (solver, walker, counter_ref, pos))
       steps++;
 #ifdef LOGGING
     made++;
@@ -599,7 +641,7 @@ static void make_clauses (kissat *solver, walker *walker,
   }
   LOG ("made %u unsatisfied clauses containing flipped literal %s", made,
        LOGLIT (flipped));
-  ADD (walk_steps, steps);
+  walker->steps += steps;
 #ifdef NDEBUG
   (void) values;
 #endif
@@ -609,7 +651,7 @@ static void save_all_values (kissat *solver, walker *walker) {
   assert (EMPTY_STACK (walker->trail));
   assert (walker->best_trail_pos == INVALID_BEST_TRAIL_POS);
   LOG ("copying all values as best phases since trail is invalid");
-  const value *const current_values = solver->values;
+  const value *const current_values = walker->values;
   value *best_values = walker->best_values;
   for (all_variables (idx)) {
     const unsigned lit = LIT (idx);
@@ -674,14 +716,14 @@ static void push_flipped (kissat *solver, walker *walker,
     const unsigned limit = VARS / 4 + 1;
     assert (limit < INVALID_BEST_TRAIL_POS);
     if (size_trail < limit) {
-      PUSH_STACK (walker->trail, flipped);
+      push_walker_unsigned (&walker->trail, flipped);
       LOG ("pushed flipped %s to trail which now has size %u",
            LOGLIT (flipped), size_trail + 1);
     } else if (walker->best_trail_pos) {
       LOG ("trail reached limit %u but has best position %u", limit,
            walker->best_trail_pos);
       save_walker_trail (solver, walker, true);
-      PUSH_STACK (walker->trail, flipped);
+      push_walker_unsigned (&walker->trail, flipped);
       assert (SIZE_STACK (walker->trail) <= UINT_MAX);
       LOG ("pushed flipped %s to trail which now has size %zu",
            LOGLIT (flipped), SIZE_STACK (walker->trail));
@@ -697,7 +739,7 @@ static void push_flipped (kissat *solver, walker *walker,
 
 static void flip_literal (kissat *solver, walker *walker, unsigned flip) {
   LOG ("flipping literal %s", LOGLIT (flip));
-  value *values = solver->values;
+  value *values = walker->values;
   const value value = values[flip];
   assert (value < 0);
   values[flip] = -value;
@@ -710,8 +752,10 @@ static void flip_literal (kissat *solver, walker *walker, unsigned flip) {
 static void update_best (kissat *solver, walker *walker) {
   assert (walker->current < walker->minimum);
   walker->minimum = walker->current;
+  if (!walker->minimum)
+    __atomic_store_n (walker->satisfied, true, __ATOMIC_RELAXED);
 #ifndef QUIET
-  int verbosity = kissat_verbosity (solver);
+  int verbosity = walker->id ? 0 : kissat_verbosity (solver);
   bool report = (verbosity > 2);
   if (verbosity == 2) {
     if (walker->flipped / 2 >= walker->report.flipped)
@@ -738,35 +782,36 @@ static void update_best (kissat *solver, walker *walker) {
 
 static void local_search_step (kissat *solver, walker *walker) {
   assert (walker->current);
-  INC (flipped);
+  walker->flips++;
   assert (walker->flipped < UINT64_MAX);
   walker->flipped++;
   LOG ("starting local search flip %" PRIu64 " with %u unsatisfied clauses",
-       GET (flipped), walker->current);
+       walker->flips, walker->current);
   unsigned lit = pick_literal (solver, walker);
   flip_literal (solver, walker, lit);
   push_flipped (solver, walker, lit);
   if (walker->current < walker->minimum)
     update_best (solver, walker);
   LOG ("ending local search step %" PRIu64 " with %u unsatisfied clauses",
-       GET (flipped), walker->current);
+       walker->flips, walker->current);
 }
 
 static void local_search_round (walker *walker) {
   kissat *solver = walker->solver;
-#ifndef QUIET
-  const unsigned before = walker->minimum;
-#endif
-  statistics *statistics = &solver->statistics;
-  while (walker->minimum && walker->limit > statistics->walk_steps) {
+  while (walker->minimum && walker->limit > walker->steps) {
     if (TERMINATED (walk_terminated_1))
       break;
+    if (__atomic_load_n (walker->satisfied, __ATOMIC_RELAXED))
+      break;
     local_search_step (solver, walker);
   }
+}
+
+static void report_local_search (walker *walker, unsigned before) {
 #ifndef QUIET
+  kissat *solver = walker->solver;
   report_minimum ("last", solver, walker);
-  assert (statistics->walk_steps >= walker->start);
-  const uint64_t steps = statistics->walk_steps - walker->start;
+  const uint64_t steps = walker->steps;
   // clang-format off
   kissat_very_verbose (solver,
     "walking ends with %u unsatisfied clauses", walker->current);
@@ -778,6 +823,9 @@ static void local_search_round (walker *walker) {
   kissat_phase (
       solver, "walk", GET (walks), "%s minimum %u after %" PRIu64 " flips",
       after < before ? "new" : "unchanged", after, walker->flipped);
+#else
+  (void) walker;
+  (void) before;
 #endif
 }
 
@@ -790,11 +838,10 @@ static void export_best_values (walker *walker) {
   memcpy (saved, best, VARS);
 }
 
-static bool save_final_minimum (walker *walker) {
+static bool save_final_minimum (walker *walker, unsigned initial) {
   kissat *solver = walker->solver;
 
-  assert (walker->minimum <= walker->initial);
-  if (walker->minimum == walker->initial) {
+  if (walker->minimum >= initial) {
     kissat_phase (solver, "walk", GET (walks),
                   "no improvement thus keeping saved phases");
     return false;
@@ -816,6 +863,120 @@ static bool save_final_minimum (walker *walker) {
   return true;
 }
 
+/*------------------------------------------------------------------------*/
+
+// With 'walkthreads > 1' additional helper walkers run concurrently with
+// the first one.  They share the read-only flat clause store, occurrence
+// lists and score table built by the first walker, but have their own
+// values, counts, positions and trails.  The initial
+// phases of helper 'i' are the decision phases with each phase flipped
+// with probability 'i / (2 * threads)' and each walker uses a different
+// seed.  All walkers stop as soon as one of them satisfies all clauses.
+// The walker with the smallest minimum (the first one on ties) provides
+// the exported phases.  With zero unsatisfied clauses the next descent of
+// the search then finds a model without conflicts.
+
+static unsigned walker_threads (kissat *solver) {
+  unsigned threads = GET_OPTION (walkthreads);
+#ifdef LOGGING
+  if (GET_OPTION (log))
+    threads = 1;
+#endif
+  return threads;
+}
+
+static void init_helper (walker *helper, walker *walker, unsigned id,
+                         unsigned threads) {
+  kissat *solver = walker->solver;
+  memset (helper, 0, sizeof *helper);
+
+  helper->solver = solver;
+  helper->id = id;
+  helper->clauses = walker->clauses;
+  helper->connected = walker->connected;
+  helper->binaries = walker->binaries;
+  helper->bounds = walker->bounds;
+  helper->literals = walker->literals;
+  helper->offsets = walker->offsets;
+  helper->occurrences = walker->occurrences;
+  helper->table = walker->table;
+  helper->exponents = walker->exponents;
+  helper->epsilon = walker->epsilon;
+  helper->size = walker->size;
+  helper->original_values = walker->original_values;
+  helper->satisfied = walker->satisfied;
+  helper->limit = walker->limit;
+  helper->random = walker->random + id * 0x9e3779b97f4a7c15ul;
+#ifndef QUIET
+  helper->report.minimum = UINT_MAX;
+#endif
+
+  helper->values = kissat_calloc (solver, LITS, 1);
+  import_decision_phases (helper, threads);
+
+  const value *const values = helper->values;
+  const unsigned clauses = helper->clauses;
+  unsigned *counts = kissat_malloc (solver, clauses * sizeof (unsigned));
+  helper->counts = counts;
+  helper->positions = kissat_malloc (solver, clauses * sizeof (unsigned));
+  const unsigned connected = helper->connected;
+  for (unsigned counter_ref = 0; counter_ref != connected; counter_ref++) {
+    unsigned size;
+    const unsigned *const lits =
+        dereference_literals (helper, counter_ref, &size);
+    unsigned count = 0;
+    for (unsigned i = 0; i != size; i++)
+      count += (values[lits[i]] > 0);
+    counts[counter_ref] = count;
+    if (!count)
+      push_unsat (solver, helper, counter_ref);
+  }
+  helper->current = helper->initial = currently_unsatified (helper);
+  helper->minimum = helper->current;
+  if (!helper->minimum)
+    __atomic_store_n (helper->satisfied, true, __ATOMIC_RELAXED);
+}
+
+static void release_helper (walker *helper) {
+  kissat *solver = helper->solver;
+  const unsigned clauses = helper->clauses;
+  kissat_dealloc (solver, helper->counts, clauses, sizeof (unsigned));
+  kissat_dealloc (solver, helper->positions, clauses, sizeof (unsigned));
+  release_walker_stacks (helper);
+  kissat_free (solver, helper->values, LITS);
+  kissat_free (solver, helper->best_values, VARS);
+}
+
+static void local_search_task (void *state, unsigned task,
+                               unsigned thread) {
+  walker **walkers = state;
+  local_search_round (walkers[task]);
+  (void) thread;
+}
+
+static walker *concurrent_local_search (walker *first, walker *helpers,
+                                        unsigned threads) {
+  kissat *solver = first->solver;
+  walker **walkers = kissat_nalloc (solver, threads, sizeof *walkers);
+  walkers[0] = first;
+  for (unsigned i = 1; i != threads; i++)
+    walkers[i] = helpers + i - 1;
+  kissat_parallel_for (solver, threads, threads, local_search_task,
+                       walkers);
+  walker *best = first;
+  uint64_t steps = 0;
+  for (unsigned i = 0; i != threads; i++) {
+    walker *other = walkers[i];
+    steps += other->steps;
+    ADD (flipped, other->flips);
+    if (other->minimum < best->minimum)
+      best = other;
+  }
+  ADD (walk_steps, steps / threads);
+  kissat_dealloc (solver, walkers, threads, sizeof *walkers);
+  return best;
+}
+
 #ifdef CHECK_WALK
 
 static void check_walk (kissat *solver, unsigned expected) {
@@ -888,17 +1049,44 @@ static void walking_phase (kissat *solver) {
   litpairs irredundant;
   INIT_STACK (irredundant);
   kissat_enter_dense_mode (solver, &irredundant);
+  const unsigned threads = walker_threads (solver);
+  walker *best, *helpers = 0;
+  bool satisfied = false;
   walker walker;
-  init_walker (solver, &walker, &irredundant);
+  init_walker (solver, &walker, &irredundant, threads);
   init_walker_limit (solver, &walker);
-  local_search_round (&walker);
+  walker.satisfied = &satisfied;
+  const unsigned before = walker.minimum;
+  best = &walker;
+  if (threads > 1) {
+    helpers = kissat_nalloc (solver, threads - 1, sizeof *helpers);
+    for (unsigned i = 1; i != threads; i++)
+      init_helper (helpers + i - 1, &walker, i, threads);
+    best = concurrent_local_search (&walker, helpers, threads);
+  } else {
+    local_search_round (&walker);
+    ADD (walk_steps, walker.steps);
+    ADD (flipped, walker.flips);
+  }
+  report_local_search (&walker, before);
+  if (threads > 1)
+    kissat_phase (solver, "walk", GET (walks),
+                  "best minimum %u of %u walkers reached by walker %u",
+                  best->minimum, threads, best->id);
 #ifdef CHECK_WALK
   bool improved =
 #endif
-      save_final_minimum (&walker);
+      save_final_minimum (best, walker.initial);
+  if (best != &walker)
+    INC (walk_helped);
 #ifdef CHECK_WALK
-  unsigned expected = walker.minimum;
+  unsigned expected = best->minimum;
 #endif
+  if (helpers) {
+    for (unsigned i = 1; i != threads; i++)
+      release_helper (helpers + i - 1);
+    kissat_dealloc (solver, helpers, threads - 1, sizeof *helpers);
+  }
   release_walker (&walker);
   kissat_resume_sparse_mode (solver, false, &irredundant);
   RELEASE_STACK (irredundant);
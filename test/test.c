@@ -65,6 +65,7 @@ int tissat_processes;
 bool tissat_found_drabt;
 bool tissat_found_drat_trim;
 bool tissat_found_dpr_trim;
+bool tissat_found_frat_rs;
 
 #endif
 
@@ -378,6 +379,7 @@ int main (int argc, char **argv) {
   FIND (drabt, drabt);
   FIND (drat-trim, drat_trim);
   FIND (dpr-trim, dpr_trim);
+  FIND (frat-rs, frat_rs);
 
   // clang-format on
 
@@ -450,6 +452,7 @@ int main (int argc, char **argv) {
   SCHEDULE (vector);
   SCHEDULE (rank);
   SCHEDULE (sort);
+  SCHEDULE (simdscan);
   SCHEDULE (bump);
   SCHEDULE (options);
   SCHEDULE (config);
@@ -457,17 +460,19 @@ int main (int argc, char **argv) {
   SCHEDULE (add);
   SCHEDULE (file);
   SCHEDULE (parse);
+  SCHEDULE (snapshot);
   SCHEDULE (usage);
   SCHEDULE (main);
   SCHEDULE (collect);
   SCHEDULE (kitten);
   SCHEDULE (solve);
+  SCHEDULE (incremental);
+  SCHEDULE (learn);
   SCHEDULE (coverage);
   SCHEDULE (terminate);
 
 #ifndef NPROOFS
-  if (tissat_found_drabt || tissat_found_drat_trim)
-    SCHEDULE (prove);
+  SCHEDULE (prove);
 #endif
 
 #ifndef NDEBUG
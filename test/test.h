@@ -23,6 +23,7 @@ extern bool tissat_progress;
 extern bool tissat_found_drabt;
 extern bool tissat_found_drat_trim;
 extern bool tissat_found_dpr_trim;
+extern bool tissat_found_frat_rs;
 #endif
 
 #if defined(_POSIX_C_SOURCE) || defined(__APPLE__)
@@ -6,6 +6,7 @@
 #include "../src/import.h"
 #include "../src/inline.h"
 #include "../src/propsearch.h"
+#include "../src/recycle.h"
 #include "../src/trail.h"
 
 #include "test.h"
@@ -149,7 +150,39 @@ static void test_collect (void) {
   }
 }
 
-void tissat_schedule_collect (void) { SCHEDULE_FUNCTION (test_collect); }
+static void add_large_redundant_clause_only (kissat *solver) {
+  CLEAR_STACK (solver->clause);
+  add_large_redundant_clause (solver);
+}
+
+static void test_recycle (void) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  just_import_and_activate_four_variables (solver);
+  add_large_irredundant_clause (solver);
+  add_large_redundant_clause_only (solver);
+  const reference first = solver->first_reducible;
+  assert (first != INVALID_REF);
+  add_large_redundant_clause_only (solver);
+  mark_redundant_clauses_as_garbage (solver);
+  kissat_recycle_garbage_clauses (solver, first);
+  assert (solver->recycler.slots == 2);
+  add_large_redundant_clause_only (solver);
+  assert (solver->recycler.slots == 1);
+  size_t redundant = 0;
+  for (all_clauses (c))
+    if (!c->garbage && c->redundant)
+      redundant++;
+  assert (redundant == 1);
+  kissat_sparse_collect (solver, false, 0);
+  assert (!solver->recycler.slots);
+  kissat_release (solver);
+}
+
+void tissat_schedule_collect (void) {
+  SCHEDULE_FUNCTION (test_collect);
+  SCHEDULE_FUNCTION (test_recycle);
+}
 
 #else
 
@@ -146,6 +146,104 @@ static void test_file_read_compressed (void) {
 
 #endif
 
+#ifdef KISSAT_HAS_DECOMPRESSION
+
+static void test_file_read_decompressed (void) {
+  const size_t expected_bytes = kissat_file_size ("../test/file/0");
+#define READ_DECOMPRESSED(PATH) \
+  do { \
+    file file; \
+    if (!kissat_open_to_read_file (&file, PATH)) \
+      FATAL ("failed to open compressed '%s' for reading", PATH); \
+    if (!file.decompressor) \
+      FATAL ("compressed '%s' not decompressed in-process", PATH); \
+    int ch; \
+    while ((ch = kissat_getc (&file)) != EOF) \
+      ; \
+    printf ("closing '%s' after reading '%" PRIu64 "' bytes\n", PATH, \
+            file.bytes); \
+    kissat_close_file (&file); \
+    if (file.bytes != expected_bytes) \
+      FATAL ("read '%" PRIu64 "' bytes but expected '%zu'", file.bytes, \
+             expected_bytes); \
+  } while (0)
+#ifdef KISSAT_HAS_BZIP2
+  READ_DECOMPRESSED ("../test/file/1.bz2");
+#endif
+#ifdef KISSAT_HAS_ZLIB
+  READ_DECOMPRESSED ("../test/file/2.gz");
+#endif
+#ifdef KISSAT_HAS_LZMA
+  READ_DECOMPRESSED ("../test/file/3.lzma");
+  READ_DECOMPRESSED ("../test/file/5.xz");
+#endif
+#ifdef KISSAT_HAS_ZSTD
+  READ_DECOMPRESSED ("../test/file/6.zst");
+#endif
+#undef READ_DECOMPRESSED
+}
+
+#endif
+
+#ifdef KISSAT_HAS_COMPRESSOR
+
+static void test_file_write_compressed (void) {
+  const char *original = "../test/file/0";
+  const size_t expected_bytes = kissat_file_size (original);
+#define WRITE_COMPRESSED(SUFFIX) \
+  do { \
+    file src, dst; \
+    const char *path = "0" SUFFIX; \
+    if (!kissat_open_to_read_file (&src, original)) \
+      FATAL ("failed to open '%s' for reading", original); \
+    if (!kissat_open_to_write_file (&dst, path)) \
+      FATAL ("failed to open compressed '%s' for writing", path); \
+    if (!dst.compressor) \
+      FATAL ("compressed '%s' not compressed in-process", path); \
+    int ch; \
+    while ((ch = kissat_getc (&src)) != EOF) { \
+      kissat_putc (&dst, ch); \
+      if (dst.bytes == expected_bytes / 2) \
+        kissat_flush (&dst); \
+    } \
+    kissat_close_file (&src); \
+    printf ("closing '%s' after writing '%" PRIu64 "' bytes\n", path, \
+            dst.bytes); \
+    kissat_close_file (&dst); \
+    if (!kissat_open_to_read_file (&src, original)) \
+      FATAL ("failed to open '%s' for reading", original); \
+    if (!kissat_open_to_read_file (&dst, path)) \
+      FATAL ("failed to open compressed '%s' for reading", path); \
+    while ((ch = kissat_getc (&src)) != EOF) \
+      if (kissat_getc (&dst) != ch) \
+        FATAL ("reading back '%s' differs at byte '%" PRIu64 "'", path, \
+               dst.bytes); \
+    if (kissat_getc (&dst) != EOF) \
+      FATAL ("reading back '%s' has trailing bytes", path); \
+    kissat_close_file (&src); \
+    kissat_close_file (&dst); \
+    if (dst.bytes != expected_bytes) \
+      FATAL ("read back '%" PRIu64 "' bytes but expected '%zu'", \
+             dst.bytes, expected_bytes); \
+  } while (0)
+#ifdef KISSAT_HAS_BZIP2
+  WRITE_COMPRESSED (".bz2");
+#endif
+#ifdef KISSAT_HAS_ZLIB
+  WRITE_COMPRESSED (".gz");
+#endif
+#ifdef KISSAT_HAS_LZMA
+  WRITE_COMPRESSED (".lzma");
+  WRITE_COMPRESSED (".xz");
+#endif
+#ifdef KISSAT_HAS_ZSTD
+  WRITE_COMPRESSED (".zst");
+#endif
+#undef WRITE_COMPRESSED
+}
+
+#endif
+
 static void test_file_read_uncompressed (void) {
   const size_t expected_bytes = kissat_file_size ("../test/file/0");
 #define READ_UNCOMPRESSED(EXPECTED, PATH) \
@@ -235,6 +333,14 @@ void tissat_schedule_file (void) {
     SCHEDULE_FUNCTION (test_file_writable);
   if (tissat_found_test_directory)
     SCHEDULE_FUNCTION (test_file_read_uncompressed);
+#ifdef KISSAT_HAS_DECOMPRESSION
+  if (tissat_found_test_directory)
+    SCHEDULE_FUNCTION (test_file_read_decompressed);
+#endif
+#ifdef KISSAT_HAS_COMPRESSOR
+  if (tissat_found_test_directory)
+    SCHEDULE_FUNCTION (test_file_write_compressed);
+#endif
 #ifdef KISSAT_COMPRESSED
   SCHEDULE_FUNCTION (test_file_write_and_read_compressed);
   if (tissat_found_test_directory)
@@ -0,0 +1,122 @@
+#include "../src/file.h"
+#include "../src/parse.h"
+
+#include "test.h"
+#include "testcnfs.h"
+
+static void test_incremental_assumptions (void) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_add (solver, -1);
+  kissat_add (solver, 2);
+  kissat_add (solver, 0);
+  kissat_add (solver, -2);
+  kissat_add (solver, 3);
+  kissat_add (solver, 0);
+  kissat_assume (solver, 1);
+  kissat_assume (solver, -3);
+  int res = kissat_solve (solver);
+  assert (res == 20);
+  assert (kissat_failed (solver, 1));
+  assert (kissat_failed (solver, -3));
+  assert (!kissat_failed (solver, 2));
+  assert (!kissat_frozen (solver, 1));
+  kissat_assume (solver, 1);
+  res = kissat_solve (solver);
+  assert (res == 10);
+  assert (kissat_value (solver, 3) == 3);
+  kissat_add (solver, -3);
+  kissat_add (solver, 0);
+  res = kissat_solve (solver);
+  assert (res == 10);
+  assert (kissat_value (solver, 1) == -1);
+  kissat_assume (solver, 2);
+  kissat_assume (solver, -2);
+  res = kissat_solve (solver);
+  assert (res == 20);
+  assert (kissat_failed (solver, 2));
+  assert (!kissat_failed (solver, -2));
+  kissat_freeze (solver, 4);
+  assert (kissat_frozen (solver, 4));
+  kissat_melt (solver, 4);
+  assert (!kissat_frozen (solver, 4));
+  kissat_add (solver, 3);
+  kissat_add (solver, 0);
+  res = kissat_solve (solver);
+  assert (res == 20);
+  kissat_release (solver);
+}
+
+static void solve_under_assumption (kissat *solver, int expected, int lit) {
+  kissat_assume (solver, lit);
+  const int res = kissat_solve (solver);
+  if (res == 10) {
+    if (kissat_value (solver, lit) != lit)
+      FATAL ("assumption %d not satisfied", lit);
+#ifndef NDEBUG
+    kissat_check_satisfying_assignment (solver);
+#endif
+  } else if (res == 20) {
+    if (expected == 10 && !kissat_failed (solver, lit))
+      FATAL ("assumption %d not failed", lit);
+  } else
+    FATAL ("solver returned '%d' under assumption %d", res, lit);
+}
+
+static void incremental_cnf (int expected, const char *name) {
+  char path[64];
+  sprintf (path, "../test/cnf/%s.cnf", name);
+  if (!kissat_file_readable (path)) {
+    tissat_warning ("Skipping unreadable '%s'", path);
+    return;
+  }
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_option (solver, "incremental", 1);
+  file file;
+  if (!kissat_open_to_read_file (&file, path))
+    FATAL ("could not read '%s'", path);
+  uint64_t lineno;
+  int max_var;
+  const char *error = kissat_parse_dimacs (solver, RELAXED_PARSING, &file,
+                                           &lineno, &max_var);
+  if (error)
+    FATAL ("unexpected parse error: %s", error);
+  kissat_close_file (&file);
+  if (max_var)
+    kissat_freeze (solver, max_var);
+  int res = kissat_solve (solver);
+  if (res != expected)
+    FATAL ("solver returned '%d' but expected '%d'", res, expected);
+  const int max_assumed = max_var < 8 ? max_var : 8;
+  for (int idx = 1; idx <= max_assumed; idx++) {
+    solve_under_assumption (solver, expected, idx);
+    solve_under_assumption (solver, expected, -idx);
+    kissat_assume (solver, idx);
+    kissat_assume (solver, -idx);
+    res = kissat_solve (solver);
+    if (res != 20)
+      FATAL ("solver returned '%d' on clashing assumptions", res);
+  }
+  res = kissat_solve (solver);
+  if (res != expected)
+    FATAL ("solver returned '%d' but expected '%d' after assumptions", res,
+           expected);
+  kissat_release (solver);
+}
+
+static void test_incremental_cnfs (void) {
+#define CNF(EXPECTED, NAME, BIG) \
+  if (!BIG || tissat_big) \
+    incremental_cnf (EXPECTED, #NAME);
+  CNFS
+#undef CNF
+}
+
+void tissat_schedule_incremental (void) {
+  SCHEDULE_FUNCTION (test_incremental_assumptions);
+#ifndef NOPTIONS
+  if (tissat_found_test_directory)
+    SCHEDULE_FUNCTION (test_incremental_cnfs);
+#endif
+}
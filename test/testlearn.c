@@ -0,0 +1,182 @@
+#include "../src/error.h"
+#include "../src/file.h"
+#include "../src/parse.h"
+#include "../src/proof.h"
+
+#include "test.h"
+#include "testcnfs.h"
+
+typedef struct relay relay;
+
+struct relay {
+  ints lits;
+  size_t next;
+  unsigned clauses;
+  unsigned units;
+  int max_length;
+  int max_var;
+};
+
+// The relay stack is not allocated by one of the solvers.
+
+static void learn (void *state, int *clause) {
+  struct kissat *const solver = 0;
+  relay *relay = state;
+  int size = 0;
+  for (const int *p = clause; *p; p++, size++) {
+    const int lit = *p;
+    if (!lit || abs (lit) > relay->max_var)
+      FATAL ("invalid literal %d in learned clause", lit);
+    PUSH_STACK (relay->lits, lit);
+  }
+  if (!size || size > relay->max_length)
+    FATAL ("learned clause of invalid size %d", size);
+  PUSH_STACK (relay->lits, 0);
+  if (size == 1)
+    relay->units++;
+  relay->clauses++;
+}
+
+static const int *import_learned (void *state, int *glue) {
+  relay *relay = state;
+  if (relay->next == SIZE_STACK (relay->lits))
+    return 0;
+  const int *res = BEGIN_STACK (relay->lits) + relay->next;
+  while (PEEK_STACK (relay->lits, relay->next))
+    relay->next++;
+  relay->next++;
+  *glue = 2;
+  return res;
+}
+
+static kissat *new_solver (const char *path, int *max_var) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  file file;
+  if (!kissat_open_to_read_file (&file, path))
+    FATAL ("could not read '%s'", path);
+  uint64_t lineno;
+  const char *error = kissat_parse_dimacs (solver, RELAXED_PARSING, &file,
+                                           &lineno, max_var);
+  if (error)
+    FATAL ("unexpected parse error: %s", error);
+  kissat_close_file (&file);
+  return solver;
+}
+
+static void release_relay (relay *relay) {
+  struct kissat *const solver = 0;
+  RELEASE_STACK (relay->lits);
+}
+
+static void relay_cnf (int expected, const char *name) {
+  char path[64];
+  sprintf (path, "../test/cnf/%s.cnf", name);
+  if (!kissat_file_readable (path)) {
+    tissat_warning ("Skipping unreadable '%s'", path);
+    return;
+  }
+  relay relay;
+  memset (&relay, 0, sizeof relay);
+  relay.max_length = 8;
+  kissat *solver = new_solver (path, &relay.max_var);
+  kissat_set_learn (solver, &relay, relay.max_length, learn);
+  int res = kissat_solve (solver);
+  if (res != expected)
+    FATAL ("solver returned '%d' but expected '%d'", res, expected);
+  kissat_release (solver);
+  tissat_verbose ("learned %u clauses including %u units on '%s'",
+                  relay.clauses, relay.units, name);
+  solver = new_solver (path, &relay.max_var);
+  kissat_set_import (solver, &relay, import_learned);
+  res = kissat_solve (solver);
+  if (res != expected)
+    FATAL ("solver returned '%d' but expected '%d' after import", res,
+           expected);
+  if (relay.next != SIZE_STACK (relay.lits))
+    FATAL ("only imported %zu of %zu literals", relay.next,
+           SIZE_STACK (relay.lits));
+  kissat_release (solver);
+  release_relay (&relay);
+}
+
+static void test_learn_relay (void) {
+#define CNF(EXPECTED, NAME, BIG) \
+  if (!BIG || tissat_big) \
+    relay_cnf (EXPECTED, #NAME);
+  CNFS
+#undef CNF
+}
+
+static const int *import_unit (void *state, int *glue) {
+  int *unit = state;
+  if (!*unit)
+    return 0;
+  static int clause[2];
+  clause[0] = *unit;
+  clause[1] = 0;
+  *unit = 0;
+  *glue = 1;
+  return clause;
+}
+
+static void test_learn_import_unit (void) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_option (solver, "lucky", 0);
+  kissat_freeze (solver, 1);
+  kissat_freeze (solver, 2);
+  kissat_add (solver, 1);
+  kissat_add (solver, 2);
+  kissat_add (solver, 0);
+  int unit = -1;
+  kissat_set_import (solver, &unit, import_unit);
+  int res = kissat_solve (solver);
+  assert (res == 10);
+  assert (!unit);
+  assert (kissat_value (solver, 1) == -1);
+  assert (kissat_value (solver, 2) == 2);
+  kissat_release (solver);
+}
+
+#ifndef NPROOFS
+
+#include <setjmp.h>
+
+static jmp_buf jump_buffer;
+
+static void abort_call_back (void) { longjmp (jump_buffer, 42); }
+
+static void test_learn_import_with_proof (void) {
+  static kissat *solver;
+  static file file;
+  solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_write_already_open_file (&file, stdout, "<stdout>");
+  kissat_init_proof (solver, &file, false);
+  kissat_call_function_instead_of_abort (abort_call_back);
+  int val = setjmp (jump_buffer);
+  if (val) {
+    kissat_call_function_instead_of_abort (0);
+    if (val != 42)
+      FATAL ("expected '42' as result from 'setjmp'");
+  } else {
+    int unit = 1;
+    kissat_set_import (solver, &unit, import_unit);
+    kissat_call_function_instead_of_abort (0);
+    FATAL ("long jump not taken");
+  }
+  kissat_release_proof (solver);
+  kissat_release (solver);
+}
+
+#endif
+
+void tissat_schedule_learn (void) {
+  SCHEDULE_FUNCTION (test_learn_import_unit);
+#ifndef NPROOFS
+  SCHEDULE_FUNCTION (test_learn_import_with_proof);
+#endif
+  if (tissat_found_test_directory)
+    SCHEDULE_FUNCTION (test_learn_relay);
+}
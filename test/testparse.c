@@ -5,6 +5,22 @@
 
 #include "test.h"
 
+static const char *parse_file (unsigned strict, const char *path,
+                               int threads, uint64_t *lineno_ptr,
+                               int *max_var_ptr) {
+  kissat *solver = kissat_init ();
+  tissat_init_solver (solver);
+  kissat_set_option (solver, "parsethreads", threads);
+  file file;
+  if (!kissat_open_to_read_file (&file, path))
+    FATAL ("could not open '%s' for reading", path);
+  const char *error =
+      kissat_parse_dimacs (solver, strict, &file, lineno_ptr, max_var_ptr);
+  kissat_close_file (&file);
+  kissat_release (solver);
+  return error;
+}
+
 static bool test_parse (bool expect_parse_error, unsigned strict,
                         const char *path) {
   const char *type;
@@ -22,15 +38,9 @@ static bool test_parse (bool expect_parse_error, unsigned strict,
   }
   tissat_verbose ("Parsing %svalid '%s' in '%s' mode.",
                   expect_parse_error ? "in" : "", path, type);
-  kissat *solver = kissat_init ();
-  tissat_init_solver (solver);
-  file file;
-  if (!kissat_open_to_read_file (&file, path))
-    FATAL ("could not open '%s' for reading", path);
   uint64_t lineno;
   int max_var;
-  const char *error =
-      kissat_parse_dimacs (solver, strict, &file, &lineno, &max_var);
+  const char *error = parse_file (strict, path, 1, &lineno, &max_var);
   if (expect_parse_error) {
     if (!error)
       FATAL ("%s parsing '%s' succeeded unexpectedly", type, path);
@@ -40,8 +50,17 @@ static bool test_parse (bool expect_parse_error, unsigned strict,
            lineno, error);
     tissat_verbose ("found maximum variable '%d' in '%s'", max_var, path);
   }
-  kissat_close_file (&file);
-  kissat_release (solver);
+  uint64_t parallel_lineno;
+  int parallel_max_var;
+  const char *parallel_error =
+      parse_file (strict, path, 4, &parallel_lineno, &parallel_max_var);
+  if (error != parallel_error)
+    FATAL ("%s parallel parsing of '%s' yields different result", type,
+           path);
+  if (error && lineno != parallel_lineno)
+    FATAL ("%s parallel parsing of '%s' yields line %" PRIu64
+           " instead of %" PRIu64,
+           type, path, parallel_lineno, lineno);
   return false;
 }
 
@@ -1,10 +1,16 @@
 #ifndef NPROOFS
 
+#include "../src/error.h"
 #include "../src/file.h"
+#include "../src/verify.h"
 
 #include "test.h"
 #include "testcnfs.h"
 
+#include <inttypes.h>
+#include <setjmp.h>
+#include <stdlib.h>
+
 #ifdef KISSAT_COMPRESSED
 
 #define MAX_COMPRESSED 10
@@ -150,6 +156,249 @@ static void schedule_prove_job (int expected, const char *cnf,
   }
 }
 
+static void schedule_frat_job (const char *cnf, const char *name) {
+  char cmd[256];
+  if (!kissat_file_readable (cnf)) {
+    tissat_warning ("Skipping unreadable '%s'", cnf);
+    return;
+  }
+  char proof[96];
+  sprintf (proof, "%s.frat%u", name, scheduled);
+  const char *binary = (scheduled % 2) ? "" : "--no-binary ";
+  const char *opt = tissat_next_option (scheduled);
+  sprintf (cmd, "--frat %s%s%s %s", opt, binary, cnf, proof);
+  tissat_job *job = tissat_schedule_application (20, cmd);
+  scheduled++;
+  sprintf (cmd, "frat-rs elab %s %s", proof, cnf);
+  assert (strlen (cmd) < sizeof cmd);
+  tissat_schedule_command (0, cmd, job);
+}
+
+// Independent of 'frat-rs' the antecedent chains of added clauses in
+// non-binary FRAT proofs are checked by unit propagation over only the
+// hinted clauses.  Every hint has to become unit or falsified, and the last
+// one falsified, given the negation of the added clause.
+
+typedef struct frat_clause frat_clause;
+
+struct frat_clause {
+  unsigned size;
+  int *lits;
+};
+
+static frat_clause *frat_clauses;
+static size_t size_frat_clauses;
+static signed char *frat_values;
+static size_t size_frat_values;
+
+static signed char frat_value (int lit) {
+  const size_t idx = ABS (lit);
+  if (idx >= size_frat_values)
+    return 0;
+  const signed char res = frat_values[idx];
+  return lit < 0 ? -res : res;
+}
+
+static void frat_assign (int lit) {
+  const size_t idx = ABS (lit);
+  if (idx >= size_frat_values) {
+    size_t new_size = size_frat_values ? 2 * size_frat_values : 64;
+    while (new_size <= idx)
+      new_size *= 2;
+    frat_values = realloc (frat_values, new_size);
+    memset (frat_values + size_frat_values, 0,
+            new_size - size_frat_values);
+    size_frat_values = new_size;
+  }
+  frat_values[idx] = lit < 0 ? -1 : 1;
+}
+
+static frat_clause *frat_identified (const char *path, uint64_t id) {
+  if (!id || id >= size_frat_clauses || !frat_clauses[id].lits)
+    FATAL ("unidentified clause %" PRIu64 " in '%s'", id, path);
+  return frat_clauses + id;
+}
+
+static bool check_frat_chain (const char *path, unsigned size,
+                              const int *lits, size_t hints,
+                              const uint64_t *chain) {
+  for (unsigned i = 0; i != size; i++)
+    frat_assign (-lits[i]);
+  bool res = false;
+  for (size_t i = 0; !res && i != hints; i++) {
+    const frat_clause *const c = frat_identified (path, chain[i]);
+    int unit = 0;
+    unsigned unassigned = 0;
+    for (unsigned j = 0; j != c->size; j++) {
+      const int lit = c->lits[j];
+      const signed char value = frat_value (lit);
+      if (value > 0)
+        return false;
+      if (!value)
+        unit = lit, unassigned++;
+    }
+    if (unassigned > 1)
+      break;
+    if (unassigned)
+      frat_assign (unit);
+    else
+      res = true;
+  }
+  memset (frat_values, 0, size_frat_values);
+  return res;
+}
+
+static void check_frat_hints (const char *path) {
+  FILE *file = fopen (path, "r");
+  if (!file)
+    FATAL ("can not read FRAT proof '%s'", path);
+  size_t capacity_lits = 0, capacity_chain = 0;
+  int *lits = 0;
+  uint64_t *chain = 0;
+  unsigned chains = 0;
+  int type;
+  while ((type = getc (file)) != EOF) {
+    uint64_t id;
+    if (fscanf (file, "%" SCNu64, &id) != 1)
+      FATAL ("expected clause identifier in '%s'", path);
+    unsigned size = 0;
+    for (int lit; fscanf (file, "%d", &lit) == 1 && lit; size++) {
+      if (size == capacity_lits)
+        lits = realloc (lits, (capacity_lits = 2 * size + 2) *
+                                  sizeof *lits);
+      lits[size] = lit;
+    }
+    size_t hints = 0;
+    int ch;
+    while ((ch = getc (file)) == ' ')
+      ;
+    if (ch == 'l') {
+      for (uint64_t hint; fscanf (file, "%" SCNu64, &hint) == 1 && hint;
+           hints++) {
+        if (hints == capacity_chain)
+          chain = realloc (chain, (capacity_chain = 2 * hints + 2) *
+                                      sizeof *chain);
+        chain[hints] = hint;
+      }
+      ch = getc (file);
+    }
+    if (ch != '\n')
+      FATAL ("expected new-line in '%s'", path);
+    if (type == 'a' && hints) {
+      if (!check_frat_chain (path, size, lits, hints, chain))
+        FATAL ("invalid chain of clause %" PRIu64 " in '%s'", id, path);
+      chains++;
+    }
+    if (type == 'o' || type == 'a') {
+      if (id >= size_frat_clauses) {
+        size_t new_size = size_frat_clauses ? 2 * size_frat_clauses : 64;
+        while (new_size <= id)
+          new_size *= 2;
+        frat_clauses =
+            realloc (frat_clauses, new_size * sizeof *frat_clauses);
+        memset (frat_clauses + size_frat_clauses, 0,
+                (new_size - size_frat_clauses) * sizeof *frat_clauses);
+        size_frat_clauses = new_size;
+      }
+      frat_clause *c = frat_clauses + id;
+      if (c->lits)
+        FATAL ("clause %" PRIu64 " added twice in '%s'", id, path);
+      c->size = size;
+      c->lits = malloc ((size + 1) * sizeof *lits);
+      memcpy (c->lits, lits, size * sizeof *lits);
+    } else if (type == 'd') {
+      frat_clause *c = frat_identified (path, id);
+      free (c->lits);
+      c->lits = 0;
+    } else if (type != 'f')
+      FATAL ("unexpected line type '%c' in '%s'", type, path);
+  }
+  fclose (file);
+  for (size_t i = 0; i != size_frat_clauses; i++)
+    free (frat_clauses[i].lits);
+  free (frat_clauses);
+  frat_clauses = 0;
+  size_frat_clauses = 0;
+  free (frat_values);
+  frat_values = 0;
+  size_frat_values = 0;
+  free (chain);
+  free (lits);
+  printf ("checked %u chains in '%s'\n", chains, path);
+}
+
+static void test_prove_frat_hints (void) {
+  char cmd[256], proof[96];
+#define CNF(EXPECTED, NAME, BIG) \
+  if (EXPECTED == 20 && !BIG && \
+      kissat_file_readable ("../test/cnf/" #NAME ".cnf")) { \
+    sprintf (proof, "%s.frat-hints", #NAME); \
+    sprintf (cmd, "--frat --no-binary ../test/cnf/%s.cnf %s", #NAME, \
+             proof); \
+    tissat_call_application (20, cmd); \
+    check_frat_hints (proof); \
+  }
+  CNFS
+#undef CNF
+}
+
+static jmp_buf jump_buffer;
+
+static void abort_call_back (void) { longjmp (jump_buffer, 42); }
+
+// The lines are given as tag ('o' for original and 'a' for added clauses)
+// followed by the zero terminated clause and terminated by a zero tag.
+
+static bool verifier_fails (const int *lines) {
+  static kissat *solver;
+  static verifier *verifier;
+  solver = kissat_init ();
+  tissat_init_solver (solver);
+  verifier = kissat_start_verifier (solver);
+  for (const int *p = lines; *p; p++) {
+    const int tag = *p++;
+    const int *const elits = p;
+    while (*p)
+      p++;
+    const size_t size = p - elits;
+    if (tag == 'o')
+      kissat_verify_original (verifier, size, elits);
+    else
+      kissat_verify_added (verifier, size, elits);
+  }
+  kissat_call_function_instead_of_abort (abort_call_back);
+  const bool failed = setjmp (jump_buffer);
+  if (!failed)
+    kissat_stop_verifier (solver, verifier);
+  kissat_call_function_instead_of_abort (0);
+  kissat_release (solver);
+  return failed;
+}
+
+static void test_prove_verifier_exceptions (void) {
+  const int definition[] = {'o', 1, 2, 0, 'a', 3, -1, 0, 'a', -3, 1, 0, 0};
+  if (verifier_fails (definition))
+    FATAL ("verifier failed on definition of extension variable");
+  const int pure[] = {'o', 1, 2, 0, 'a', 1, 0, 0};
+  if (!verifier_fails (pure))
+    FATAL ("verifier accepted pure literal of original variable");
+  const int original[] = {'o', 1, 2, 0, 'a', 3, -1, 0, 'o', -3, 0, 0};
+  if (!verifier_fails (original))
+    FATAL ("verifier accepted original clause on extension variable");
+}
+
+static void schedule_proofcheck_job (int expected, const char *cnf) {
+  char cmd[256];
+  if (!kissat_file_readable (cnf)) {
+    tissat_warning ("Skipping unreadable '%s'", cnf);
+    return;
+  }
+  const char *opt = tissat_next_option (scheduled++);
+  sprintf (cmd, "--proofcheck %s%s", opt, cnf);
+  assert (strlen (cmd) < sizeof cmd);
+  tissat_schedule_application (expected, cmd);
+}
+
 void tissat_schedule_prove (void) {
 #ifdef KISSAT_COMPRESSED
   init_compression ();
@@ -157,6 +406,22 @@ void tissat_schedule_prove (void) {
 #define CNF(EXPECTED, NAME, BIG) \
   if (!BIG || tissat_big) \
     schedule_prove_job (EXPECTED, "../test/cnf/" #NAME ".cnf", #NAME);
+  if (tissat_found_drabt || tissat_found_drat_trim) {
+    CNFS
+  }
+#undef CNF
+#define CNF(EXPECTED, NAME, BIG) \
+  if (EXPECTED == 20 && (!BIG || tissat_big)) \
+    schedule_frat_job ("../test/cnf/" #NAME ".cnf", #NAME);
+  if (tissat_found_frat_rs) {
+    CNFS
+  }
+#undef CNF
+  SCHEDULE_FUNCTION (test_prove_frat_hints);
+  SCHEDULE_FUNCTION (test_prove_verifier_exceptions);
+#define CNF(EXPECTED, NAME, BIG) \
+  if (!BIG || tissat_big) \
+    schedule_proofcheck_job (EXPECTED, "../test/cnf/" #NAME ".cnf");
   CNFS
 #undef CNF
 }
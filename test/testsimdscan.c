@@ -0,0 +1,55 @@
+#include "../src/simdscan.h"
+
+#include "test.h"
+
+#include <stdlib.h>
+
+// The local search walker computes break values by gathering the number
+// of true literals of the clauses in the flat occurrence store with
+// 'kissat_simd_count_critical'.  The result has to agree with the scalar
+// loop for all sizes, which covers the vector bodies as well as the
+// remainders, and for unaligned starting positions.
+
+#define COUNTS 256
+#define MAX_SIZE 80
+#define OFFSETS 4
+
+static unsigned scalar_count_critical (const unsigned *counts,
+                                       const unsigned *refs, size_t size) {
+  unsigned res = 0;
+  for (size_t i = 0; i != size; i++)
+    res += (counts[refs[i]] == 1);
+  return res;
+}
+
+static void test_simdscan_count_critical (void) {
+  DECLARE_AND_INIT_SOLVER (solver);
+  kissat_init_simd_support (solver);
+  srand (42);
+  unsigned counts[COUNTS];
+  unsigned refs[MAX_SIZE + OFFSETS];
+  const unsigned rounds = tissat_big ? 100 : 10;
+  for (unsigned round = 0; round != rounds; round++) {
+    for (unsigned i = 0; i != COUNTS; i++)
+      counts[i] = rand () % 4;
+    for (unsigned i = 0; i != MAX_SIZE + OFFSETS; i++)
+      refs[i] = rand () % COUNTS;
+    for (unsigned offset = 0; offset != OFFSETS; offset++)
+      for (size_t size = 0; size <= MAX_SIZE; size++) {
+        const unsigned *const begin = refs + offset;
+        const unsigned expected =
+            scalar_count_critical (counts, begin, size);
+        const unsigned actual =
+            kissat_simd_count_critical (counts, begin, size);
+        if (actual != expected)
+          FATAL ("counted %u critical instead of %u "
+                 "for size %zu at offset %u in round %u",
+                 actual, expected, size, offset, round);
+      }
+  }
+  printf ("checked %u rounds of critical counts\n", rounds);
+}
+
+void tissat_schedule_simdscan (void) {
+  SCHEDULE_FUNCTION (test_simdscan_count_critical);
+}
@@ -0,0 +1,63 @@
+#include "../src/file.h"
+
+#include <unistd.h>
+
+#include "test.h"
+#include "testcnfs.h"
+
+static void snapshot_round_trip (int expected, const char *name) {
+  char cnf[64], parsed[64], preprocessed[64], cmd[256];
+  sprintf (cnf, "../test/cnf/%s.cnf", name);
+  if (!kissat_file_readable (cnf)) {
+    tissat_warning ("Skipping unreadable '%s'", cnf);
+    return;
+  }
+  sprintf (parsed, "%s.snapshot", name);
+  sprintf (preprocessed, "%s.preprocessed.snapshot", name);
+  (void) unlink (parsed);
+  (void) unlink (preprocessed);
+  sprintf (cmd, "--write-snapshot=%s --write-preprocessed-snapshot=%s %s",
+           parsed, preprocessed, cnf);
+  tissat_call_application (expected, cmd);
+  sprintf (cmd, "--read-snapshot=%s", parsed);
+  tissat_call_application (expected, cmd);
+  if (!kissat_file_readable (preprocessed))
+    return;
+  sprintf (cmd, "--read-snapshot=%s", preprocessed);
+  tissat_call_application (expected, cmd);
+  sprintf (cmd, "--threads=2 --read-snapshot=%s", preprocessed);
+  tissat_call_application (expected, cmd);
+}
+
+static void test_snapshot_round_trip (void) {
+#define CNF(EXPECTED, NAME, BIG) \
+  if (!BIG || tissat_big) \
+    snapshot_round_trip (EXPECTED, #NAME);
+  CNFS
+#undef CNF
+}
+
+static void test_snapshot_invalid (void) {
+  const char *path = "invalid.snapshot";
+  FILE *file = fopen (path, "w");
+  if (!file)
+    FATAL ("could not write '%s'", path);
+  fputs ("p cnf 0 0\n", file);
+  fclose (file);
+  tissat_call_application (1, "--read-snapshot=invalid.snapshot");
+  tissat_call_application (
+      20, "--write-snapshot=invalid.snapshot ../test/cnf/add8.cnf");
+  const size_t size = kissat_file_size (path);
+  if (truncate (path, size / 2))
+    FATAL ("could not truncate '%s'", path);
+  tissat_call_application (1, "--read-snapshot=invalid.snapshot");
+  tissat_call_application (
+      1, "--read-snapshot=invalid.snapshot ../test/cnf/add8.cnf");
+}
+
+void tissat_schedule_snapshot (void) {
+  if (!tissat_found_test_directory)
+    return;
+  SCHEDULE_FUNCTION (test_snapshot_round_trip);
+  SCHEDULE_FUNCTION (test_snapshot_invalid);
+}
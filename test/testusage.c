@@ -41,7 +41,11 @@ void tissat_schedule_usage (void) {
     APP (20, "../test/cnf/add8.cnf --no-eliminate");
 
     APP (20, "../test/cnf/add8.cnf --stable=2");
+    APP (20, "../test/cnf/prime65537.cnf --stable=2 --buckets");
     APP (20, "../test/cnf/add8.cnf --no-stable");
+    APP (20, "../test/cnf/prime65537.cnf --trailsave=1");
+    APP (20, "../test/cnf/prime65537.cnf --payoff=1");
+    APP (20, "../test/cnf/prime65537.cnf --recycle");
 
     APP (20, "../test/cnf/add8.cnf --probeinit=0 --no-vivify");
 
@@ -64,6 +68,19 @@ void tissat_schedule_usage (void) {
             "--reluctantint=200 --reluctantlim=100 --stable=2");
     APP (0, "--decisions=1000 ../test/cnf/hard.cnf "
             "--no-reluctant --stable=2");
+    APP (0, "--conflicts=1e4 ../test/cnf/hard.cnf "
+            "--memory-limit=1 --memoryint=100");
+    APP (0, "--conflicts=2e4 ../test/cnf/hard.cnf --buckets");
+    APP (0, "--conflicts=2e4 ../test/cnf/hard.cnf --recycle "
+            "--reduceint=100");
+#ifndef NPROOFS
+    APP (20, "../test/cnf/add128.cnf --recycle --reduceint=10 "
+             "--proofcheck");
+#endif
+    APP (0, "--conflicts=2e4 ../test/cnf/hard.cnf --trailsave=2 "
+            "--no-restartreusetrail");
+    APP (0, "--conflicts=3e4 ../test/cnf/hard.cnf --payoff=1 "
+            "--payoffmax=2 --payoffwindow=2");
   }
 
 #else
@@ -94,6 +111,76 @@ void tissat_schedule_usage (void) {
             "../test/cnf/hard.cnf" LIMITED_OPTIONS);
   }
 
+  if (tissat_found_test_directory) {
+    APP (20, "--threads=2 ../test/cnf/add8.cnf");
+    APP (10, "--threads=3 ../test/cnf/sqrt10609.cnf");
+    APP (0, "--threads=2 --conflicts=1e3 ../test/cnf/hard.cnf");
+    APP (0, "--threads=2 --memorylimit=1 --memoryint=100 --conflicts=3e3 "
+            "../test/cnf/hard.cnf");
+
+    APP (20, "--eliminatethreads=2 --eliminateinit=0 "
+             "../test/cnf/add32.cnf");
+    APP (20, "--eliminatethreads=3 --eliminateinit=0 "
+             "../test/cnf/prime65537.cnf");
+#ifndef NPROOFS
+    APP (20, "--eliminatethreads=2 --eliminateinit=0 --proofcheck "
+             "../test/cnf/add32.cnf");
+#endif
+
+    APP (20, "--sweepthreads=2 ../test/cnf/add128.cnf");
+    APP (20, "--sweepthreads=3 ../test/cnf/prime65537.cnf");
+    APP (10, "--sweepthreads=2 ../test/cnf/sqrt11881.cnf");
+    APP (10, "--sweepthreads=3 ../test/cnf/prime2209.cnf");
+#ifndef NPROOFS
+    APP (20, "--sweepthreads=2 --proofcheck ../test/cnf/add128.cnf");
+    APP (20, "--sweepthreads=3 --proofcheck ../test/cnf/prime65537.cnf");
+#endif
+
+    APP (20, "--congruencethreads=2 ../test/cnf/congr1.cnf");
+    APP (20, "--congruencethreads=2 ../test/cnf/congr2.cnf");
+    APP (20, "--congruencethreads=2 ../test/cnf/congr3.cnf");
+    APP (10, "--congruencethreads=2 ../test/cnf/congr4.cnf");
+    APP (20, "--congruencethreads=2 ../test/cnf/congr5.cnf");
+    APP (20, "--congruencethreads=2 ../test/cnf/congr6.cnf");
+    APP (10, "--congruencethreads=2 ../test/cnf/congr7.cnf");
+    APP (20, "--congruencethreads=2 ../test/cnf/add128.cnf");
+    APP (20, "--congruencethreads=3 ../test/cnf/prime65537.cnf");
+#ifndef NPROOFS
+    APP (20, "--congruencethreads=2 --proofcheck ../test/cnf/add128.cnf");
+    APP (20, "--congruencethreads=3 --proofcheck "
+             "../test/cnf/prime65537.cnf");
+#endif
+
+    APP (20, "--vivifythreads=2 ../test/cnf/prime65537.cnf");
+    APP (20, "--vivifythreads=3 ../test/cnf/add128.cnf");
+    APP (0, "--vivifythreads=2 --conflicts=2e4 ../test/cnf/hard.cnf");
+#ifndef NPROOFS
+    APP (20, "--vivifythreads=2 --proofcheck ../test/cnf/add128.cnf");
+    APP (0, "--vivifythreads=2 --conflicts=2e4 --proofcheck "
+            "../test/cnf/hard.cnf");
+#endif
+
+    APP (20, "--backbonethreads=2 ../test/cnf/prime65537.cnf");
+    APP (20, "--backbonethreads=3 ../test/cnf/add128.cnf");
+    APP (10, "--backbonethreads=2 ../test/cnf/sqrt11881.cnf");
+    APP (20, "--backbonethreads=2 --no-lucky --no-preprocesscongruence "
+             "../test/cnf/backbone1.cnf");
+#ifndef NPROOFS
+    APP (20, "--backbonethreads=2 --proofcheck ../test/cnf/add128.cnf");
+    APP (20, "--backbonethreads=2 --no-lucky --no-preprocesscongruence "
+             "--proofcheck ../test/cnf/backbone1.cnf");
+#endif
+
+    APP (10, "--walkthreads=2 --stable=2 --rephaseinit=10 "
+             "--rephaseint=10 ../test/cnf/prime1681.cnf");
+    APP (10, "--walkthreads=3 --stable=2 --rephaseinit=10 "
+             "--rephaseint=10 --no-preprocess ../test/cnf/prime2209.cnf");
+#ifndef NPROOFS
+    APP (10, "--walkthreads=2 --stable=2 --rephaseinit=10 "
+             "--rephaseint=10 --proofcheck ../test/cnf/prime1681.cnf");
+#endif
+  }
+
   APP (1, "--help -n");
   APP (1, "--version -n");
   APP (1, "-n --version");
@@ -121,6 +208,10 @@ void tissat_schedule_usage (void) {
   APP (1, "--statistics");
 #endif
 
+#ifndef NOPTIONS
+  APP (1, "--memory-limit=0");
+#endif
+  APP (1, "--threads=0");
   APP (1, "--invalid");
   APP (1, "-X");
 